@@ -0,0 +1,382 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "huffman_common.h"
+#include "io.h"
+#include "adaptive.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+/** Maximale Anzahl Knoten: 256 Zeichen, der NYT-Knoten und 256 innere */
+#define MAX_NODES (2 * MAX_CHARACTERS + 1)
+
+/** Kennzeichnung eines fehlenden Knotens */
+#define NO_NODE (-1)
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Adaptiver Huffman-Baum in flachen Arrays. Die Knoten werden über ihren 
+ * Index angesprochen, der sich nicht ändert. Zusätzlich hat jeder Knoten 
+ * eine Nummer; nach Nummern geordnet sind die Gewichte aufsteigend und 
+ * Geschwister stehen nebeneinander (Geschwistereigenschaft). Die Wurzel hat
+ * die höchste Nummer.
+ */
+typedef struct
+{
+    /** Elternknoten, NO_NODE für die Wurzel */
+    int parent[MAX_NODES];
+
+    /** linkes Kind (Bit 0), NO_NODE für Blätter */
+    int left[MAX_NODES];
+
+    /** rechtes Kind (Bit 1), NO_NODE für Blätter */
+    int right[MAX_NODES];
+
+    /** Gewicht, d.h. bisherige Häufigkeit */
+    unsigned long long weight[MAX_NODES];
+
+    /** Nummer des Knotens */
+    int number[MAX_NODES];
+
+    /** Knoten zu jeder Nummer */
+    int node[MAX_NODES];
+
+    /** Blatt jedes Zeichens, NO_NODE für noch nicht aufgetretene */
+    int leaf[MAX_CHARACTERS];
+
+    /** Zeichen jedes Blatts */
+    unsigned char symbol[MAX_NODES];
+
+    /** der NYT-Knoten */
+    int nyt;
+
+    /** die Wurzel */
+    int root;
+
+    /** Anzahl der verwendeten Knoten */
+    int count;
+} ADAPTIVE_TREE;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Initialisiert den Baum mit dem NYT-Knoten als einzigem Knoten.
+ *
+ * @param tree  der zu initialisierende Baum
+ */
+static void tree_init(ADAPTIVE_TREE *tree);
+
+/**
+ * Passt den Baum nach dem Auftreten eines Zeichens an. Ein neues Zeichen 
+ * erhält ein Blatt neben dem NYT-Knoten. Danach wird jeder Knoten auf dem 
+ * Weg zur Wurzel mit dem Knoten höchster Nummer gleichen Gewichts getauscht
+ * und sein Gewicht erhöht.
+ *
+ * @param tree      der anzupassende Baum
+ * @param symbol    das aufgetretene Zeichen
+ */
+static void tree_update(ADAPTIVE_TREE *tree, unsigned char symbol);
+
+/**
+ * Vertauscht zwei Knoten samt ihrer Teilbäume und Nummern.
+ *
+ * @param tree  der Baum
+ * @param a     erster Knoten
+ * @param b     zweiter Knoten
+ */
+static void swap_nodes(ADAPTIVE_TREE *tree, int a, int b);
+
+/**
+ * Schreibt den Code eines Knotens, d.h. den Weg von der Wurzel zum Knoten.
+ *
+ * @param tree  der Baum
+ * @param node  der zu kodierende Knoten
+ */
+static void write_node_code(const ADAPTIVE_TREE *tree, int node);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: adaptive_compress
+ * ------------------------------------------------------------------------ */
+extern void adaptive_compress(void)
+{
+    ADAPTIVE_TREE *tree = (ADAPTIVE_TREE *) malloc(sizeof (ADAPTIVE_TREE));
+    unsigned char c;
+
+    ENSURE_ENOUGH_MEMORY(tree, "adaptive_compress");
+    tree_init(tree);
+
+    while (has_next_char())
+    {
+        c = read_char();
+
+        if (tree->leaf[c] != NO_NODE)
+        {
+            write_node_code(tree, tree->leaf[c]);
+        }
+        else
+        {
+            write_node_code(tree, tree->nyt);
+            write_bits(c, ADAPTIVE_ESCAPE_BITS);
+        }
+
+        tree_update(tree, c);
+    }
+
+    write_node_code(tree, tree->nyt);
+    write_bits(ADAPTIVE_END, ADAPTIVE_ESCAPE_BITS);
+
+    free(tree);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: adaptive_decompress
+ * ------------------------------------------------------------------------ */
+extern bool adaptive_decompress(void)
+{
+    ADAPTIVE_TREE *tree = (ADAPTIVE_TREE *) malloc(sizeof (ADAPTIVE_TREE));
+    unsigned int value;
+    int node;
+    int i;
+
+    ENSURE_ENOUGH_MEMORY(tree, "adaptive_decompress");
+    tree_init(tree);
+
+    for (;;)
+    {
+        /* Von der Wurzel bitweise bis zu einem Blatt absteigen */
+        node = tree->root;
+        while (tree->left[node] != NO_NODE)
+        {
+            if (!has_next_bit())
+            {
+                free(tree);
+                return false;
+            }
+            node = (read_bit() == BIT1) ? tree->right[node] : tree->left[node];
+        }
+
+        if (node == tree->nyt)
+        {
+            /* neues Zeichen oder Ende der Daten */
+            value = 0;
+            for (i = 0; i < ADAPTIVE_ESCAPE_BITS; i++)
+            {
+                if (!has_next_bit())
+                {
+                    free(tree);
+                    return false;
+                }
+                value = (value << 1) | (read_bit() == BIT1 ? 1u : 0u);
+            }
+
+            if (value >= ADAPTIVE_END)
+            {
+                break;
+            }
+        }
+        else
+        {
+            value = tree->symbol[node];
+        }
+
+        write_char((unsigned char) value);
+        tree_update(tree, (unsigned char) value);
+    }
+
+    free(tree);
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: tree_init
+ * ------------------------------------------------------------------------ */
+static void tree_init(ADAPTIVE_TREE *tree)
+{
+    int c;
+
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        tree->leaf[c] = NO_NODE;
+    }
+
+    /* Der NYT-Knoten ist zunächst die Wurzel mit der höchsten Nummer */
+    tree->count = 1;
+    tree->nyt = 0;
+    tree->root = 0;
+    tree->parent[0] = NO_NODE;
+    tree->left[0] = NO_NODE;
+    tree->right[0] = NO_NODE;
+    tree->weight[0] = 0;
+    tree->number[0] = MAX_NODES - 1;
+    tree->node[MAX_NODES - 1] = 0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: tree_update
+ * ------------------------------------------------------------------------ */
+static void tree_update(ADAPTIVE_TREE *tree, unsigned char symbol)
+{
+    int current = tree->leaf[symbol];
+    int leader;
+    int n;
+
+    if (current == NO_NODE)
+    {
+        /* Der bisherige NYT-Knoten wird innerer Knoten mit dem neuen 
+         * NYT-Knoten links und dem Blatt des Zeichens rechts */
+        int old_nyt = tree->nyt;
+        int new_nyt = tree->count;
+        int new_leaf = tree->count + 1;
+
+        tree->count += 2;
+
+        tree->left[old_nyt] = new_nyt;
+        tree->right[old_nyt] = new_leaf;
+
+        tree->parent[new_nyt] = old_nyt;
+        tree->left[new_nyt] = NO_NODE;
+        tree->right[new_nyt] = NO_NODE;
+        tree->weight[new_nyt] = 0;
+        tree->number[new_nyt] = tree->number[old_nyt] - 2;
+        tree->node[tree->number[new_nyt]] = new_nyt;
+
+        tree->parent[new_leaf] = old_nyt;
+        tree->left[new_leaf] = NO_NODE;
+        tree->right[new_leaf] = NO_NODE;
+        tree->weight[new_leaf] = 0;
+        tree->number[new_leaf] = tree->number[old_nyt] - 1;
+        tree->node[tree->number[new_leaf]] = new_leaf;
+        tree->symbol[new_leaf] = symbol;
+
+        tree->leaf[symbol] = new_leaf;
+        tree->nyt = new_nyt;
+        current = new_leaf;
+    }
+
+    while (current != NO_NODE)
+    {
+        /* Knoten mit der höchsten Nummer im Block gleichen Gewichts suchen.
+         * Der Elternknoten kann nur bei einem NYT-Geschwister das gleiche
+         * Gewicht haben; ist er der höchste Knoten, wird nicht getauscht. */
+        n = tree->number[current];
+        while (n + 1 < MAX_NODES 
+               && tree->weight[tree->node[n + 1]] == tree->weight[current])
+        {
+            n++;
+        }
+        leader = tree->node[n];
+
+        if (leader != current && leader != tree->parent[current])
+        {
+            swap_nodes(tree, current, leader);
+        }
+
+        tree->weight[current]++;
+        current = tree->parent[current];
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: swap_nodes
+ * ------------------------------------------------------------------------ */
+static void swap_nodes(ADAPTIVE_TREE *tree, int a, int b)
+{
+    int parent_a = tree->parent[a];
+    int parent_b = tree->parent[b];
+    int number;
+
+    if (parent_a == parent_b)
+    {
+        tree->left[parent_a] = tree->right[parent_a];
+        tree->right[parent_a] = (tree->left[parent_a] == a) ? b : a;
+    }
+    else
+    {
+        if (tree->left[parent_a] == a)
+        {
+            tree->left[parent_a] = b;
+        }
+        else
+        {
+            tree->right[parent_a] = b;
+        }
+
+        if (tree->left[parent_b] == b)
+        {
+            tree->left[parent_b] = a;
+        }
+        else
+        {
+            tree->right[parent_b] = a;
+        }
+
+        tree->parent[a] = parent_b;
+        tree->parent[b] = parent_a;
+    }
+
+    number = tree->number[a];
+    tree->number[a] = tree->number[b];
+    tree->number[b] = number;
+    tree->node[tree->number[a]] = a;
+    tree->node[tree->number[b]] = b;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: write_node_code
+ * ------------------------------------------------------------------------ */
+static void write_node_code(const ADAPTIVE_TREE *tree, int node)
+{
+    /* Bits des Weges, vom Knoten aus zur Wurzel gesammelt */
+    unsigned char path[MAX_NODES];
+    unsigned long long bits = 0;
+    unsigned int count = 0;
+    int length = 0;
+    int parent;
+
+    for (parent = tree->parent[node]; parent != NO_NODE; 
+         parent = tree->parent[node])
+    {
+        path[length++] = (unsigned char) (tree->right[parent] == node);
+        node = parent;
+    }
+
+    /* Von der Wurzel aus in Gruppen von höchstens 32 Bits schreiben */
+    while (length > 0)
+    {
+        bits = (bits << 1) | path[--length];
+        count++;
+        if (count == 32 || length == 0)
+        {
+            write_bits(bits, count);
+            bits = 0;
+            count = 0;
+        }
+    }
+}
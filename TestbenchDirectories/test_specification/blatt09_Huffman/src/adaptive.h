@@ -0,0 +1,62 @@
+/**
+ * @file
+ * Dieses Modul realisiert die adaptive Huffman-Kodierung nach dem 
+ * FGK-Verfahren (Faller, Gallager, Knuth). Kodierer und Dekodierer beginnen
+ * mit einem Baum, der nur den NYT-Knoten ("not yet transmitted") enthält, 
+ * und passen den Baum nach jedem Zeichen auf dieselbe Weise an. Es wird 
+ * daher kein Header mit Häufigkeiten benötigt und die Ausgabe beginnt mit
+ * dem ersten Zeichen.
+ *
+ * Ein noch nicht aufgetretenes Zeichen wird als Code des NYT-Knotens, 
+ * gefolgt von 9 Bits mit dem Zeichen selbst übertragen. Der Wert 
+ * #ADAPTIVE_END kennzeichnet das Ende der Daten.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef ADAPTIVE_H
+#define ADAPTIVE_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stdbool.h>
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Anzahl der Bits, mit denen ein neues Zeichen übertragen wird */
+#define ADAPTIVE_ESCAPE_BITS 9
+
+/** Wert nach dem NYT-Code, der das Ende der Daten kennzeichnet */
+#define ADAPTIVE_END 256
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Kodiert alle Zeichen des mit open_infile geöffneten Eingabestroms 
+ * adaptiv und schreibt die Codes in den mit open_outfile geöffneten 
+ * Ausgabestrom.
+ */
+extern void adaptive_compress(void);
+
+/**
+ * Dekodiert den adaptiv kodierten Eingabestrom und schreibt die Zeichen in
+ * den Ausgabestrom.
+ *
+ * @return  false, wenn der Eingabestrom vor dem Ende der Daten endet, 
+ *          true sonst
+ */
+extern bool adaptive_decompress(void);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* ADAPTIVE_H */
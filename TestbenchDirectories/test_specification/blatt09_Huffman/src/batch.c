@@ -0,0 +1,289 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Splint definiert S_SPLINT_S. Da die Splint-Prüfung von stat.h zum parse
+ * error und Abbruch führt, wird der folgende Codeteil von der Splint-Prüfung 
+ * ausgeklammert. 
+ */
+#ifndef S_SPLINT_S
+#include <sys/stat.h>
+#endif
+
+#include "huffman_common.h"
+#include "io.h"
+#include "huffman.h"
+#include "threadpool.h"
+#include "batch.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+/** Anzahl der Dateien, für die zu Beginn Speicher reserviert wird */
+#define BATCH_INITIAL_CAPACITY 64
+
+/** Zeichen, mit dem eine Kommentarzeile der Manifestdatei beginnt */
+#define BATCH_COMMENT '#'
+
+/** Fehlermeldung für eine Eingabedatei, die nicht bearbeitet werden kann */
+#define EMSG_INVALID_INPUT \
+        "Datei fehlt, ist nicht lesbar oder keine komprimierte Datei."
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Komprimiert bzw. dekomprimiert eine Datei des Stapels. Aufgabe für das
+ * Modul threadpool.
+ *
+ * @param batch     der Stapel
+ * @param index     Nummer der Datei
+ */
+static void process_file(void *batch, unsigned int index);
+
+/**
+ * Prüft vor dem Einreihen, ob die Eingabedatei eine lesbare reguläre Datei
+ * ist und zum Dekomprimieren mit einem gültigen Header beginnt (siehe 
+ * huffman_check_header).
+ *
+ * @param filename      Name der Eingabedatei
+ * @param decompress    true, wenn die Datei dekomprimiert wird
+ * @return              true, wenn die Datei bearbeitet werden kann
+ */
+static bool check_input(const char *filename, bool decompress);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: batch_init
+ * ------------------------------------------------------------------------ */
+extern void batch_init(BATCH *batch, bool decompress)
+{
+    batch->files = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+    batch->decompress = decompress;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: batch_add_file
+ * ------------------------------------------------------------------------ */
+extern bool batch_add_file(BATCH *batch, const char *filename,
+                           const char *suffix)
+{
+    BATCH_FILE *file;
+
+    if (strcmp(filename, STDIO_FILENAME) == 0
+        || strlen(filename) + strlen(suffix) > MAX_FILENAME)
+    {
+        return false;
+    }
+
+    if (batch->count == batch->capacity)
+    {
+        batch->capacity = (batch->capacity == 0)
+                ? BATCH_INITIAL_CAPACITY
+                : 2 * batch->capacity;
+        batch->files = (BATCH_FILE *) realloc(batch->files, batch->capacity
+                                              * sizeof (BATCH_FILE));
+        ENSURE_ENOUGH_MEMORY(batch->files, "batch_add_file");
+    }
+
+    file = &batch->files[batch->count++];
+    strcpy(file->in_filename, filename);
+    strcpy(file->out_filename, filename);
+    strcat(file->out_filename, suffix);
+    memset(&file->io, 0, sizeof (IO_STATISTICS));
+    file->failed = false;
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: batch_add_manifest
+ * ------------------------------------------------------------------------ */
+extern bool batch_add_manifest(BATCH *batch, const char *manifest,
+                               const char *suffix)
+{
+    /* Zeile mit Platz für Zeilenende und Stringende */
+    char line[MAX_FILENAME + 3];
+    FILE *stream;
+    size_t length;
+    bool valid = true;
+
+    stream = fopen(manifest, "r");
+    if (stream == NULL)
+    {
+        return false;
+    }
+
+    while (valid && fgets(line, (int) sizeof (line), stream) != NULL)
+    {
+        length = strlen(line);
+
+        /* Eine Zeile ohne Zeilenende, die den Puffer füllt, ist zu lang */
+        if (length == sizeof (line) - 1 && line[length - 1] != '\n')
+        {
+            valid = false;
+        }
+
+        while (length > 0
+               && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+        {
+            line[--length] = '\0';
+        }
+
+        if (valid && length > 0 && line[0] != BATCH_COMMENT)
+        {
+            valid = batch_add_file(batch, line, suffix);
+        }
+    }
+
+    if (ferror(stream))
+    {
+        valid = false;
+    }
+    (void) fclose(stream);
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: batch_run
+ * ------------------------------------------------------------------------ */
+extern unsigned int batch_run(BATCH *batch, unsigned int threads)
+{
+    unsigned int failed = 0;
+    unsigned int i;
+
+    /* Die Prüfung vorab verhindert, dass eine fehlende Datei während der
+     * Bearbeitung das gesamte Programm beendet */
+    for (i = 0; i < batch->count; i++)
+    {
+        if (!check_input(batch->files[i].in_filename, batch->decompress))
+        {
+            fprintf(stderr, "[ERROR]: %s: %s\n", EMSG_INVALID_INPUT,
+                    batch->files[i].in_filename);
+            batch->files[i].failed = true;
+            failed++;
+        }
+    }
+
+    threadpool_run(threads, batch->count, process_file, batch);
+
+    return failed;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: process_file
+ * ------------------------------------------------------------------------ */
+static void process_file(void *batch, unsigned int index)
+{
+    BATCH_FILE *file = &((BATCH *) batch)->files[index];
+    IO_STATISTICS before;
+    IO_STATISTICS after;
+
+    if (file->failed)
+    {
+        return;
+    }
+
+    /* Die Standardkontexte gehören dem Thread, ihre Zähler laufen über alle
+     * Dateien des Threads weiter */
+    get_io_statistics(&before);
+
+    if (((BATCH *) batch)->decompress)
+    {
+        decompress(file->in_filename, file->out_filename);
+    }
+    else
+    {
+        compress(file->in_filename, file->out_filename);
+    }
+
+    get_io_statistics(&after);
+    file->io.read_calls = after.read_calls - before.read_calls;
+    file->io.bytes_read = after.bytes_read - before.bytes_read;
+    file->io.write_calls = after.write_calls - before.write_calls;
+    file->io.bytes_written = after.bytes_written - before.bytes_written;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: check_input
+ * ------------------------------------------------------------------------ */
+static bool check_input(const char *filename, bool decompress)
+{
+    struct stat attribut;
+    FILE *stream;
+    unsigned char header[HUFFMAN_HEADER_SIZE];
+    bool valid = true;
+
+    if (stat(filename, &attribut) != 0 || !S_ISREG(attribut.st_mode))
+    {
+        return false;
+    }
+
+    stream = fopen(filename, "rb");
+    if (stream == NULL)
+    {
+        return false;
+    }
+    if (decompress)
+    {
+        valid = fread(header, 1, HUFFMAN_HEADER_SIZE, stream) 
+                    == HUFFMAN_HEADER_SIZE
+                && huffman_check_header(header);
+    }
+    (void) fclose(stream);
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: batch_get_statistics
+ * ------------------------------------------------------------------------ */
+extern void batch_get_statistics(const BATCH *batch,
+                                 IO_STATISTICS *statistics)
+{
+    unsigned int i;
+
+    memset(statistics, 0, sizeof (IO_STATISTICS));
+
+    for (i = 0; i < batch->count; i++)
+    {
+        statistics->read_calls += batch->files[i].io.read_calls;
+        statistics->bytes_read += batch->files[i].io.bytes_read;
+        statistics->write_calls += batch->files[i].io.write_calls;
+        statistics->bytes_written += batch->files[i].io.bytes_written;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: batch_destroy
+ * ------------------------------------------------------------------------ */
+extern void batch_destroy(BATCH *batch)
+{
+    free(batch->files);
+    batch->files = NULL;
+    batch->count = 0;
+    batch->capacity = 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file
+ * Dieses Modul realisiert den Stapelbetrieb (Option -j): Viele Dateien
+ * werden in einem Programmaufruf komprimiert bzw. dekomprimiert. Die Dateien
+ * werden als Aufgaben mit dem Modul threadpool auf mehrere Threads verteilt;
+ * jeder Thread bearbeitet seine Dateien nacheinander mit eigenen
+ * Standardkontexten des Moduls io und verwendet deren Puffer für alle
+ * seine Dateien weiter. So entfallen Prozessstart und erneute Allokation
+ * je Datei.
+ *
+ * Die Dateien können einzeln oder über eine Manifestdatei mit einem
+ * Dateinamen je Zeile angegeben werden. Jede Ausgabedatei erhält den Namen
+ * der Eingabedatei mit angehängter Standardendung. Vor dem Einreihen wird
+ * jede Eingabedatei geprüft; fehlende und nicht lesbare Dateien sowie 
+ * beim Dekomprimieren Dateien ohne gültigen Header werden gemeldet und 
+ * übersprungen, ohne die übrigen Dateien abzubrechen. Ein Fehler in den 
+ * Daten hinter einem gültigen Header bricht wie bei einer einzelnen Datei
+ * das gesamte Programm ab.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include "huffman_common.h"
+#include "io.h"
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Eine Datei des Stapels
+ */
+typedef struct
+{
+    /** Name der Eingabedatei */
+    char in_filename[MAX_FILENAME + 1];
+
+    /** Name der Ausgabedatei, Eingabedatei mit Standardendung */
+    char out_filename[MAX_FILENAME + 4];
+
+    /** Zugriffe auf Ein- und Ausgabedatei während der Bearbeitung */
+    IO_STATISTICS io;
+
+    /** true, wenn die Eingabedatei nicht bearbeitet werden konnte */
+    bool failed;
+} BATCH_FILE;
+
+/**
+ * Die Dateien eines Stapels
+ */
+typedef struct
+{
+    /** die Dateien */
+    BATCH_FILE *files;
+
+    /** Anzahl der Dateien */
+    unsigned int count;
+
+    /** Anzahl der Dateien, für die Speicher reserviert ist */
+    unsigned int capacity;
+
+    /** true für Dekomprimierung, false für Komprimierung */
+    bool decompress;
+} BATCH;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Initialisiert einen leeren Stapel.
+ *
+ * @param batch         der Stapel
+ * @param decompress    true, wenn die Dateien dekomprimiert werden
+ */
+extern void batch_init(BATCH *batch, bool decompress);
+
+/**
+ * Fügt eine Datei an den Stapel an.
+ *
+ * @param batch     der Stapel
+ * @param filename  Name der Eingabedatei
+ * @param suffix    Endung, die für die Ausgabedatei angehängt wird
+ * @return          false, wenn der Dateiname zu lang ist oder die
+ *                  Standardeingabe bezeichnet, true sonst
+ */
+extern bool batch_add_file(BATCH *batch, const char *filename,
+                           const char *suffix);
+
+/**
+ * Fügt alle Dateien einer Manifestdatei an den Stapel an. Die Manifestdatei
+ * enthält einen Dateinamen je Zeile; leere Zeilen und Zeilen, die mit #
+ * beginnen, werden übersprungen.
+ *
+ * @param batch     der Stapel
+ * @param manifest  Name der Manifestdatei
+ * @param suffix    Endung, die für die Ausgabedateien angehängt wird
+ * @return          false, wenn die Manifestdatei nicht gelesen werden kann
+ *                  oder einen ungültigen Dateinamen enthält, true sonst
+ */
+extern bool batch_add_manifest(BATCH *batch, const char *manifest,
+                               const char *suffix);
+
+/**
+ * Komprimiert bzw. dekomprimiert alle Dateien des Stapels mit den zuvor
+ * über huffman_set_options gesetzten Einstellungen und kehrt zurück, wenn
+ * alle Dateien bearbeitet sind. Dateien, die die Prüfung vor dem Einreihen
+ * nicht bestehen, werden auf stderr gemeldet und als fehlgeschlagen 
+ * markiert.
+ *
+ * @param batch     der Stapel
+ * @param threads   Anzahl der Threads, 0 für die Anzahl der Prozessoren
+ * @return          Anzahl der fehlgeschlagenen Dateien
+ */
+extern unsigned int batch_run(BATCH *batch, unsigned int threads);
+
+/**
+ * Summiert die Zugriffe aller Dateien des bearbeiteten Stapels.
+ *
+ * @param batch         der Stapel
+ * @param statistics    die Summe der Aufrufe und Bytes
+ */
+extern void batch_get_statistics(const BATCH *batch,
+                                 IO_STATISTICS *statistics);
+
+/**
+ * Gibt den Speicher des Stapels frei.
+ *
+ * @param batch     der Stapel
+ */
+extern void batch_destroy(BATCH *batch);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* BATCH_H */
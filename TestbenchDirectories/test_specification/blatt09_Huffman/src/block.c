@@ -0,0 +1,776 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#include "huffman_common.h"
+#include "io.h"
+#include "codetable.h"
+#include "canonical.h"
+#include "codelength.h"
+#include "threadpool.h"
+#include "histogram.h"
+#include "block.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Ein Block der Eingabe und sein komprimiertes Gegenstück
+ */
+typedef struct
+{
+    /** unkomprimierte Zeichen des Blocks */
+    unsigned char *plain;
+
+    /** Anzahl der unkomprimierten Zeichen */
+    size_t plain_size;
+
+    /** komprimierter Block */
+    unsigned char *packed;
+
+    /** Größe des komprimierten Blocks in Bytes */
+    size_t packed_size;
+
+    /** false, wenn der Block nicht dekomprimiert werden konnte */
+    bool valid;
+} BLOCK;
+
+/**
+ * Die allen Blöcken gemeinsamen Daten für den Thread-Pool
+ */
+typedef struct
+{
+    /** die Blöcke */
+    BLOCK *blocks;
+
+    /** maximale Codelänge beim Komprimieren */
+    unsigned int max_code_length;
+
+    /** Anzahl der Teilströme je Block, 1 oder #DECODE_STREAMS */
+    unsigned int streams;
+} BLOCK_JOB;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Liefert die Anzahl der Blöcke, die im Stromformat gemeinsam eingelesen 
+ * und parallel bearbeitet werden.
+ *
+ * @param threads   Anzahl der Threads, 0 für die Anzahl der Prozessoren
+ * @return          Anzahl der Blöcke je Durchgang
+ */
+static unsigned int get_batch_size(unsigned int threads);
+
+/**
+ * Liefert die Anzahl der Zeichen eines Teilstroms eines Blocks.
+ *
+ * @param size      Anzahl der Zeichen des Blocks
+ * @param streams   Anzahl der Teilströme, 1 oder #DECODE_STREAMS
+ * @param stream    Nummer des Teilstroms
+ * @return          Anzahl der Zeichen des Teilstroms
+ */
+static size_t get_stream_count(size_t size, unsigned int streams, 
+                               unsigned int stream);
+
+/**
+ * Kodiert Zeichen in einen auf ganze Bytes aufgefüllten Bitstrom.
+ *
+ * @param codes     die Codes der Zeichen
+ * @param plain     die zu kodierenden Zeichen
+ * @param size      Anzahl der Zeichen
+ * @param out       Speicher für den Bitstrom
+ * @return          Zeiger hinter das letzte geschriebene Byte
+ */
+static unsigned char *encode_stream(const HUFF_CODE codes[], 
+                                    const unsigned char plain[], size_t size,
+                                    unsigned char *out);
+
+/**
+ * Komprimiert einen Block. Wird vom Thread-Pool aufgerufen.
+ *
+ * @param job       die Blöcke (BLOCK_JOB)
+ * @param index     Nummer des zu komprimierenden Blocks
+ */
+static void compress_block(void *job, unsigned int index);
+
+/**
+ * Liest die Sprungtabelle eines Blocks mit #DECODE_STREAMS Teilströmen und
+ * berechnet daraus die Größen aller Teilströme.
+ *
+ * @param data          die Sprungtabelle, gefolgt von den Teilströmen
+ * @param size          Größe von Sprungtabelle und Teilströmen in Bytes
+ * @param stream_sizes  Speicher für die Größen der Teilströme
+ * @param used          Größe der Sprungtabelle in Bytes
+ * @return              false, wenn die Sprungtabelle fehlerhaft ist, 
+ *                      true sonst
+ */
+static bool load_stream_sizes(const unsigned char data[], size_t size,
+                              size_t stream_sizes[], size_t *used);
+
+/**
+ * Liest Header und Index des blockweisen Formats und trägt Position, Größe
+ * und Anzahl der Zeichen aller Blöcke ein. Der Speicher für die 
+ * unkomprimierten Zeichen wird nicht angelegt.
+ *
+ * @param data              die komprimierten Daten, beginnend nach dem 
+ *                          Container-Header
+ * @param size              Größe der komprimierten Daten in Bytes
+ * @param job               erhält die Blöcke, freizugeben mit free
+ * @param all_characters    Anzahl aller Zeichen
+ * @param block_size        Blockgröße in Bytes
+ * @param block_count       Anzahl der Blöcke
+ * @return                  false, wenn Header oder Index fehlerhaft sind,
+ *                          true sonst
+ */
+static bool load_block_index(const unsigned char data[], size_t size,
+                             BLOCK_JOB *job, unsigned long long *all_characters,
+                             unsigned long long *block_size,
+                             unsigned int *block_count);
+
+/**
+ * Dekomprimiert einen Block. Wird vom Thread-Pool aufgerufen.
+ *
+ * @param job       die Blöcke (BLOCK_JOB)
+ * @param index     Nummer des zu dekomprimierenden Blocks
+ */
+static void decompress_block(void *job, unsigned int index);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: block_compress
+ * ------------------------------------------------------------------------ */
+extern void block_compress(const unsigned char data[], size_t size,
+                           unsigned int block_size,
+                           unsigned int max_code_length,
+                           unsigned int streams, unsigned int threads)
+{
+    BLOCK_JOB job;
+    unsigned int block_count = (unsigned int) ((size + block_size - 1) 
+                                               / block_size);
+    unsigned int i;
+
+    job.max_code_length = max_code_length;
+    job.streams = streams;
+    job.blocks = (BLOCK *) calloc(block_count + 1, sizeof (BLOCK));
+    ENSURE_ENOUGH_MEMORY(job.blocks, "block_compress");
+
+    for (i = 0; i < block_count; i++)
+    {
+        job.blocks[i].plain = (unsigned char *) data + (size_t) i * block_size;
+        job.blocks[i].plain_size = (i + 1 < block_count) 
+                ? block_size
+                : size - (size_t) i * block_size;
+    }
+
+    threadpool_run(threads, block_count, compress_block, &job);
+
+    /* Header und Index schreiben, danach die Blöcke in ihrer Reihenfolge */
+    write_varint(size);
+    write_varint(block_size);
+    write_varint(block_count);
+    for (i = 0; i < block_count; i++)
+    {
+        write_varint(job.blocks[i].packed_size);
+    }
+    for (i = 0; i < block_count; i++)
+    {
+        write_bytes(job.blocks[i].packed, job.blocks[i].packed_size);
+        free(job.blocks[i].packed);
+    }
+
+    free(job.blocks);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: compress_block
+ * ------------------------------------------------------------------------ */
+static void compress_block(void *job, unsigned int index)
+{
+    BLOCK *block = &((BLOCK_JOB *) job)->blocks[index];
+    unsigned int streams = ((BLOCK_JOB *) job)->streams;
+    /* Häufigkeiten je Teilstrom und im ganzen Block */
+    unsigned long long stream_frequencys[DECODE_STREAMS][MAX_CHARACTERS];
+    unsigned long long frequencys[MAX_CHARACTERS];
+    unsigned char lengths[MAX_CHARACTERS];
+    HUFF_CODE codes[MAX_CHARACTERS];
+    CANONICAL_CODE canon;
+    /* Größe der Teilströme in Bytes */
+    size_t stream_sizes[DECODE_STREAMS];
+    size_t packed_size = 0;
+    const unsigned char *plain = block->plain;
+    unsigned char *out;
+    unsigned long long bits;
+    unsigned int k;
+    int c;
+
+    memset(stream_frequencys, 0, sizeof (stream_frequencys));
+    memset(frequencys, 0, sizeof (frequencys));
+    for (k = 0; k < streams; k++)
+    {
+        size_t count = get_stream_count(block->plain_size, streams, k);
+
+        histogram_count(plain, count, stream_frequencys[k]);
+        for (c = 0; c < MAX_CHARACTERS; c++)
+        {
+            frequencys[c] += stream_frequencys[k][c];
+        }
+        plain += count;
+    }
+
+    /* Die Codelängen werden direkt aus den Häufigkeiten berechnet, da der 
+     * Aufbau des Huffman-Baums nicht von mehreren Threads gleichzeitig 
+     * erfolgen kann */
+    codelength_limited(frequencys, ((BLOCK_JOB *) job)->max_code_length, 
+                       lengths);
+    (void) canonical_create(lengths, &canon);
+    canonical_get_codes(&canon, codes);
+
+    /* Die Größe jedes Teilstroms ergibt sich genau aus Häufigkeiten und 
+     * Codelängen */
+    for (k = 0; k < streams; k++)
+    {
+        bits = 0;
+        for (c = 0; c < MAX_CHARACTERS; c++)
+        {
+            bits += stream_frequencys[k][c] * lengths[c];
+        }
+        stream_sizes[k] = (size_t) ((bits + 7) / 8);
+        packed_size += stream_sizes[k];
+    }
+
+    block->packed = (unsigned char *) malloc(CANONICAL_MAX_HEADER_SIZE 
+                                             + (streams - 1) * MAX_VARINT_SIZE
+                                             + packed_size);
+    ENSURE_ENOUGH_MEMORY(block->packed, "compress_block");
+    out = block->packed + canonical_store_header(&canon, block->packed);
+
+    /* Sprungtabelle: Größen aller Teilströme außer dem letzten */
+    for (k = 0; k + 1 < streams; k++)
+    {
+        out += store_varint(stream_sizes[k], out);
+    }
+
+    plain = block->plain;
+    for (k = 0; k < streams; k++)
+    {
+        size_t count = get_stream_count(block->plain_size, streams, k);
+
+        out = encode_stream(codes, plain, count, out);
+        plain += count;
+    }
+
+    block->packed_size = (size_t) (out - block->packed);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: get_stream_count
+ * ------------------------------------------------------------------------ */
+static size_t get_stream_count(size_t size, unsigned int streams, 
+                               unsigned int stream)
+{
+    return (streams == 1) ? size : decode_stream_count(size, stream);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: encode_stream
+ * ------------------------------------------------------------------------ */
+static unsigned char *encode_stream(const HUFF_CODE codes[], 
+                                    const unsigned char plain[], size_t size,
+                                    unsigned char *out)
+{
+    /* Bitakkumulator, die letzten bit_count Bits stehen rechtsbündig */
+    unsigned long long bit_buffer = 0;
+    int bit_count = 0;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        const HUFF_CODE *code = &codes[plain[i]];
+
+        bit_buffer = (bit_buffer << code->length) | code->bits;
+        bit_count += code->length;
+
+        if (bit_count >= 32)
+        {
+            bit_count -= 32;
+            out[0] = (unsigned char) (bit_buffer >> (bit_count + 24));
+            out[1] = (unsigned char) (bit_buffer >> (bit_count + 16));
+            out[2] = (unsigned char) (bit_buffer >> (bit_count + 8));
+            out[3] = (unsigned char) (bit_buffer >> bit_count);
+            out += 4;
+        }
+    }
+
+    /* Verbliebene Bits schreiben, das letzte Byte mit 0-Bits auffüllen */
+    while (bit_count > 0)
+    {
+        bit_count -= 8;
+        *out++ = (unsigned char) (bit_count >= 0
+                ? bit_buffer >> bit_count
+                : bit_buffer << -bit_count);
+    }
+
+    return out;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: block_decompress
+ * ------------------------------------------------------------------------ */
+extern bool block_decompress(const unsigned char data[], size_t size,
+                             unsigned int streams, unsigned int threads)
+{
+    unsigned char *plain;
+    size_t plain_size;
+
+    if (!block_decompress_memory(data, size, streams, threads, &plain, 
+                                 &plain_size))
+    {
+        return false;
+    }
+
+    write_bytes(plain, plain_size);
+    free(plain);
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: block_decompress_memory
+ * ------------------------------------------------------------------------ */
+extern bool block_decompress_memory(const unsigned char data[], size_t size,
+                                    unsigned int streams, unsigned int threads,
+                                    unsigned char **plain_data,
+                                    size_t *plain_size)
+{
+    BLOCK_JOB job;
+    unsigned long long all_characters;
+    unsigned long long block_size;
+    unsigned int block_count;
+    unsigned char *plain = NULL;
+    bool valid;
+    unsigned int i;
+
+    if (!load_block_index(data, size, &job, &all_characters, &block_size,
+                          &block_count))
+    {
+        return false;
+    }
+
+    job.streams = streams;
+    plain = (unsigned char *) malloc((size_t) all_characters + 1);
+    ENSURE_ENOUGH_MEMORY(plain, "block_decompress_memory");
+
+    for (i = 0; i < block_count; i++)
+    {
+        job.blocks[i].plain = plain + (size_t) i * block_size;
+    }
+
+    threadpool_run(threads, block_count, decompress_block, &job);
+
+    valid = true;
+    for (i = 0; i < block_count; i++)
+    {
+        valid = valid && job.blocks[i].valid;
+    }
+
+    free(job.blocks);
+
+    if (!valid)
+    {
+        free(plain);
+        plain = NULL;
+    }
+    *plain_data = plain;
+    *plain_size = (size_t) all_characters;
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: block_decompress_range
+ * ------------------------------------------------------------------------ */
+extern bool block_decompress_range(const unsigned char data[], size_t size,
+                                   unsigned int streams,
+                                   unsigned long long offset,
+                                   unsigned long long length)
+{
+    BLOCK_JOB job;
+    unsigned long long all_characters;
+    unsigned long long block_size;
+    unsigned long long end;
+    unsigned long long block_start;
+    unsigned long long from;
+    unsigned long long to;
+    unsigned int block_count;
+    unsigned char *plain;
+    bool valid = true;
+    unsigned int i;
+
+    if (!load_block_index(data, size, &job, &all_characters, &block_size,
+                          &block_count))
+    {
+        return false;
+    }
+
+    /* Der Bereich wird auf das Ende der Daten beschränkt */
+    offset = (offset < all_characters) ? offset : all_characters;
+    end = (length < all_characters - offset) ? offset + length 
+                                             : all_characters;
+
+    job.streams = streams;
+    plain = (unsigned char *) malloc((size_t) block_size);
+    ENSURE_ENOUGH_MEMORY(plain, "block_decompress_range");
+
+    /* Nur die Blöcke, die den Bereich überdecken, werden dekodiert */
+    for (i = (unsigned int) (offset / block_size); 
+         offset < end && i <= (end - 1) / block_size && valid; i++)
+    {
+        block_start = (unsigned long long) i * block_size;
+        job.blocks[i].plain = plain;
+        decompress_block(&job, i);
+        valid = job.blocks[i].valid;
+
+        if (valid)
+        {
+            from = (offset > block_start) ? offset - block_start : 0;
+            to = (end < block_start + job.blocks[i].plain_size)
+                    ? end - block_start : job.blocks[i].plain_size;
+            write_bytes(plain + from, (size_t) (to - from));
+        }
+    }
+
+    free(plain);
+    free(job.blocks);
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: load_block_index
+ * ------------------------------------------------------------------------ */
+static bool load_block_index(const unsigned char data[], size_t size,
+                             BLOCK_JOB *job, unsigned long long *all_characters,
+                             unsigned long long *block_size,
+                             unsigned int *block_count)
+{
+    unsigned long long count;
+    unsigned long long packed_size;
+    size_t pos = 0;
+    size_t used;
+    size_t offset;
+    bool valid = true;
+    unsigned int i;
+
+    /* Header lesen und prüfen */
+    used = load_varint(data, size, all_characters);
+    pos += used;
+    if (used > 0)
+    {
+        used = load_varint(data + pos, size - pos, block_size);
+        pos += used;
+    }
+    if (used > 0)
+    {
+        used = load_varint(data + pos, size - pos, &count);
+        pos += used;
+    }
+    if (used == 0 || *block_size < BLOCK_MIN_SIZE 
+        || *block_size > BLOCK_MAX_SIZE
+        || *all_characters > (size_t) -1
+        || count != (*all_characters + *block_size - 1) / *block_size
+        || count > size - pos || count > UINT_MAX)
+    {
+        return false;
+    }
+    *block_count = (unsigned int) count;
+
+    job->blocks = (BLOCK *) calloc((size_t) count + 1, sizeof (BLOCK));
+    ENSURE_ENOUGH_MEMORY(job->blocks, "load_block_index");
+
+    /* Index lesen: Die Blöcke folgen in ihrer Reihenfolge direkt auf den
+     * Index */
+    for (i = 0; i < count && valid; i++)
+    {
+        used = load_varint(data + pos, size - pos, &packed_size);
+        pos += used;
+        valid = used > 0;
+        job->blocks[i].packed_size = (size_t) packed_size;
+    }
+    offset = pos;
+    for (i = 0; i < count && valid; i++)
+    {
+        valid = job->blocks[i].packed_size <= size - offset;
+        job->blocks[i].packed = (unsigned char *) data + offset;
+        job->blocks[i].plain_size = (i + 1 < count)
+                ? (size_t) *block_size
+                : (size_t) (*all_characters - i * *block_size);
+        offset += job->blocks[i].packed_size;
+    }
+
+    if (!valid)
+    {
+        free(job->blocks);
+        job->blocks = NULL;
+    }
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_block
+ * ------------------------------------------------------------------------ */
+static void decompress_block(void *job, unsigned int index)
+{
+    BLOCK *block = &((BLOCK_JOB *) job)->blocks[index];
+    HUFF_CODE codes[MAX_CHARACTERS];
+    CANONICAL_CODE canon;
+    DECODE_TABLE *table;
+    size_t stream_sizes[DECODE_STREAMS];
+    size_t used_sizes;
+    size_t used;
+
+    used = canonical_load_header(&canon, block->packed, block->packed_size);
+    if (used == 0 || canon.symbol_count == 0)
+    {
+        block->valid = false;
+        return;
+    }
+
+    canonical_get_codes(&canon, codes);
+    table = decode_table_create(codes);
+    if (table == NULL)
+    {
+        block->valid = false;
+        return;
+    }
+
+    /* Die Zeichen werden direkt an ihre Position in der Ausgabe 
+     * geschrieben */
+    if (((BLOCK_JOB *) job)->streams == 1)
+    {
+        block->valid = decode_table_decode(table, block->packed + used,
+                                           block->packed_size - used,
+                                           block->plain,
+                                           block->plain_size);
+    }
+    else
+    {
+        block->valid = load_stream_sizes(block->packed + used, 
+                                         block->packed_size - used,
+                                         stream_sizes, &used_sizes)
+                && decode_table_decode_streams(table, 
+                                               block->packed + used 
+                                               + used_sizes,
+                                               stream_sizes, block->plain,
+                                               block->plain_size);
+    }
+
+    decode_table_destroy(&table);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: load_stream_sizes
+ * ------------------------------------------------------------------------ */
+static bool load_stream_sizes(const unsigned char data[], size_t size,
+                              size_t stream_sizes[], size_t *used)
+{
+    unsigned long long stream_size;
+    size_t pos = 0;
+    size_t rest;
+    size_t length;
+    unsigned int k;
+
+    for (k = 0; k + 1 < DECODE_STREAMS; k++)
+    {
+        length = load_varint(data + pos, size - pos, &stream_size);
+        pos += length;
+        if (length == 0 || stream_size > size)
+        {
+            return false;
+        }
+        stream_sizes[k] = (size_t) stream_size;
+    }
+
+    /* Der letzte Teilstrom reicht bis zum Ende des Blocks */
+    rest = size - pos;
+    for (k = 0; k + 1 < DECODE_STREAMS; k++)
+    {
+        if (stream_sizes[k] > rest)
+        {
+            return false;
+        }
+        rest -= stream_sizes[k];
+    }
+    stream_sizes[DECODE_STREAMS - 1] = rest;
+    *used = pos;
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: block_compress_stream
+ * ------------------------------------------------------------------------ */
+extern void block_compress_stream(unsigned int block_size,
+                                  unsigned int max_code_length,
+                                  unsigned int streams, unsigned int threads)
+{
+    BLOCK_JOB job;
+    unsigned int batch = get_batch_size(threads);
+    unsigned char *plain;
+    size_t plain_size;
+    unsigned int block_count;
+    unsigned int i;
+
+    job.max_code_length = max_code_length;
+    job.streams = streams;
+    job.blocks = (BLOCK *) calloc(batch, sizeof (BLOCK));
+    ENSURE_ENOUGH_MEMORY(job.blocks, "block_compress_stream");
+    plain = (unsigned char *) malloc((size_t) batch * block_size);
+    ENSURE_ENOUGH_MEMORY(plain, "block_compress_stream");
+
+    do
+    {
+        plain_size = read_bytes(plain, (size_t) batch * block_size);
+        block_count = (unsigned int) ((plain_size + block_size - 1) 
+                                      / block_size);
+
+        for (i = 0; i < block_count; i++)
+        {
+            job.blocks[i].plain = plain + (size_t) i * block_size;
+            job.blocks[i].plain_size = (i + 1 < block_count)
+                    ? block_size
+                    : plain_size - (size_t) i * block_size;
+        }
+
+        threadpool_run(threads, block_count, compress_block, &job);
+
+        for (i = 0; i < block_count; i++)
+        {
+            write_varint(job.blocks[i].plain_size);
+            write_varint(job.blocks[i].packed_size);
+            write_bytes(job.blocks[i].packed, job.blocks[i].packed_size);
+            free(job.blocks[i].packed);
+        }
+    }
+    while (plain_size == (size_t) batch * block_size);
+
+    /* Ende des Stroms */
+    write_varint(0);
+
+    free(plain);
+    free(job.blocks);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: block_decompress_stream
+ * ------------------------------------------------------------------------ */
+extern bool block_decompress_stream(unsigned int streams, 
+                                    unsigned int threads)
+{
+    BLOCK_JOB job;
+    unsigned int batch = get_batch_size(threads);
+    unsigned long long plain_size = 0;
+    unsigned long long packed_size;
+    unsigned int block_count;
+    bool valid = true;
+    unsigned int i;
+
+    job.streams = streams;
+    job.blocks = (BLOCK *) calloc(batch, sizeof (BLOCK));
+    ENSURE_ENOUGH_MEMORY(job.blocks, "block_decompress_stream");
+
+    do
+    {
+        /* Bis zu batch Blöcke einlesen. Ein Block besteht höchstens aus
+         * Codes mit DECODE_MAX_CODE_LENGTH Bits je Zeichen. */
+        block_count = 0;
+        while (valid && block_count < batch)
+        {
+            BLOCK *block = &job.blocks[block_count];
+
+            /* Das Ende muss ausdrücklich gekennzeichnet sein */
+            valid = has_next_char();
+            plain_size = read_varint();
+            if (!valid || plain_size == 0)
+            {
+                break;
+            }
+
+            packed_size = read_varint();
+            valid = plain_size <= BLOCK_MAX_SIZE
+                    && packed_size <= CANONICAL_MAX_HEADER_SIZE 
+                       + (DECODE_STREAMS - 1) * MAX_VARINT_SIZE
+                       + (plain_size * DECODE_MAX_CODE_LENGTH + 7) / 8
+                       + DECODE_STREAMS;
+            if (valid)
+            {
+                block->plain_size = (size_t) plain_size;
+                block->packed_size = (size_t) packed_size;
+                block->plain = (unsigned char *) malloc(block->plain_size);
+                ENSURE_ENOUGH_MEMORY(block->plain, "block_decompress_stream");
+                block->packed = (unsigned char *) malloc(block->packed_size);
+                ENSURE_ENOUGH_MEMORY(block->packed, "block_decompress_stream");
+                block_count++;
+
+                valid = read_bytes(block->packed, block->packed_size) 
+                        == block->packed_size;
+            }
+        }
+
+        if (valid)
+        {
+            threadpool_run(threads, block_count, decompress_block, &job);
+        }
+
+        for (i = 0; i < block_count; i++)
+        {
+            valid = valid && job.blocks[i].valid;
+            if (valid)
+            {
+                write_bytes(job.blocks[i].plain, job.blocks[i].plain_size);
+            }
+            free(job.blocks[i].plain);
+            free(job.blocks[i].packed);
+        }
+    }
+    while (valid && plain_size != 0);
+
+    free(job.blocks);
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: get_batch_size
+ * ------------------------------------------------------------------------ */
+static unsigned int get_batch_size(unsigned int threads)
+{
+    return (threads == 0) ? threadpool_get_processors() : threads;
+}
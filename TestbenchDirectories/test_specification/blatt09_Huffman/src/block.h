@@ -0,0 +1,174 @@
+/**
+ * @file
+ * Dieses Modul realisiert das blockweise Format (#FORMAT_BLOCKS). Die
+ * Eingabe wird in gleich große, voneinander unabhängige Blöcke aufgeteilt,
+ * die jeweils mit einem eigenen kanonischen Code komprimiert werden. Die
+ * Blöcke werden mit dem Modul threadpool parallel komprimiert und 
+ * dekomprimiert.
+ *
+ * Nach dem Container-Header hat das Format folgenden Aufbau:
+ * <UL>
+ * <LI> Varint: Anzahl aller Zeichen
+ * <LI> Varint: Blockgröße B in Bytes, jeder Block außer dem letzten enthält
+ *              genau B Zeichen
+ * <LI> Varint: Anzahl der Blöcke
+ * <LI> je Block ein Varint: Größe des komprimierten Blocks in Bytes. Aus 
+ *              diesem Index ergibt sich die Position jedes Blocks.
+ * <LI> die komprimierten Blöcke: je Block die Codelängen im Format des 
+ *              Moduls canonical und der auf ganze Bytes aufgefüllte 
+ *              Bitstrom
+ * </UL>
+ *
+ * Mit #DECODE_STREAMS Teilströmen je Block wird der Bitstrom eines Blocks
+ * in vier Teilströme für zusammenhängende Viertel des Blocks aufgeteilt 
+ * (siehe decode_stream_count). Auf die Codelängen folgen dann als 
+ * Sprungtabelle drei Varints mit den Größen der ersten drei Teilströme in 
+ * Bytes und danach die vier jeweils auf ganze Bytes aufgefüllten 
+ * Teilströme. Der Dekodierer verfolgt die vier Teilströme gleichzeitig.
+ *
+ * Im Stromformat (#FORMAT_STREAM) ist kein Index vorhanden, damit ohne 
+ * Kenntnis der Eingabegröße in einem Durchlauf komprimiert werden kann. Nach
+ * dem Container-Header folgen die Blöcke jeweils mit eigenem Kopf:
+ * <UL>
+ * <LI> Varint: Anzahl der Zeichen des Blocks, 0 kennzeichnet das Ende
+ * <LI> Varint: Größe des komprimierten Blocks in Bytes
+ * <LI> der komprimierte Block wie im blockweisen Format
+ * </UL>
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef BLOCK_H
+#define BLOCK_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Kleinste zulässige Blockgröße in Bytes */
+#define BLOCK_MIN_SIZE (64u * 1024u)
+
+/** Größte zulässige Blockgröße in Bytes */
+#define BLOCK_MAX_SIZE (64u * 1024u * 1024u)
+
+/** Standard-Blockgröße in Bytes */
+#define BLOCK_DEFAULT_SIZE (1024u * 1024u)
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Komprimiert die übergebenen Daten blockweise und schreibt das Ergebnis
+ * ohne Container-Header in den Ausgabestrom.
+ *
+ * @param data              die zu komprimierenden Daten
+ * @param size              Größe der Daten in Bytes
+ * @param block_size        Blockgröße in Bytes
+ * @param max_code_length   maximale Codelänge, höchstens 
+ *                          #DECODE_MAX_CODE_LENGTH
+ * @param streams           Anzahl der Teilströme je Block, 1 oder 
+ *                          #DECODE_STREAMS
+ * @param threads           Anzahl der Threads, 0 für die Anzahl der
+ *                          Prozessoren
+ */
+extern void block_compress(const unsigned char data[], size_t size,
+                           unsigned int block_size,
+                           unsigned int max_code_length,
+                           unsigned int streams, unsigned int threads);
+
+/**
+ * Dekomprimiert blockweise komprimierte Daten und schreibt das Ergebnis in
+ * den Ausgabestrom.
+ *
+ * @param data      die komprimierten Daten, beginnend nach dem 
+ *                  Container-Header
+ * @param size      Größe der komprimierten Daten in Bytes
+ * @param streams   Anzahl der Teilströme je Block, 1 oder #DECODE_STREAMS
+ * @param threads   Anzahl der Threads, 0 für die Anzahl der Prozessoren
+ * @return          false, wenn die Daten fehlerhaft sind, true sonst
+ */
+extern bool block_decompress(const unsigned char data[], size_t size,
+                             unsigned int streams, unsigned int threads);
+
+
+/**
+ * Dekomprimiert blockweise komprimierte Daten in den Speicher.
+ *
+ * @param data          die komprimierten Daten, beginnend nach dem 
+ *                      Container-Header
+ * @param size          Größe der komprimierten Daten in Bytes
+ * @param streams       Anzahl der Teilströme je Block, 1 oder 
+ *                      #DECODE_STREAMS
+ * @param threads       Anzahl der Threads, 0 für die Anzahl der Prozessoren
+ * @param plain_data    die dekomprimierten Daten, freizugeben mit free
+ * @param plain_size    Größe der dekomprimierten Daten in Bytes
+ * @return              false, wenn die Daten fehlerhaft sind, true sonst
+ */
+extern bool block_decompress_memory(const unsigned char data[], size_t size,
+                                    unsigned int streams, unsigned int threads,
+                                    unsigned char **plain_data,
+                                    size_t *plain_size);
+
+/**
+ * Dekomprimiert nur den Bereich [offset, offset + length) der blockweise
+ * komprimierten Daten und schreibt ihn in den Ausgabestrom. Über den Index
+ * werden lediglich die Blöcke dekodiert, die den Bereich überdecken. Ein 
+ * Bereich über das Ende der Daten hinaus wird dort abgeschnitten.
+ *
+ * @param data      die komprimierten Daten, beginnend nach dem 
+ *                  Container-Header
+ * @param size      Größe der komprimierten Daten in Bytes
+ * @param streams   Anzahl der Teilströme je Block, 1 oder #DECODE_STREAMS
+ * @param offset    Position des ersten auszugebenden Zeichens
+ * @param length    Anzahl der auszugebenden Zeichen
+ * @return          false, wenn die Daten fehlerhaft sind, true sonst
+ */
+extern bool block_decompress_range(const unsigned char data[], size_t size,
+                                   unsigned int streams,
+                                   unsigned long long offset,
+                                   unsigned long long length);
+
+/**
+ * Komprimiert den mit open_infile geöffneten Eingabestrom im Stromformat 
+ * und schreibt das Ergebnis ohne Container-Header in den Ausgabestrom. Es 
+ * werden jeweils so viele Blöcke eingelesen, wie Threads verwendet werden.
+ *
+ * @param block_size        Blockgröße in Bytes
+ * @param max_code_length   maximale Codelänge, höchstens 
+ *                          #DECODE_MAX_CODE_LENGTH
+ * @param streams           Anzahl der Teilströme je Block, 1 oder 
+ *                          #DECODE_STREAMS
+ * @param threads           Anzahl der Threads, 0 für die Anzahl der
+ *                          Prozessoren
+ */
+extern void block_compress_stream(unsigned int block_size,
+                                  unsigned int max_code_length,
+                                  unsigned int streams, unsigned int threads);
+
+/**
+ * Dekomprimiert den mit open_infile geöffneten Eingabestrom im Stromformat,
+ * dessen Container-Header bereits gelesen wurde, und schreibt das Ergebnis
+ * in den Ausgabestrom.
+ *
+ * @param streams   Anzahl der Teilströme je Block, 1 oder #DECODE_STREAMS
+ * @param threads   Anzahl der Threads, 0 für die Anzahl der Prozessoren
+ * @return          false, wenn die Daten fehlerhaft sind, true sonst
+ */
+extern bool block_decompress_stream(unsigned int streams, 
+                                    unsigned int threads);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* BLOCK_H */
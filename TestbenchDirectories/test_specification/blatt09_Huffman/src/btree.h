@@ -1,122 +0,0 @@
-/**
- * @file
- * Dieses Modul stellt eine Struktur zur Reprsentation von Binrbumen
- * und Funktionen darauf zur Verfgung.
- *
- * @author  Ulrike Griefahn
- * @date    2010-12-12
- */ 
-
-#ifndef _BTREE_H
-#define _BTREE_H
-/* ------------------------------------------------------------------------ */
-
-
-/* ===========================================================================
- * Header-Dateien 
- * ======================================================================== */
-
-#include "btreenode.h"
-#include <stdbool.h>
-
-/**
- * Typ fr den Binrbaum
- */
-typedef struct _BTREE BTREE;
-
-/* ===========================================================================
- * Funktionsprototypen
- * ======================================================================== */
-
-/**
- * Erzeugt einen neuen Binrbaum, dessen Wurzel die bergebenen Daten 
- * beinhaltet. Im zweiten Parameter wird die Funktion bergeben, mit der die
- * enthaltenen Daten gelscht werden knnen, im dritten Parameter wird die
- * Funktion bergeben, mit der die Daten am Bildschirm ausgegeben werden knnen.
- * In beiden Parametern kann NULL bergeben werden, so dass keine Funktionen
- * zum Ausgeben und Lschen der Knotendaten gesetzt sind.
- * 
- * @param data          Daten fr die Wurzel des neuen Baums
- * @param destroy_data  Funktion, mit der die in den Knoten
- *                      enthaltenen Daten gelscht werden knnen oder NULL
- * @param print_data    Funktion, mit der die in den Knoten
- *                      enthaltenen Daten am Bildschirm ausgegeben werden
- *                      knnen oder NULL
- * @return              der neu erzeugte Binrbaum
- */
-extern BTREE *btree_new(void *data,
-                        DESTROY_DATA_FCT destroy_data, 
-                        PRINT_DATA_FCT print_data);
-
-/**
- * Erzeugt eine Kopie (deep copy) des bergebenen Binrbaums. Es werden die
- * Struktur des Baums und die Knoten kopiert. Die in den Knoten enthaltenen
- * Daten werden nicht kopiert, sondern nur die Referenz auf sie bernommen.
- * Im Anschluss an die Funktion verweisen beide Bume auf dieselben Daten.
- * 
- * Es wird davon ausgegangen, dass tree != NULL ist.
- * 
- * @param tree  Binrbaum, der kopiert werden soll
- * @return      die neu erzeugte Kopie
- */
-extern BTREE *btree_clone(BTREE *tree);
-
-/**
- * Lscht den bergebenen Baum, d.h. alle Knoten ausgehend von der Wurzel und 
- * die Struktur fr den Baum. Wird im zweiten Argument true bergeben, werden
- * die in den Knoten enthaltenen Daten ebenfalls gelscht.
- * 
- * @param tree          Baum, der gelscht werden soll
- * @param destroy_data  true, wenn die Daten gelscht werden sollen;
- *                      false, sonst
- */
-extern void btree_destroy(BTREE **tree, bool destroy_data);
-
-/**
- * Vergleicht die beiden bergebenen Binrbume miteinander. Zwei Binrbume
- * sind gleich, wenn  beide Baeume ab dem Wurzelknoten dieselbe Struktur
- * besitzen und in allen Knoten auf dieselben Daten verweisen. Sie knnen sich
- * in den gespeicherten Funktionen unterscheiden.
- *
- * @param tree1     der erste zu vergleichende Binrbaum
- * @param tree2     der zweite zu vergleichende Binrbaum
- * @return          true, wenn beide Bume gleich sind, false sonst
- */
-extern bool btree_equals(BTREE *tree1, BTREE *tree2);
-
-/**
- * Liefert die Wurzel des bergebenen Binrbaums.
- * 
- * @param tree  Binrbaum, dessen Wurzel geliefert werden soll
- * @return      Wurzel des Baums oder NULL, wenn der Baum keinen Wurzelknoten
- *              hat oder kein Baum bergeben wurde
- */
-extern BTREE_NODE *btree_get_root(BTREE *tree);
-
-/**
- * Erzeugt einen neuen Binrbaum, dessen Wurzel die bergebenen Daten 
- * erhlt. Die neue Wurzel bekommt die Wurzel des Binrbaums left als
- * linken Nachfolger und die Wurzel des Binrbaums right als rechten 
- * Nachfolger. Der neue Baum erhlt die Funktionen aus dem Baum, der als 
- * linker Nachfolger angefgt wird.
- * 
- * Der Speicherbereich der Bume left und right, jedoch nicht ihrer Knoten 
- * wird freigegeben.
- * 
- * @param left      die erste zu verbindenden Bume
- * @param right     der zweite der beiden zu verbindenden Bume
- * @param data      die Daten fr die Wurzel im neuen Baum
- * @return          der neu erzeugte Baum
- */
-extern BTREE *btree_merge(BTREE *left, BTREE *right, void *data);
-
-/**
- * Gibt den Binrbaum mit seinen Daten in Preorder-Reihenfolge auf dem 
- * Bildschirm aus.
- *
- * @param tree      Binrbaum, der ausgegeben werden soll
- */
-extern void btree_print(BTREE *tree);
-
-/* ------------------------------------------------------------------------ */
-#endif
@@ -0,0 +1,289 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "huffman_common.h"
+#include "io.h"
+#include "canonical.h"
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Berechnet aus der Anzahl der Codes je Codelänge den ersten Code und den
+ * Index des ersten Zeichens je Codelänge und prüft, ob die Codelängen einen
+ * präfixfreien Code ergeben.
+ *
+ * @param canon     kanonischer Code, in dem count und max_length gesetzt sind
+ * @return          true, wenn der Code gültig ist, false sonst
+ */
+static bool canonical_init(CANONICAL_CODE *canon);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: canonical_create
+ * ------------------------------------------------------------------------ */
+extern bool canonical_create(const unsigned char lengths[],
+                             CANONICAL_CODE *canon)
+{
+    unsigned int length;
+    int c;
+
+    memset(canon, 0, sizeof (CANONICAL_CODE));
+
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (lengths[c] > CANONICAL_MAX_LENGTH)
+        {
+            return false;
+        }
+        if (lengths[c] > canon->max_length)
+        {
+            canon->max_length = lengths[c];
+        }
+        canon->count[lengths[c]]++;
+    }
+    canon->count[0] = 0;
+
+    if (!canonical_init(canon))
+    {
+        return false;
+    }
+
+    /* Zeichen nach Codelänge und innerhalb einer Codelänge nach Zeichenwert
+     * sortiert ablegen */
+    for (length = 1; length <= canon->max_length; length++)
+    {
+        for (c = 0; c < MAX_CHARACTERS; c++)
+        {
+            if (lengths[c] == length)
+            {
+                canon->symbols[canon->symbol_count] = (unsigned char) c;
+                canon->symbol_count++;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: canonical_init
+ * ------------------------------------------------------------------------ */
+static bool canonical_init(CANONICAL_CODE *canon)
+{
+    /* Anzahl der auf der aktuellen Codelänge noch freien Codes */
+    unsigned long long available = 1;
+    unsigned long long code = 0;
+    unsigned int symbols = 0;
+    unsigned int length;
+
+    canon->min_length = 0;
+
+    for (length = 1; length <= canon->max_length; length++)
+    {
+        /* Je Codelänge verdoppelt sich die Anzahl freier Codes. Mehr als
+         * MAX_CHARACTERS freie Codes können nie mehr aufgebraucht werden. */
+        available = (available < MAX_CHARACTERS) ? available * 2 : available;
+        if (canon->count[length] > available)
+        {
+            return false;
+        }
+        available -= canon->count[length];
+
+        code = (code + canon->count[length - 1]) << 1;
+        canon->first[length] = code;
+        canon->offset[length] = symbols;
+        symbols += canon->count[length];
+
+        if (canon->min_length == 0 && canon->count[length] > 0)
+        {
+            canon->min_length = length;
+        }
+    }
+
+    return symbols <= MAX_CHARACTERS;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: canonical_get_codes
+ * ------------------------------------------------------------------------ */
+extern void canonical_get_codes(const CANONICAL_CODE *canon, HUFF_CODE codes[])
+{
+    unsigned int length;
+    unsigned int i;
+
+    memset(codes, 0, MAX_CHARACTERS * sizeof (HUFF_CODE));
+
+    for (length = 1; length <= canon->max_length; length++)
+    {
+        for (i = 0; i < canon->count[length]; i++)
+        {
+            HUFF_CODE *code = &codes[canon->symbols[canon->offset[length] + i]];
+            code->bits = canon->first[length] + i;
+            code->length = (unsigned char) length;
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: canonical_write_header
+ * ------------------------------------------------------------------------ */
+extern void canonical_write_header(const CANONICAL_CODE *canon)
+{
+    unsigned char buffer[CANONICAL_MAX_HEADER_SIZE];
+
+    write_bytes(buffer, canonical_store_header(canon, buffer));
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: canonical_store_header
+ * ------------------------------------------------------------------------ */
+extern size_t canonical_store_header(const CANONICAL_CODE *canon,
+                                     unsigned char buffer[])
+{
+    size_t size = 0;
+    unsigned int length;
+
+    buffer[size++] = (unsigned char) canon->max_length;
+
+    for (length = 1; length <= canon->max_length; length++)
+    {
+        size += store_varint(canon->count[length], buffer + size);
+    }
+
+    memcpy(buffer + size, canon->symbols, canon->symbol_count);
+
+    return size + canon->symbol_count;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: canonical_load_header
+ * ------------------------------------------------------------------------ */
+extern size_t canonical_load_header(CANONICAL_CODE *canon,
+                                    const unsigned char data[], size_t size)
+{
+    unsigned long long count;
+    size_t pos = 1;
+    size_t used;
+    unsigned int length;
+
+    memset(canon, 0, sizeof (CANONICAL_CODE));
+
+    if (size < 1 || data[0] > CANONICAL_MAX_LENGTH)
+    {
+        return 0;
+    }
+    canon->max_length = data[0];
+
+    for (length = 1; length <= canon->max_length; length++)
+    {
+        used = load_varint(data + pos, size - pos, &count);
+        if (used == 0 || count > MAX_CHARACTERS)
+        {
+            return 0;
+        }
+        canon->count[length] = (unsigned int) count;
+        pos += used;
+    }
+
+    if (!canonical_init(canon))
+    {
+        return 0;
+    }
+
+    canon->symbol_count = canon->offset[canon->max_length]
+                          + canon->count[canon->max_length];
+    if (size - pos < canon->symbol_count)
+    {
+        return 0;
+    }
+    memcpy(canon->symbols, data + pos, canon->symbol_count);
+
+    return pos + canon->symbol_count;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: canonical_read_header
+ * ------------------------------------------------------------------------ */
+extern bool canonical_read_header(CANONICAL_CODE *canon)
+{
+    unsigned long long count;
+    unsigned int length;
+    unsigned int i;
+
+    memset(canon, 0, sizeof (CANONICAL_CODE));
+
+    canon->max_length = read_char();
+    if (canon->max_length > CANONICAL_MAX_LENGTH)
+    {
+        return false;
+    }
+
+    for (length = 1; length <= canon->max_length; length++)
+    {
+        count = read_varint();
+        if (count > MAX_CHARACTERS)
+        {
+            return false;
+        }
+        canon->count[length] = (unsigned int) count;
+    }
+
+    if (!canonical_init(canon))
+    {
+        return false;
+    }
+
+    canon->symbol_count = canon->offset[canon->max_length]
+                          + canon->count[canon->max_length];
+    for (i = 0; i < canon->symbol_count; i++)
+    {
+        canon->symbols[i] = read_char();
+    }
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: canonical_decode
+ * ------------------------------------------------------------------------ */
+extern unsigned int canonical_decode(const CANONICAL_CODE *canon,
+                                     unsigned long long window,
+                                     unsigned char *symbol)
+{
+    /* führende Bits des Fensters in der aktuellen Codelänge */
+    unsigned long long prefix;
+    unsigned int length;
+
+    if (canon->min_length == 0)
+    {
+        return 0;
+    }
+
+    for (length = canon->min_length; length <= canon->max_length; length++)
+    {
+        prefix = window >> (64 - length);
+
+        /* Die Codes einer Länge sind aufeinanderfolgende Zahlen ab first.
+         * Ein kleinerer Präfix wäre bereits als kürzerer Code erkannt
+         * worden. */
+        if (prefix < canon->first[length] + canon->count[length])
+        {
+            *symbol = canon->symbols[canon->offset[length]
+                                     + (prefix - canon->first[length])];
+            return length;
+        }
+    }
+
+    return 0;
+}
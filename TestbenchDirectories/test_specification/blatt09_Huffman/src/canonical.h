@@ -0,0 +1,170 @@
+/**
+ * @file
+ * Dieses Modul realisiert kanonische Huffman-Codes. Bei kanonischen Codes
+ * ergeben sich die Codes aller Zeichen allein aus ihren Codelängen: Die
+ * Zeichen werden nach Codelänge und Zeichenwert sortiert und erhalten der
+ * Reihe nach aufsteigende Codes. Für die Dekomprimierung genügt es daher,
+ * die Codelängen zu speichern. Dekodiert wird über den ersten Code und den
+ * Index des ersten Zeichens je Codelänge, ohne einen Baum aufzubauen.
+ *
+ * Der Header für die Codelängen hat folgendes Format:
+ * <UL>
+ * <LI> 1 Byte:  maximale Codelänge L (0 bei einer leeren Datei)
+ * <LI> L Varints: Anzahl der Zeichen mit der Codelänge 1 bis L
+ * <LI> N Byte:  die N Zeichen in kanonischer Reihenfolge, d.h. aufsteigend
+ *               nach Codelänge und innerhalb einer Codelänge nach Zeichenwert
+ * </UL>
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CANONICAL_H
+#define CANONICAL_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "huffman_common.h"
+#include "codetable.h"
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/**
+ * Maximale Länge eines kanonischen Codes, so dass jeder Code in das 
+ * mindestens 57 Bits lange Bitfenster der Dekomprimierung passt
+ */
+#define CANONICAL_MAX_LENGTH 56
+
+/**
+ * Maximale Größe des Headers in Bytes: Die Anzahl der Codes je Codelänge
+ * ist höchstens #MAX_CHARACTERS und benötigt damit höchstens 2 Bytes.
+ */
+#define CANONICAL_MAX_HEADER_SIZE \
+        (1 + 2 * CANONICAL_MAX_LENGTH + MAX_CHARACTERS)
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Beschreibung eines kanonischen Codes durch die Anzahl der Codes je
+ * Codelänge und die Zeichen in kanonischer Reihenfolge
+ */
+typedef struct
+{
+    /** Anzahl der codierten Zeichen */
+    unsigned int symbol_count;
+
+    /** kleinste vorkommende Codelänge */
+    unsigned int min_length;
+
+    /** größte vorkommende Codelänge */
+    unsigned int max_length;
+
+    /** Anzahl der Codes je Codelänge */
+    unsigned int count[CANONICAL_MAX_LENGTH + 1];
+
+    /** erster (kleinster) Code je Codelänge */
+    unsigned long long first[CANONICAL_MAX_LENGTH + 1];
+
+    /** Index in symbols des Zeichens mit dem ersten Code je Codelänge */
+    unsigned int offset[CANONICAL_MAX_LENGTH + 1];
+
+    /** die Zeichen in kanonischer Reihenfolge */
+    unsigned char symbols[MAX_CHARACTERS];
+} CANONICAL_CODE;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Erzeugt einen kanonischen Code aus den Codelängen der Zeichen.
+ *
+ * @param lengths   Codelängen der #MAX_CHARACTERS Zeichen, 0 für Zeichen,
+ *                  die nicht vorkommen
+ * @param canon     der zu erzeugende kanonische Code
+ * @return          false, wenn die Codelängen keinen präfixfreien Code
+ *                  ergeben oder zu lang sind, true sonst
+ */
+extern bool canonical_create(const unsigned char lengths[],
+                             CANONICAL_CODE *canon);
+
+/**
+ * Liefert die Codes aller Zeichen eines kanonischen Codes.
+ *
+ * @param canon     der kanonische Code
+ * @param codes     Array, in das die Codes der #MAX_CHARACTERS Zeichen
+ *                  geschrieben werden
+ */
+extern void canonical_get_codes(const CANONICAL_CODE *canon, HUFF_CODE codes[]);
+
+/**
+ * Schreibt die Codelängen des kanonischen Codes in den Ausgabestrom.
+ *
+ * @param canon     der zu schreibende kanonische Code
+ */
+extern void canonical_write_header(const CANONICAL_CODE *canon);
+
+/**
+ * Legt die Codelängen des kanonischen Codes im selben Format wie 
+ * canonical_write_header im Speicher ab.
+ *
+ * @param canon     der abzulegende kanonische Code
+ * @param buffer    Speicher für mindestens #CANONICAL_MAX_HEADER_SIZE Bytes
+ * @return          Anzahl der abgelegten Bytes
+ */
+extern size_t canonical_store_header(const CANONICAL_CODE *canon,
+                                     unsigned char buffer[]);
+
+/**
+ * Liest die Codelängen eines kanonischen Codes aus dem Speicher, im selben
+ * Format wie canonical_read_header.
+ *
+ * @param canon     der zu lesende kanonische Code
+ * @param data      Anfang des Headers
+ * @param size      Anzahl der höchstens zu lesenden Bytes
+ * @return          Anzahl der gelesenen Bytes oder 0, wenn der Header 
+ *                  unvollständig ist oder keinen gültigen Code beschreibt
+ */
+extern size_t canonical_load_header(CANONICAL_CODE *canon,
+                                    const unsigned char data[], size_t size);
+
+/**
+ * Liest die Codelängen eines kanonischen Codes aus dem Eingabestrom.
+ *
+ * @param canon     der zu lesende kanonische Code
+ * @return          false, wenn der Header keinen gültigen Code beschreibt,
+ *                  true sonst
+ */
+extern bool canonical_read_header(CANONICAL_CODE *canon);
+
+/**
+ * Dekodiert das erste Zeichen in einem linksbündigen Bitfenster. Die
+ * Codelängen werden aufsteigend geprüft, bis die führenden Bits des Fensters
+ * kleiner als das Ende des Codebereichs der Codelänge sind.
+ *
+ * @param canon     der kanonische Code
+ * @param window    die nächsten Bits der Eingabe, linksbündig
+ * @param symbol    das dekodierte Zeichen
+ * @return          Länge des dekodierten Codes oder 0, wenn die Bits zu
+ *                  keinem Code gehören
+ */
+extern unsigned int canonical_decode(const CANONICAL_CODE *canon,
+                                     unsigned long long window,
+                                     unsigned char *symbol);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* CANONICAL_H */
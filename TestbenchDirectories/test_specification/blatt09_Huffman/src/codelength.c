@@ -0,0 +1,354 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "huffman_common.h"
+#include "codelength.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/** Maximale Anzahl der Einträge einer Liste im Package-Merge-Verfahren */
+#define MAX_LIST_SIZE (2 * MAX_CHARACTERS)
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Sortiert die vorkommenden Zeichen aufsteigend nach ihrer Häufigkeit, bei
+ * gleicher Häufigkeit nach dem Zeichenwert.
+ *
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @param symbols       Array, in das die vorkommenden Zeichen sortiert
+ *                      geschrieben werden
+ * @return              Anzahl der vorkommenden Zeichen
+ */
+static unsigned int sort_symbols(const unsigned long long frequencys[],
+                                 unsigned char symbols[]);
+
+/**
+ * Berechnet die Huffman-Codelängen der sortierten Zeichen mit dem 
+ * Zwei-Warteschlangen-Verfahren.
+ *
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @param symbols       die vorkommenden Zeichen, aufsteigend nach 
+ *                      Häufigkeit sortiert
+ * @param n             Anzahl der vorkommenden Zeichen, mindestens 2
+ * @param lengths       Array, in das die Codelängen der Zeichen 
+ *                      geschrieben werden
+ * @return              die größte Codelänge
+ */
+static unsigned int huffman_lengths(const unsigned long long frequencys[],
+                                    const unsigned char symbols[],
+                                    unsigned int n, unsigned char lengths[]);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: codelength_huffman
+ * ------------------------------------------------------------------------ */
+extern unsigned int codelength_huffman(const unsigned long long frequencys[],
+                                       unsigned char lengths[])
+{
+    unsigned char symbols[MAX_CHARACTERS];
+    unsigned int n;
+
+    memset(lengths, 0, MAX_CHARACTERS * sizeof (unsigned char));
+
+    n = sort_symbols(frequencys, symbols);
+    if (n <= 1)
+    {
+        if (n == 1)
+        {
+            lengths[symbols[0]] = 1;
+        }
+        return n;
+    }
+
+    return huffman_lengths(frequencys, symbols, n, lengths);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: codelength_limited
+ * ------------------------------------------------------------------------ */
+extern void codelength_limited(const unsigned long long frequencys[],
+                               unsigned int max_length,
+                               unsigned char lengths[])
+{
+    /* Die vorkommenden Zeichen, aufsteigend nach Häufigkeit sortiert */
+    unsigned char symbols[MAX_CHARACTERS];
+    /* Gewichte der Einträge der vorherigen und der aktuellen Liste */
+    unsigned long long previous[MAX_LIST_SIZE];
+    unsigned long long current[MAX_LIST_SIZE];
+    /* Je Liste: ist der Eintrag ein Paket (1) oder ein Zeichen (0)? */
+    unsigned char is_package[CODELENGTH_MAX_LIMIT][MAX_LIST_SIZE];
+    unsigned int previous_size;
+    unsigned int current_size;
+    unsigned int packages;
+    unsigned int selected;
+    unsigned int leaf;
+    unsigned int n;
+    unsigned int level;
+    unsigned int i;
+
+    memset(lengths, 0, MAX_CHARACTERS * sizeof (unsigned char));
+
+    n = sort_symbols(frequencys, symbols);
+    if (n <= 1)
+    {
+        if (n == 1)
+        {
+            lengths[symbols[0]] = 1;
+        }
+        return;
+    }
+
+    /* Reichen die Huffman-Codelängen, ist kein Package-Merge nötig */
+    if (huffman_lengths(frequencys, symbols, n, lengths) <= max_length)
+    {
+        return;
+    }
+    memset(lengths, 0, MAX_CHARACTERS * sizeof (unsigned char));
+
+    /* Mit max_length Bits lassen sich höchstens 2^max_length Zeichen
+     * codieren */
+    while (max_length < CODELENGTH_MAX_LIMIT && (1ull << max_length) < n)
+    {
+        max_length++;
+    }
+    if (max_length > CODELENGTH_MAX_LIMIT)
+    {
+        max_length = CODELENGTH_MAX_LIMIT;
+    }
+
+    /* Liste der größten Codelänge: nur die Zeichen selbst */
+    for (i = 0; i < n; i++)
+    {
+        previous[i] = frequencys[symbols[i]];
+        is_package[0][i] = 0;
+    }
+    previous_size = n;
+
+    /* Je kürzerer Codelänge werden benachbarte Einträge der vorherigen Liste
+     * zu Paketen zusammengefasst und mit den Zeichen nach Gewicht gemischt.
+     * Bei gleichem Gewicht steht das Zeichen vor dem Paket. */
+    for (level = 1; level < max_length; level++)
+    {
+        unsigned int next_leaf = 0;
+        unsigned int next_package = 0;
+
+        packages = previous_size / 2;
+        current_size = 0;
+
+        while (next_leaf < n || next_package < packages)
+        {
+            unsigned long long package_weight = (next_package < packages)
+                    ? previous[2 * next_package] + previous[2 * next_package + 1]
+                    : 0;
+
+            if (next_package >= packages
+                || (next_leaf < n
+                    && frequencys[symbols[next_leaf]] <= package_weight))
+            {
+                current[current_size] = frequencys[symbols[next_leaf]];
+                is_package[level][current_size] = 0;
+                next_leaf++;
+            }
+            else
+            {
+                current[current_size] = package_weight;
+                is_package[level][current_size] = 1;
+                next_package++;
+            }
+            current_size++;
+        }
+
+        memcpy(previous, current, current_size * sizeof (unsigned long long));
+        previous_size = current_size;
+    }
+
+    /* Die ersten 2n-2 Einträge der letzten Liste auswählen. Jedes darin
+     * enthaltene Zeichen verlängert seinen Code um ein Bit, jedes Paket
+     * wählt zwei Einträge der vorherigen Liste aus. */
+    selected = 2 * n - 2;
+    for (level = max_length; level-- > 0; )
+    {
+        packages = 0;
+        leaf = 0;
+        for (i = 0; i < selected; i++)
+        {
+            if (is_package[level][i])
+            {
+                packages++;
+            }
+            else
+            {
+                lengths[symbols[leaf]]++;
+                leaf++;
+            }
+        }
+        selected = 2 * packages;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: codelength_get_max
+ * ------------------------------------------------------------------------ */
+extern unsigned int codelength_get_max(const unsigned char lengths[])
+{
+    unsigned int max_length = 0;
+    int c;
+
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (lengths[c] > max_length)
+        {
+            max_length = lengths[c];
+        }
+    }
+
+    return max_length;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: sort_symbols
+ * ------------------------------------------------------------------------ */
+static unsigned int sort_symbols(const unsigned long long frequencys[],
+                                 unsigned char symbols[])
+{
+    /* Hilfsspeicher für das Mischen */
+    unsigned char buffer[MAX_CHARACTERS];
+    unsigned char *from = symbols;
+    unsigned char *to = buffer;
+    unsigned char *swap;
+    unsigned int n = 0;
+    unsigned int width;
+    unsigned int left;
+    unsigned int right;
+    unsigned int middle;
+    unsigned int end;
+    unsigned int i;
+    int c;
+
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (frequencys[c] > 0)
+        {
+            symbols[n++] = (unsigned char) c;
+        }
+    }
+
+    /* Stabiles Sortieren durch Mischen von unten nach oben, so dass gleich
+     * häufige Zeichen nach dem Zeichenwert geordnet bleiben */
+    for (width = 1; width < n; width *= 2)
+    {
+        for (i = 0; i < n; i += 2 * width)
+        {
+            left = i;
+            middle = (i + width < n) ? i + width : n;
+            right = middle;
+            end = (i + 2 * width < n) ? i + 2 * width : n;
+
+            for (c = (int) i; c < (int) end; c++)
+            {
+                if (left < middle
+                    && (right >= end 
+                        || frequencys[from[left]] <= frequencys[from[right]]))
+                {
+                    to[c] = from[left++];
+                }
+                else
+                {
+                    to[c] = from[right++];
+                }
+            }
+        }
+        swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != symbols)
+    {
+        memcpy(symbols, from, n);
+    }
+
+    return n;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: huffman_lengths
+ * ------------------------------------------------------------------------ */
+static unsigned int huffman_lengths(const unsigned long long frequencys[],
+                                    const unsigned char symbols[],
+                                    unsigned int n, unsigned char lengths[])
+{
+    /* Gewichte der inneren Knoten, die in aufsteigender Reihenfolge 
+     * entstehen und so die zweite Warteschlange bilden */
+    unsigned long long weights[MAX_CHARACTERS];
+    /* Elternknoten der Blätter (0 bis n-1) und der inneren Knoten (ab n) als
+     * Nummer des inneren Knotens */
+    unsigned int parents[2 * MAX_CHARACTERS];
+    /* Tiefe der inneren Knoten */
+    unsigned char depths[MAX_CHARACTERS];
+    unsigned int next_leaf = 0;
+    unsigned int next_node = 0;
+    unsigned int node;
+    unsigned int child;
+    unsigned int max_length = 0;
+    unsigned int k;
+    unsigned int i;
+
+    /* Je innerem Knoten werden die zwei leichtesten Knoten aus den Köpfen 
+     * beider Warteschlangen gewählt, bei gleichem Gewicht das Blatt */
+    for (node = 0; node < n - 1; node++)
+    {
+        weights[node] = 0;
+        for (k = 0; k < 2; k++)
+        {
+            if (next_leaf < n
+                && (next_node >= node
+                    || frequencys[symbols[next_leaf]] <= weights[next_node]))
+            {
+                child = next_leaf;
+                weights[node] += frequencys[symbols[next_leaf]];
+                next_leaf++;
+            }
+            else
+            {
+                child = n + next_node;
+                weights[node] += weights[next_node];
+                next_node++;
+            }
+            parents[child] = node;
+        }
+    }
+
+    /* Die Wurzel ist der zuletzt entstandene Knoten; jeder Elternknoten 
+     * entsteht nach seinen Kindern */
+    depths[n - 2] = 0;
+    for (node = n - 2; node-- > 0; )
+    {
+        depths[node] = (unsigned char) (depths[parents[n + node]] + 1);
+    }
+    for (i = 0; i < n; i++)
+    {
+        lengths[symbols[i]] = (unsigned char) (depths[parents[i]] + 1);
+        if (lengths[symbols[i]] > max_length)
+        {
+            max_length = lengths[symbols[i]];
+        }
+    }
+
+    return max_length;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * Dieses Modul berechnet Codelängen für die Huffman-Kodierung direkt aus den
+ * Häufigkeiten der Zeichen. Mit dem Package-Merge-Verfahren werden optimale
+ * Codelängen ermittelt, die eine vorgegebene Maximallänge nicht
+ * überschreiten. So bleiben die Codes auch bei stark ungleich verteilten
+ * Häufigkeiten (bspw. nach der Fibonacci-Folge) beschränkt. Die 
+ * unbeschränkten Huffman-Codelängen werden ohne Baum und ohne 
+ * Speicheranforderung mit dem Zwei-Warteschlangen-Verfahren bestimmt.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CODELENGTH_H
+#define CODELENGTH_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Größte Maximallänge, die für die Codes vorgegeben werden kann */
+#define CODELENGTH_MAX_LIMIT 56
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Berechnet die Codelängen eines Huffman-Codes ohne Längenbeschränkung. Die
+ * vorkommenden Zeichen werden einmal nach Häufigkeit sortiert und mit zwei 
+ * Warteschlangen, den sortierten Blättern und den in aufsteigender 
+ * Reihenfolge entstehenden inneren Knoten, in linearer Zeit zu einem Baum 
+ * in einem flachen Array zusammengefasst. Bei gleichem Gewicht wird das 
+ * Blatt zuerst gewählt. Kommt nur ein Zeichen vor, erhält es die 
+ * Codelänge 1.
+ *
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @param lengths       Array, in das die Codelängen der #MAX_CHARACTERS
+ *                      Zeichen geschrieben werden, 0 für nicht vorkommende
+ *                      Zeichen
+ * @return              die größte Codelänge
+ */
+extern unsigned int codelength_huffman(const unsigned long long frequencys[],
+                                       unsigned char lengths[]);
+
+/**
+ * Berechnet mit dem Package-Merge-Verfahren optimale Codelängen, die
+ * max_length nicht überschreiten. Ist max_length zu klein, um alle
+ * vorkommenden Zeichen zu codieren, wird die kleinste mögliche Maximallänge
+ * verwendet. Kommt nur ein Zeichen vor, erhält es die Codelänge 1. Halten
+ * die Huffman-Codelängen (siehe codelength_huffman) die Maximallänge 
+ * bereits ein, werden diese ohne Package-Merge übernommen.
+ *
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @param max_length    Maximallänge der Codes, höchstens
+ *                      #CODELENGTH_MAX_LIMIT
+ * @param lengths       Array, in das die Codelängen der #MAX_CHARACTERS
+ *                      Zeichen geschrieben werden, 0 für nicht vorkommende
+ *                      Zeichen
+ */
+extern void codelength_limited(const unsigned long long frequencys[],
+                               unsigned int max_length,
+                               unsigned char lengths[]);
+
+/**
+ * Liefert die größte der übergebenen Codelängen.
+ *
+ * @param lengths   Codelängen der #MAX_CHARACTERS Zeichen
+ * @return          die größte Codelänge
+ */
+extern unsigned int codelength_get_max(const unsigned char lengths[]);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* CODELENGTH_H */
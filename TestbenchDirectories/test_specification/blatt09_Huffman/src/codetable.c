@@ -0,0 +1,540 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "huffman_common.h"
+#include "codetable.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/** Anzahl der Einträge der Primärtabelle */
+#define PRIMARY_SIZE (1u << DECODE_PRIMARY_BITS)
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Zustand beim Dekodieren eines Bitstroms im Speicher
+ */
+typedef struct
+{
+    /** die noch nicht ausgewerteten Bits der Eingabe, linksbündig */
+    unsigned long long bit_buffer;
+
+    /** Anzahl der gültigen Bits im Bitpuffer */
+    int bit_count;
+
+    /** der Bitstrom */
+    const unsigned char *in;
+
+    /** Größe des Bitstroms in Bytes */
+    size_t in_size;
+
+    /** nächstes zu lesendes Byte, ggf. hinter dem Ende des Bitstroms */
+    size_t in_pos;
+
+    /** nächstes zu schreibendes Zeichen */
+    unsigned char *out;
+
+    /** Ende des Speichers für die dekodierten Zeichen */
+    unsigned char *out_end;
+} DECODE_STREAM;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Trägt ein Zeichen für alle Indizes einer (Teil-)Tabelle ein, deren
+ * höchstwertige Bits mit dem Code übereinstimmen.
+ *
+ * @param entries   Anfang der (Teil-)Tabelle
+ * @param index_bits Anzahl der Bits, mit denen die Tabelle indiziert wird
+ * @param bits      Bitfolge des Codes (ohne bereits ausgewertete Bits)
+ * @param length    Länge von bits, höchstens index_bits
+ * @param symbol    einzutragendes Zeichen
+ */
+static void fill_entries(DECODE_ENTRY *entries,
+                         unsigned int index_bits,
+                         unsigned long long bits,
+                         unsigned int length,
+                         unsigned char symbol);
+
+
+/**
+ * Initialisiert den Zustand zum Dekodieren eines Bitstroms.
+ *
+ * @param stream    der zu initialisierende Zustand
+ * @param in        der Bitstrom, beginnend mit dem höchstwertigen Bit
+ * @param in_size   Größe des Bitstroms in Bytes
+ * @param out       Speicher für die dekodierten Zeichen
+ * @param count     Anzahl der zu dekodierenden Zeichen
+ */
+static void stream_init(DECODE_STREAM *stream,
+                        const unsigned char in[], size_t in_size,
+                        unsigned char out[], size_t count);
+
+/**
+ * Füllt den Bitpuffer auf mindestens 57 Bits auf. Hinter dem Ende des 
+ * Bitstroms wird mit 0-Bits aufgefüllt.
+ *
+ * @param stream    der Zustand des Bitstroms
+ */
+static void stream_refill(DECODE_STREAM *stream);
+
+/**
+ * Liefert die Anzahl der Durchläufe, in denen aus jedem Teilstrom ein 
+ * Eintrag dekodiert werden kann, ohne das Ende eines Teilstroms zu 
+ * überschreiten.
+ *
+ * @param streams   die #DECODE_STREAMS Teilströme
+ * @return          Anzahl der Durchläufe
+ */
+static size_t get_rounds(const DECODE_STREAM streams[]);
+
+/**
+ * Dekodiert die restlichen Zeichen eines Bitstroms.
+ *
+ * @param table     die Dekodiertabelle
+ * @param stream    der Zustand des Bitstroms
+ * @return          false, wenn der Bitstrom ungültige Codes enthält oder zu
+ *                  kurz ist, true sonst
+ */
+static bool stream_decode(const DECODE_TABLE *table, DECODE_STREAM *stream);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_table_create
+ * ------------------------------------------------------------------------ */
+extern DECODE_TABLE *decode_table_create(const HUFF_CODE codes[])
+{
+    DECODE_TABLE *table;
+    DECODE_ENTRY *entries;
+    /* Index-Bits der Sekundärtabelle je Präfix der Primärtabelle */
+    unsigned char sub_bits[PRIMARY_SIZE];
+    /* Einzelzeichen-Einträge der Primärtabelle vor dem Zusammenfassen */
+    DECODE_ENTRY single[PRIMARY_SIZE];
+    unsigned int size = PRIMARY_SIZE;
+    unsigned int prefix;
+    unsigned int remaining;
+    unsigned int i;
+    int c;
+
+    memset(sub_bits, 0, sizeof (sub_bits));
+
+    /* Größe der Sekundärtabellen ermitteln: Jeder Präfix, zu dem es Codes
+     * mit mehr als DECODE_PRIMARY_BITS Bits gibt, erhält eine Tabelle, die
+     * den längsten dieser Codes vollständig auflöst. */
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (codes[c].length > DECODE_MAX_CODE_LENGTH)
+        {
+            return NULL;
+        }
+        if (codes[c].length > DECODE_PRIMARY_BITS)
+        {
+            remaining = codes[c].length - DECODE_PRIMARY_BITS;
+            prefix = (unsigned int) (codes[c].bits >> remaining);
+            if (remaining > sub_bits[prefix])
+            {
+                sub_bits[prefix] = (unsigned char) remaining;
+            }
+        }
+    }
+    for (prefix = 0; prefix < PRIMARY_SIZE; prefix++)
+    {
+        if (sub_bits[prefix] > 0)
+        {
+            size += 1u << sub_bits[prefix];
+        }
+    }
+
+    table = (DECODE_TABLE *) malloc(sizeof (DECODE_TABLE));
+    ENSURE_ENOUGH_MEMORY(table, "decode_table_create");
+    entries = (DECODE_ENTRY *) calloc(size, sizeof (DECODE_ENTRY));
+    ENSURE_ENOUGH_MEMORY(entries, "decode_table_create");
+    table->size = size;
+    table->entries = entries;
+
+    /* Verweise auf die Sekundärtabellen eintragen */
+    size = PRIMARY_SIZE;
+    for (prefix = 0; prefix < PRIMARY_SIZE; prefix++)
+    {
+        if (sub_bits[prefix] > 0)
+        {
+            entries[prefix].count = DECODE_LINK;
+            entries[prefix].bits = sub_bits[prefix];
+            entries[prefix].link = size;
+            size += 1u << sub_bits[prefix];
+        }
+    }
+
+    /* Codes in die Primär- bzw. Sekundärtabellen eintragen */
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (codes[c].length == 0)
+        {
+            continue;
+        }
+        if (codes[c].length <= DECODE_PRIMARY_BITS)
+        {
+            fill_entries(entries, DECODE_PRIMARY_BITS,
+                         codes[c].bits, codes[c].length, (unsigned char) c);
+        }
+        else
+        {
+            remaining = codes[c].length - DECODE_PRIMARY_BITS;
+            prefix = (unsigned int) (codes[c].bits >> remaining);
+            fill_entries(entries + entries[prefix].link, sub_bits[prefix],
+                         codes[c].bits & ((1ull << remaining) - 1),
+                         remaining, (unsigned char) c);
+        }
+    }
+
+    /* Lässt ein Eintrag der Primärtabelle nach dem ersten Zeichen noch genug
+     * Bits für einen vollständigen zweiten Code übrig, werden beide Zeichen
+     * in einem Schritt dekodiert. */
+    memcpy(single, entries, sizeof (single));
+    for (i = 0; i < PRIMARY_SIZE; i++)
+    {
+        if (single[i].count == 1 && single[i].bits < DECODE_PRIMARY_BITS)
+        {
+            DECODE_ENTRY *next =
+                    &single[(i << single[i].bits) & (PRIMARY_SIZE - 1)];
+
+            if (next->count == 1
+                && next->bits <= DECODE_PRIMARY_BITS - single[i].bits)
+            {
+                entries[i].symbols[1] = next->symbols[0];
+                entries[i].bits = (unsigned char) (single[i].bits + next->bits);
+                entries[i].count = 2;
+            }
+        }
+    }
+
+    return table;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: fill_entries
+ * ------------------------------------------------------------------------ */
+static void fill_entries(DECODE_ENTRY *entries,
+                         unsigned int index_bits,
+                         unsigned long long bits,
+                         unsigned int length,
+                         unsigned char symbol)
+{
+    unsigned int first = (unsigned int) bits << (index_bits - length);
+    unsigned int last = first + (1u << (index_bits - length));
+    unsigned int i;
+
+    for (i = first; i < last; i++)
+    {
+        entries[i].symbols[0] = symbol;
+        entries[i].bits = (unsigned char) length;
+        entries[i].count = 1;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_table_decode
+ * ------------------------------------------------------------------------ */
+extern bool decode_table_decode(const DECODE_TABLE *table,
+                                const unsigned char in[], size_t in_size,
+                                unsigned char out[], size_t count)
+{
+    DECODE_STREAM stream;
+
+    stream_init(&stream, in, in_size, out, count);
+
+    return stream_decode(table, &stream);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_stream_count
+ * ------------------------------------------------------------------------ */
+extern size_t decode_stream_count(size_t count, unsigned int stream)
+{
+    size_t part = count / DECODE_STREAMS + (count % DECODE_STREAMS != 0);
+    size_t first = part * stream;
+
+    if (first >= count)
+    {
+        return 0;
+    }
+
+    return (count - first < part) ? count - first : part;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_table_decode_streams
+ * ------------------------------------------------------------------------ */
+extern bool decode_table_decode_streams(const DECODE_TABLE *table,
+                                        const unsigned char in[],
+                                        const size_t in_sizes[],
+                                        unsigned char out[], size_t count)
+{
+    DECODE_STREAM streams[DECODE_STREAMS];
+    const DECODE_ENTRY *entry;
+    size_t rounds;
+    bool valid = true;
+    unsigned int k;
+    unsigned int j;
+
+    for (k = 0; k < DECODE_STREAMS; k++)
+    {
+        size_t stream_count = decode_stream_count(count, k);
+
+        stream_init(&streams[k], in, in_sizes[k], out, stream_count);
+        in += in_sizes[k];
+        out += stream_count;
+    }
+
+    /* Solange in jedem Teilstrom Platz für zwei Einträge mit je zwei 
+     * Zeichen ist, werden stets beide Zeichen eines Eintrags geschrieben. 
+     * Ein aufgefüllter Bitpuffer reicht für zwei Codes. */
+    rounds = get_rounds(streams);
+    while (rounds > 0 && valid)
+    {
+        for (; rounds > 0; rounds--)
+        {
+            for (k = 0; k < DECODE_STREAMS; k++)
+            {
+                DECODE_STREAM *stream = &streams[k];
+
+                stream_refill(stream);
+
+                for (j = 0; j < 2; j++)
+                {
+                    entry = &table->entries[stream->bit_buffer 
+                                            >> (64 - DECODE_PRIMARY_BITS)];
+                    if (entry->count == DECODE_LINK)
+                    {
+                        stream->bit_buffer <<= DECODE_PRIMARY_BITS;
+                        stream->bit_count -= DECODE_PRIMARY_BITS;
+                        entry = &table->entries[entry->link 
+                                + (stream->bit_buffer >> (64 - entry->bits))];
+                    }
+                    valid = valid && entry->count != DECODE_INVALID;
+
+                    stream->bit_buffer <<= entry->bits;
+                    stream->bit_count -= entry->bits;
+                    stream->out[0] = entry->symbols[0];
+                    stream->out[1] = entry->symbols[1];
+                    stream->out += (entry->count == 2) ? 2 : 1;
+                }
+            }
+        }
+
+        rounds = get_rounds(streams);
+    }
+
+    /* Die restlichen Zeichen jedes Teilstroms einzeln dekodieren */
+    for (k = 0; k < DECODE_STREAMS && valid; k++)
+    {
+        valid = stream_decode(table, &streams[k]);
+    }
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_table_destroy
+ * ------------------------------------------------------------------------ */
+extern void decode_table_destroy(DECODE_TABLE **table)
+{
+    if (table != NULL && *table != NULL)
+    {
+        free((*table)->entries);
+        free(*table);
+        *table = NULL;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: encode_pair_table_create
+ * ------------------------------------------------------------------------ */
+extern ENCODE_PAIR *encode_pair_table_create(const HUFF_CODE codes[])
+{
+    ENCODE_PAIR *table;
+    ENCODE_PAIR *entry;
+    unsigned int length;
+    int first;
+    int second;
+
+    table = malloc(ENCODE_PAIR_SIZE * sizeof (ENCODE_PAIR));
+    ENSURE_ENOUGH_MEMORY(table, "encode_pair_table_create");
+
+    for (first = 0; first < MAX_CHARACTERS; first++)
+    {
+        entry = table + first * MAX_CHARACTERS;
+        for (second = 0; second < MAX_CHARACTERS; second++, entry++)
+        {
+            length = (unsigned int) codes[first].length + codes[second].length;
+            if (length <= ENCODE_PAIR_MAX_BITS)
+            {
+                entry->bits = (unsigned int) ((codes[first].bits 
+                                               << codes[second].length)
+                                              | codes[second].bits);
+                entry->length = (unsigned char) length;
+            }
+            else
+            {
+                entry->bits = 0;
+                entry->length = 0;
+            }
+        }
+    }
+
+    return table;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: encode_pair_table_destroy
+ * ------------------------------------------------------------------------ */
+extern void encode_pair_table_destroy(ENCODE_PAIR **table)
+{
+    if (table != NULL && *table != NULL)
+    {
+        free(*table);
+        *table = NULL;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: stream_init
+ * ------------------------------------------------------------------------ */
+static void stream_init(DECODE_STREAM *stream,
+                        const unsigned char in[], size_t in_size,
+                        unsigned char out[], size_t count)
+{
+    stream->bit_buffer = 0;
+    stream->bit_count = 0;
+    stream->in = in;
+    stream->in_size = in_size;
+    stream->in_pos = 0;
+    stream->out = out;
+    stream->out_end = out + count;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: stream_refill
+ * ------------------------------------------------------------------------ */
+static void stream_refill(DECODE_STREAM *stream)
+{
+    const unsigned char *in = stream->in + stream->in_pos;
+
+    if (stream->in_pos + 8 <= stream->in_size)
+    {
+        /* Ganzes Wort lesen, davon die ganzen Bytes übernehmen, die in den
+         * Bitpuffer passen */
+        unsigned long long word = (unsigned long long) in[0] << 56
+                | (unsigned long long) in[1] << 48
+                | (unsigned long long) in[2] << 40
+                | (unsigned long long) in[3] << 32
+                | (unsigned long long) in[4] << 24
+                | (unsigned long long) in[5] << 16
+                | (unsigned long long) in[6] << 8
+                | (unsigned long long) in[7];
+
+        stream->bit_buffer |= word >> stream->bit_count;
+        stream->in_pos += (size_t) ((63 - stream->bit_count) >> 3);
+        stream->bit_count |= 56;
+        return;
+    }
+
+    while (stream->bit_count <= 56)
+    {
+        if (stream->in_pos < stream->in_size)
+        {
+            stream->bit_buffer |= (unsigned long long) 
+                    stream->in[stream->in_pos] << (56 - stream->bit_count);
+        }
+        stream->in_pos++;
+        stream->bit_count += 8;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: get_rounds
+ * ------------------------------------------------------------------------ */
+static size_t get_rounds(const DECODE_STREAM streams[])
+{
+    size_t rounds = (size_t) -1;
+    size_t remaining;
+    unsigned int k;
+
+    /* Ein Durchlauf dekodiert zwei Einträge mit höchstens zwei Zeichen */
+    for (k = 0; k < DECODE_STREAMS; k++)
+    {
+        remaining = (size_t) (streams[k].out_end - streams[k].out) / 4;
+        rounds = (remaining < rounds) ? remaining : rounds;
+    }
+
+    return rounds;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: stream_decode
+ * ------------------------------------------------------------------------ */
+static bool stream_decode(const DECODE_TABLE *table, DECODE_STREAM *stream)
+{
+    const DECODE_ENTRY *entry;
+
+    while (stream->out < stream->out_end)
+    {
+        stream_refill(stream);
+
+        entry = &table->entries[stream->bit_buffer 
+                                >> (64 - DECODE_PRIMARY_BITS)];
+
+        if (entry->count == DECODE_LINK)
+        {
+            stream->bit_buffer <<= DECODE_PRIMARY_BITS;
+            stream->bit_count -= DECODE_PRIMARY_BITS;
+            entry = &table->entries[entry->link
+                    + (stream->bit_buffer >> (64 - entry->bits))];
+        }
+
+        if (entry->count == DECODE_INVALID)
+        {
+            return false;
+        }
+
+        stream->bit_buffer <<= entry->bits;
+        stream->bit_count -= entry->bits;
+
+        *stream->out++ = entry->symbols[0];
+        if (entry->count == 2 && stream->out < stream->out_end)
+        {
+            *stream->out++ = entry->symbols[1];
+        }
+    }
+
+    /* Verbrauchte Bits mit der Länge der Eingabe vergleichen. Ein letzter
+     * Eintrag mit zwei Zeichen darf in die aufgefüllten Bits reichen. */
+    return (stream->in_pos * 8 - (size_t) stream->bit_count) 
+           <= stream->in_size * 8 + DECODE_PRIMARY_BITS;
+}
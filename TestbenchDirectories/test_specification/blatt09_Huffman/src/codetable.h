@@ -0,0 +1,227 @@
+/**
+ * @file
+ * Dieses Modul erzeugt aus den Codes der einzelnen Zeichen, die die Module
+ * hufftree und canonical liefern, eine Dekodiertabelle. Die Codes werden als
+ * Paare aus Bitfolge und Länge abgelegt, so dass die Komprimierung jeden 
+ * Code mit einem Aufruf von write_bits schreiben kann. Mit der Dekodiertabelle kann
+ * die Dekomprimierung mehrere Bits auf einmal auswerten, statt den Baum
+ * bitweise zu durchlaufen.
+ *
+ * Die Dekodiertabelle besteht aus einer Primärtabelle, die mit den nächsten
+ * #DECODE_PRIMARY_BITS Bits des Eingabestroms indiziert wird. Ein Eintrag
+ * der Primärtabelle liefert entweder ein oder zwei vollständig dekodierte
+ * Zeichen oder verweist auf eine Sekundärtabelle für längere Codes.
+ *
+ * Für die Komprimierung kann zusätzlich eine Paartabelle erzeugt werden, 
+ * die für jedes der 65536 Zeichenpaare die aneinandergehängten Codes 
+ * beider Zeichen enthält, sofern sie zusammen höchstens 
+ * #ENCODE_PAIR_MAX_BITS Bits lang sind. Der Kodierer schreibt damit je 
+ * Schritt zwei Zeichen mit einem Aufruf von write_bits.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CODETABLE_H
+#define CODETABLE_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Anzahl der Bits, mit denen die Primärtabelle indiziert wird */
+#define DECODE_PRIMARY_BITS 11
+
+/** Maximale Anzahl der Bits, mit denen eine Sekundärtabelle indiziert wird */
+#define DECODE_SECONDARY_BITS 13
+
+/** Maximale Codelänge, die mit der Dekodiertabelle aufgelöst werden kann */
+#define DECODE_MAX_CODE_LENGTH (DECODE_PRIMARY_BITS + DECODE_SECONDARY_BITS)
+
+/**
+ * Anzahl der Teilströme, in die ein Bitstrom für decode_table_decode_streams
+ * aufgeteilt wird
+ */
+#define DECODE_STREAMS 4
+
+/** Art eines Tabelleneintrags: Bitfolge ist keinem Code zugeordnet */
+#define DECODE_INVALID 0
+
+/** Art eines Tabelleneintrags: Verweis auf eine Sekundärtabelle */
+#define DECODE_LINK 3
+
+/** Anzahl der Einträge der Paartabelle, eines je Zeichenpaar */
+#define ENCODE_PAIR_SIZE (MAX_CHARACTERS * MAX_CHARACTERS)
+
+/** Maximale Länge der aneinandergehängten Codes eines Zeichenpaars */
+#define ENCODE_PAIR_MAX_BITS 32
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Huffman-Code eines Zeichens. Die Bits des Codes stehen rechtsbündig in
+ * bits, das erste Bit des Codes ist das höchstwertige der length Bits. Ein
+ * Code ist damit höchstens 64 Bits lang; bei Häufigkeiten mit 32 Bit 
+ * entstehen höchstens etwa 46 Bits lange Codes.
+ */
+typedef struct
+{
+    /** Bitfolge des Codes */
+    unsigned long long bits;
+
+    /** Anzahl der Bits des Codes, 0 wenn das Zeichen nicht vorkommt */
+    unsigned char length;
+} HUFF_CODE;
+
+/**
+ * Eintrag der Paartabelle mit den aneinandergehängten Codes zweier Zeichen
+ */
+typedef struct
+{
+    /** Bitfolge des ersten Codes, gefolgt von der des zweiten */
+    unsigned int bits;
+
+    /** Anzahl der Bits beider Codes, 0 wenn sie zu lang sind */
+    unsigned char length;
+} ENCODE_PAIR;
+
+/**
+ * Eintrag der Dekodiertabelle
+ */
+typedef struct
+{
+    /** Index der Sekundärtabelle, falls count gleich #DECODE_LINK ist */
+    unsigned int link;
+
+    /** Die dekodierten Zeichen */
+    unsigned char symbols[2];
+
+    /**
+     * Anzahl der Bits, die durch den Eintrag verbraucht werden, bzw. Anzahl
+     * der Bits, mit denen die Sekundärtabelle indiziert wird
+     */
+    unsigned char bits;
+
+    /** Anzahl dekodierter Zeichen (1, 2), #DECODE_LINK oder #DECODE_INVALID */
+    unsigned char count;
+} DECODE_ENTRY;
+
+/**
+ * Dekodiertabelle, deren erste 2^#DECODE_PRIMARY_BITS Einträge die
+ * Primärtabelle bilden. Daran schließen sich die Sekundärtabellen an.
+ */
+typedef struct
+{
+    /** Anzahl der Einträge */
+    unsigned int size;
+
+    /** Primär- und Sekundärtabellen */
+    DECODE_ENTRY *entries;
+} DECODE_TABLE;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Erzeugt aus den Codes der Zeichen eine Dekodiertabelle.
+ *
+ * @param codes Array mit den Codes der #MAX_CHARACTERS Zeichen
+ * @return      die erzeugte Dekodiertabelle oder NULL, wenn ein Code länger
+ *              als #DECODE_MAX_CODE_LENGTH ist. Der Aufrufer muss die
+ *              Tabelle mit decode_table_destroy wieder freigeben.
+ */
+extern DECODE_TABLE *decode_table_create(const HUFF_CODE codes[]);
+
+/**
+ * Dekodiert count Zeichen aus einem im Speicher liegenden Bitstrom. Die
+ * Funktion verwendet keine globalen Daten und kann daher von mehreren
+ * Threads gleichzeitig aufgerufen werden.
+ *
+ * @param table     die Dekodiertabelle
+ * @param in        der Bitstrom, beginnend mit dem höchstwertigen Bit
+ * @param in_size   Größe des Bitstroms in Bytes
+ * @param out       Speicher für die count dekodierten Zeichen
+ * @param count     Anzahl der zu dekodierenden Zeichen
+ * @return          false, wenn der Bitstrom ungültige Codes enthält oder zu
+ *                  kurz ist, true sonst
+ */
+extern bool decode_table_decode(const DECODE_TABLE *table,
+                                const unsigned char in[], size_t in_size,
+                                unsigned char out[], size_t count);
+
+/**
+ * Liefert die Anzahl der Zeichen eines Teilstroms, wenn count Zeichen auf 
+ * #DECODE_STREAMS Teilströme aufgeteilt werden. Jeder Teilstrom kodiert einen
+ * zusammenhängenden Abschnitt von (count + 3) / 4 Zeichen, der letzte ggf.
+ * weniger.
+ *
+ * @param count     Anzahl aller Zeichen
+ * @param stream    Nummer des Teilstroms
+ * @return          Anzahl der Zeichen des Teilstroms
+ */
+extern size_t decode_stream_count(size_t count, unsigned int stream);
+
+/**
+ * Dekodiert count Zeichen aus #DECODE_STREAMS hintereinander im Speicher
+ * liegenden Teilströmen, die gemäß decode_stream_count aufgeteilt sind. Je 
+ * Schleifendurchlauf wird aus jedem Teilstrom ein Eintrag dekodiert; da 
+ * diese Schritte nicht voneinander abhängen, kann der Prozessor sie 
+ * überlappend ausführen. Die Funktion verwendet keine globalen Daten.
+ *
+ * @param table     die Dekodiertabelle
+ * @param in        die Teilströme, jeweils auf ganze Bytes aufgefüllt
+ * @param in_sizes  Größen der Teilströme in Bytes
+ * @param out       Speicher für die count dekodierten Zeichen
+ * @param count     Anzahl der zu dekodierenden Zeichen
+ * @return          false, wenn ein Teilstrom ungültige Codes enthält oder zu
+ *                  kurz ist, true sonst
+ */
+extern bool decode_table_decode_streams(const DECODE_TABLE *table,
+                                        const unsigned char in[],
+                                        const size_t in_sizes[],
+                                        unsigned char out[], size_t count);
+
+/**
+ * Gibt die übergebene Dekodiertabelle frei und setzt den Zeiger auf NULL.
+ *
+ * @param table die freizugebende Dekodiertabelle
+ */
+extern void decode_table_destroy(DECODE_TABLE **table);
+
+/**
+ * Erzeugt aus den Codes der Zeichen die Paartabelle mit #ENCODE_PAIR_SIZE
+ * Einträgen. Der Eintrag für das Zeichen a gefolgt von b steht an Index
+ * a * #MAX_CHARACTERS + b. Ist ein Paar länger als #ENCODE_PAIR_MAX_BITS
+ * Bits, hat sein Eintrag die Länge 0 und der Kodierer schreibt beide 
+ * Codes einzeln.
+ *
+ * @param codes Array mit den Codes der #MAX_CHARACTERS Zeichen
+ * @return      die erzeugte Paartabelle, die der Aufrufer mit 
+ *              encode_pair_table_destroy wieder freigeben muss
+ */
+extern ENCODE_PAIR *encode_pair_table_create(const HUFF_CODE codes[]);
+
+/**
+ * Gibt die übergebene Paartabelle frei und setzt den Zeiger auf NULL.
+ *
+ * @param table die freizugebende Paartabelle
+ */
+extern void encode_pair_table_destroy(ENCODE_PAIR **table);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* CODETABLE_H */
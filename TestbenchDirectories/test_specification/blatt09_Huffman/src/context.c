@@ -0,0 +1,768 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#include "huffman_common.h"
+#include "io.h"
+#include "codetable.h"
+#include "canonical.h"
+#include "codelength.h"
+#include "profile.h"
+#include "context.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+/** Bits eines Eintrags der Kontextzuordnung im Header */
+#define CONTEXT_MAP_ENTRY_BITS 16
+
+/** Maximale Anzahl der Runden, in denen die Kontexte neu zugeordnet werden */
+#define CONTEXT_REFINE_ROUNDS 4
+
+/** Anzahl der Einträge einer Schnelltabelle */
+#define CONTEXT_FAST_SIZE (1u << CONTEXT_FAST_BITS)
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Häufigkeiten je Kontext und deren Zuordnung zu den Codetabellen
+ */
+typedef struct
+{
+    /** Häufigkeiten der Zeichen je Kontext, [Kontext][Zeichen] */
+    unsigned long long (*frequencys)[MAX_CHARACTERS];
+
+    /** Anzahl der Zeichen je Kontext */
+    unsigned long long totals[MAX_CHARACTERS];
+
+    /** die in einem Kontext vorkommenden Zeichen und deren Anzahl */
+    unsigned char symbols[MAX_CHARACTERS][MAX_CHARACTERS];
+    unsigned int symbol_counts[MAX_CHARACTERS];
+
+    /** Nummer der Codetabelle je Kontext */
+    unsigned char table_of[MAX_CHARACTERS];
+
+    /** Anzahl der Codetabellen */
+    unsigned int table_count;
+
+    /** zusammengefasste Häufigkeiten je Codetabelle, [Tabelle][Zeichen] */
+    unsigned long long (*table_frequencys)[MAX_CHARACTERS];
+
+    /** Codelängen je Codetabelle, [Tabelle][Zeichen] */
+    unsigned char (*lengths)[MAX_CHARACTERS];
+} CONTEXT_MODEL;
+
+/**
+ * Codetabelle des Dekodierers. Ein Eintrag der Schnelltabelle enthält das
+ * Zeichen im niederwertigen und die Codelänge im höherwertigen Byte; 0
+ * steht für einen Code, der länger als #CONTEXT_FAST_BITS ist oder nicht
+ * existiert. Die kleine Schnelltabelle bleibt auch beim Wechsel der 
+ * Tabelle mit jedem Zeichen im Cache.
+ */
+typedef struct
+{
+    /** kanonischer Code für Codes länger als #DECODE_MAX_CODE_LENGTH */
+    CANONICAL_CODE canon;
+
+    /** Dekodiertabelle für lange Codes oder NULL, wenn Codes zu lang für 
+     * sie sind */
+    DECODE_TABLE *table;
+
+    /** Schnelltabelle, indiziert mit den nächsten #CONTEXT_FAST_BITS Bits */
+    unsigned short fast[CONTEXT_FAST_SIZE];
+} CONTEXT_DECODER;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Zählt die Häufigkeiten der Zeichen je Kontext.
+ *
+ * @param data      die zu zählenden Zeichen
+ * @param size      Anzahl der Zeichen
+ * @param model     das Modell, dessen Häufigkeiten gefüllt werden
+ */
+static void count_contexts(const unsigned char data[], size_t size,
+                           CONTEXT_MODEL *model);
+
+/**
+ * Schätzt die Anzahl der Bits, die eine eigene Codetabelle für die
+ * übergebenen Häufigkeiten einschließlich ihres Headers kostet.
+ *
+ * @param frequencys        Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @param max_code_length   maximale Codelänge
+ * @return                  Bits der kodierten Zeichen und des Headers
+ */
+static unsigned long long estimate_bits(const unsigned long long frequencys[],
+                                        unsigned int max_code_length);
+
+/**
+ * Löst die häufigsten Kontexte aus der gemeinsamen Tabelle 0 heraus, solange
+ * sich eine eigene Tabelle lohnt.
+ *
+ * @param model             das Modell
+ * @param max_code_length   maximale Codelänge
+ */
+static void split_contexts(CONTEXT_MODEL *model, unsigned int max_code_length);
+
+/**
+ * Ordnet jeden Kontext der Tabelle zu, deren Codes ihn am kürzesten
+ * kodieren, und entfernt danach unbenutzte Tabellen.
+ *
+ * @param model             das Modell
+ * @param max_code_length   maximale Codelänge
+ */
+static void refine_contexts(CONTEXT_MODEL *model, unsigned int max_code_length);
+
+/**
+ * Berechnet die Codelängen aller Tabellen aus den zusammengefassten
+ * Häufigkeiten ihrer Kontexte.
+ *
+ * @param model             das Modell
+ * @param max_code_length   maximale Codelänge
+ */
+static void compute_lengths(CONTEXT_MODEL *model, unsigned int max_code_length);
+
+/**
+ * Liefert die Anzahl der Bits, mit denen die Zeichen eines Kontexts in
+ * einer Tabelle kodiert werden.
+ *
+ * @param model     das Modell
+ * @param context   der Kontext
+ * @param table     die Tabelle
+ * @return          die Anzahl der Bits oder ULLONG_MAX, wenn die Tabelle
+ *                  nicht alle Zeichen des Kontexts enthält
+ */
+static unsigned long long context_cost(const CONTEXT_MODEL *model,
+                                       unsigned int context,
+                                       unsigned int table);
+
+/**
+ * Schreibt die Kontextzuordnung und die Codelängen aller Tabellen in den
+ * Ausgabestrom und liefert die Codes je Kontext.
+ *
+ * @param model     das Modell
+ * @param codes     Speicher für die Codes je Tabelle
+ */
+static void write_tables(const CONTEXT_MODEL *model,
+                         HUFF_CODE codes[][MAX_CHARACTERS]);
+
+/**
+ * Füllt die Schnelltabelle eines Dekodierers aus dessen kanonischem Code
+ * und erzeugt seine Dekodiertabelle.
+ *
+ * @param decoder   der Dekodierer
+ */
+static void build_fast_table(CONTEXT_DECODER *decoder);
+
+/**
+ * Dekodiert den Bitstrom und schreibt die Zeichen in den Ausgabestrom.
+ *
+ * @param decoders      die Dekodierer je Kontext
+ * @param in            der Bitstrom
+ * @param in_size       Größe des Bitstroms in Bytes
+ * @param count         Anzahl der zu dekodierenden Zeichen
+ * @return              false, wenn der Bitstrom ungültige Codes enthält
+ *                      oder zu kurz ist, true sonst
+ */
+static bool decode_contexts(const CONTEXT_DECODER *const decoders[],
+                            const unsigned char in[], size_t in_size,
+                            unsigned long long count);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: context_compress
+ * ------------------------------------------------------------------------ */
+extern void context_compress(const unsigned char data[], size_t size,
+                             unsigned int max_code_length)
+{
+    CONTEXT_MODEL *model;
+    HUFF_CODE (*codes)[MAX_CHARACTERS];
+    /* Codes je Kontext, über die Tabelle des Kontexts */
+    const HUFF_CODE *context_codes[MAX_CHARACTERS];
+    BITWRITER *writer = get_outfile_writer();
+    const HUFF_CODE *code;
+    unsigned char previous = 0;
+    size_t i;
+    int c;
+
+    model = (CONTEXT_MODEL *) calloc(1, sizeof (CONTEXT_MODEL));
+    ENSURE_ENOUGH_MEMORY(model, "context_compress");
+    model->frequencys = calloc(MAX_CHARACTERS, sizeof (*model->frequencys));
+    ENSURE_ENOUGH_MEMORY(model->frequencys, "context_compress");
+    model->table_frequencys = malloc(CONTEXT_MAX_TABLES
+                                     * sizeof (*model->table_frequencys));
+    ENSURE_ENOUGH_MEMORY(model->table_frequencys, "context_compress");
+    model->lengths = malloc(CONTEXT_MAX_TABLES * sizeof (*model->lengths));
+    ENSURE_ENOUGH_MEMORY(model->lengths, "context_compress");
+
+    profile_begin(PROFILE_COUNT);
+    count_contexts(data, size, model);
+    profile_end();
+
+    profile_begin(PROFILE_TREE);
+    split_contexts(model, max_code_length);
+    refine_contexts(model, max_code_length);
+    profile_end();
+
+    profile_begin(PROFILE_HEADER);
+    codes = malloc(model->table_count * sizeof (*codes));
+    ENSURE_ENOUGH_MEMORY(codes, "context_compress");
+    write_varint(size);
+    write_tables(model, codes);
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        context_codes[c] = codes[model->table_of[c]];
+    }
+    profile_end();
+
+    profile_begin(PROFILE_CODING);
+    for (i = 0; i < size; i++)
+    {
+        code = &context_codes[previous][data[i]];
+        bitwriter_write_bits(writer, code->bits, code->length);
+        previous = data[i];
+    }
+    profile_end();
+
+    free(codes);
+    free(model->lengths);
+    free(model->table_frequencys);
+    free(model->frequencys);
+    free(model);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: count_contexts
+ * ------------------------------------------------------------------------ */
+static void count_contexts(const unsigned char data[], size_t size,
+                           CONTEXT_MODEL *model)
+{
+    unsigned char previous = 0;
+    size_t i;
+    int context;
+    int c;
+
+    for (i = 0; i < size; i++)
+    {
+        model->frequencys[previous][data[i]]++;
+        previous = data[i];
+    }
+
+    for (context = 0; context < MAX_CHARACTERS; context++)
+    {
+        for (c = 0; c < MAX_CHARACTERS; c++)
+        {
+            if (model->frequencys[context][c] > 0)
+            {
+                model->totals[context] += model->frequencys[context][c];
+                model->symbols[context][model->symbol_counts[context]++] =
+                        (unsigned char) c;
+            }
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: estimate_bits
+ * ------------------------------------------------------------------------ */
+static unsigned long long estimate_bits(const unsigned long long frequencys[],
+                                        unsigned int max_code_length)
+{
+    unsigned char lengths[MAX_CHARACTERS];
+    unsigned long long bits = 0;
+    unsigned int symbols = 0;
+    unsigned int max_length = 0;
+    int c;
+
+    codelength_limited(frequencys, max_code_length, lengths);
+
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (lengths[c] > 0)
+        {
+            bits += frequencys[c] * lengths[c];
+            symbols++;
+            if (lengths[c] > max_length)
+            {
+                max_length = lengths[c];
+            }
+        }
+    }
+
+    /* Header im Format des Moduls canonical: Maximallänge, eine Anzahl je
+     * Codelänge (meist ein Byte) und die Zeichen */
+    return bits + 8 * (1 + max_length + symbols);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: split_contexts
+ * ------------------------------------------------------------------------ */
+static void split_contexts(CONTEXT_MODEL *model, unsigned int max_code_length)
+{
+    unsigned long long shared[MAX_CHARACTERS];
+    unsigned long long rest[MAX_CHARACTERS];
+    unsigned long long shared_bits;
+    unsigned long long rest_bits;
+    unsigned long long own_bits;
+    /* Kontexte absteigend nach ihrer Anzahl an Zeichen */
+    unsigned char order[MAX_CHARACTERS];
+    unsigned char swap;
+    int context;
+    int c;
+    int k;
+
+    memset(shared, 0, sizeof (shared));
+    for (context = 0; context < MAX_CHARACTERS; context++)
+    {
+        for (c = 0; c < MAX_CHARACTERS; c++)
+        {
+            shared[c] += model->frequencys[context][c];
+        }
+
+        /* Einfügen in die sortierte Reihenfolge */
+        order[context] = (unsigned char) context;
+        for (k = context; k > 0 && model->totals[order[k]]
+                                   > model->totals[order[k - 1]]; k--)
+        {
+            swap = order[k];
+            order[k] = order[k - 1];
+            order[k - 1] = swap;
+        }
+    }
+    shared_bits = estimate_bits(shared, max_code_length);
+
+    model->table_count = 1;
+    memset(model->table_of, 0, sizeof (model->table_of));
+
+    for (k = 0; k < MAX_CHARACTERS && model->totals[order[k]] > 0
+                && model->table_count < CONTEXT_MAX_TABLES; k++)
+    {
+        context = order[k];
+        for (c = 0; c < MAX_CHARACTERS; c++)
+        {
+            rest[c] = shared[c] - model->frequencys[context][c];
+        }
+        own_bits = estimate_bits(model->frequencys[context], max_code_length)
+                   + CONTEXT_MAP_ENTRY_BITS;
+        rest_bits = estimate_bits(rest, max_code_length);
+
+        if (own_bits + rest_bits < shared_bits)
+        {
+            model->table_of[context] = (unsigned char) model->table_count++;
+            memcpy(shared, rest, sizeof (shared));
+            shared_bits = rest_bits;
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: refine_contexts
+ * ------------------------------------------------------------------------ */
+static void refine_contexts(CONTEXT_MODEL *model, unsigned int max_code_length)
+{
+    /* neue Nummern der Tabellen nach dem Entfernen unbenutzter Tabellen */
+    unsigned int renumber[CONTEXT_MAX_TABLES];
+    bool used[CONTEXT_MAX_TABLES];
+    unsigned long long best_bits;
+    unsigned long long bits;
+    unsigned int best_table;
+    unsigned int table;
+    unsigned int round;
+    unsigned int count;
+    bool changed = true;
+    int context;
+
+    for (round = 0; round < CONTEXT_REFINE_ROUNDS && changed
+                    && model->table_count > 1; round++)
+    {
+        compute_lengths(model, max_code_length);
+        changed = false;
+
+        for (context = 0; context < MAX_CHARACTERS; context++)
+        {
+            if (model->totals[context] == 0)
+            {
+                continue;
+            }
+
+            best_table = model->table_of[context];
+            best_bits = context_cost(model, (unsigned int) context,
+                                     best_table);
+            for (table = 0; table < model->table_count; table++)
+            {
+                bits = context_cost(model, (unsigned int) context, table);
+                if (bits < best_bits)
+                {
+                    best_bits = bits;
+                    best_table = table;
+                }
+            }
+
+            if (best_table != model->table_of[context])
+            {
+                model->table_of[context] = (unsigned char) best_table;
+                changed = true;
+            }
+        }
+    }
+
+    /* Tabelle 0 bleibt immer erhalten, andere nur mit Kontexten */
+    memset(used, 0, sizeof (used));
+    used[0] = true;
+    for (context = 0; context < MAX_CHARACTERS; context++)
+    {
+        if (model->totals[context] > 0)
+        {
+            used[model->table_of[context]] = true;
+        }
+    }
+    count = 0;
+    for (table = 0; table < model->table_count; table++)
+    {
+        renumber[table] = used[table] ? count++ : 0;
+    }
+    for (context = 0; context < MAX_CHARACTERS; context++)
+    {
+        model->table_of[context] = (model->totals[context] > 0)
+                ? (unsigned char) renumber[model->table_of[context]]
+                : 0;
+    }
+    model->table_count = count;
+
+    compute_lengths(model, max_code_length);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: compute_lengths
+ * ------------------------------------------------------------------------ */
+static void compute_lengths(CONTEXT_MODEL *model, unsigned int max_code_length)
+{
+    unsigned int table;
+    int context;
+    int c;
+
+    memset(model->table_frequencys, 0,
+           model->table_count * sizeof (*model->table_frequencys));
+
+    for (context = 0; context < MAX_CHARACTERS; context++)
+    {
+        table = model->table_of[context];
+        for (c = 0; c < MAX_CHARACTERS; c++)
+        {
+            model->table_frequencys[table][c] += model->frequencys[context][c];
+        }
+    }
+
+    for (table = 0; table < model->table_count; table++)
+    {
+        codelength_limited(model->table_frequencys[table], max_code_length,
+                           model->lengths[table]);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: context_cost
+ * ------------------------------------------------------------------------ */
+static unsigned long long context_cost(const CONTEXT_MODEL *model,
+                                       unsigned int context,
+                                       unsigned int table)
+{
+    const unsigned char *lengths = model->lengths[table];
+    unsigned long long bits = (table != 0) ? CONTEXT_MAP_ENTRY_BITS : 0;
+    unsigned char c;
+    unsigned int k;
+
+    for (k = 0; k < model->symbol_counts[context]; k++)
+    {
+        c = model->symbols[context][k];
+        if (lengths[c] == 0)
+        {
+            return ULLONG_MAX;
+        }
+        bits += model->frequencys[context][c] * lengths[c];
+    }
+
+    return bits;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: write_tables
+ * ------------------------------------------------------------------------ */
+static void write_tables(const CONTEXT_MODEL *model,
+                         HUFF_CODE codes[][MAX_CHARACTERS])
+{
+    CANONICAL_CODE canon;
+    unsigned int pairs = 0;
+    unsigned int table;
+    int context;
+
+    write_varint(model->table_count);
+
+    for (context = 0; context < MAX_CHARACTERS; context++)
+    {
+        if (model->table_of[context] != 0)
+        {
+            pairs++;
+        }
+    }
+    write_varint(pairs);
+    for (context = 0; context < MAX_CHARACTERS; context++)
+    {
+        if (model->table_of[context] != 0)
+        {
+            write_char((unsigned char) context);
+            write_char(model->table_of[context]);
+        }
+    }
+
+    for (table = 0; table < model->table_count; table++)
+    {
+        (void) canonical_create(model->lengths[table], &canon);
+        canonical_write_header(&canon);
+        canonical_get_codes(&canon, codes[table]);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: context_decompress
+ * ------------------------------------------------------------------------ */
+extern bool context_decompress(const unsigned char data[], size_t size)
+{
+    unsigned long long all_characters = 0;
+    unsigned long long table_count = 0;
+    unsigned long long pairs = 0;
+    unsigned char table_of[MAX_CHARACTERS];
+    CONTEXT_DECODER *tables;
+    const CONTEXT_DECODER *decoders[MAX_CHARACTERS];
+    size_t pos = 0;
+    size_t used;
+    unsigned int table;
+    unsigned int k;
+    int context;
+    bool valid;
+
+    profile_begin(PROFILE_HEADER);
+    used = load_varint(data, size, &all_characters);
+    pos += used;
+    if (used > 0)
+    {
+        used = load_varint(data + pos, size - pos, &table_count);
+        pos += used;
+    }
+    if (used > 0)
+    {
+        used = load_varint(data + pos, size - pos, &pairs);
+        pos += used;
+    }
+    if (used == 0 || table_count == 0 || table_count > CONTEXT_MAX_TABLES
+        || pairs > MAX_CHARACTERS || size - pos < 2 * pairs)
+    {
+        profile_end();
+        return false;
+    }
+
+    memset(table_of, 0, sizeof (table_of));
+    for (k = 0; k < pairs; k++)
+    {
+        table_of[data[pos]] = data[pos + 1];
+        if (data[pos + 1] >= table_count)
+        {
+            profile_end();
+            return false;
+        }
+        pos += 2;
+    }
+
+    tables = (CONTEXT_DECODER *) malloc((size_t) table_count
+                                        * sizeof (CONTEXT_DECODER));
+    ENSURE_ENOUGH_MEMORY(tables, "context_decompress");
+    for (table = 0; table < table_count; table++)
+    {
+        used = canonical_load_header(&tables[table].canon, data + pos,
+                                     size - pos);
+        if (used == 0)
+        {
+            free(tables);
+            profile_end();
+            return false;
+        }
+        pos += used;
+    }
+    profile_end();
+
+    profile_begin(PROFILE_CODES);
+    for (table = 0; table < table_count; table++)
+    {
+        build_fast_table(&tables[table]);
+    }
+    for (context = 0; context < MAX_CHARACTERS; context++)
+    {
+        decoders[context] = &tables[table_of[context]];
+    }
+    profile_end();
+
+    profile_begin(PROFILE_CODING);
+    valid = decode_contexts(decoders, data + pos, size - pos, all_characters);
+    profile_end();
+
+    for (table = 0; table < table_count; table++)
+    {
+        decode_table_destroy(&tables[table].table);
+    }
+    free(tables);
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: build_fast_table
+ * ------------------------------------------------------------------------ */
+static void build_fast_table(CONTEXT_DECODER *decoder)
+{
+    HUFF_CODE codes[MAX_CHARACTERS];
+    unsigned int first;
+    unsigned int count;
+    unsigned int i;
+    int c;
+
+    memset(decoder->fast, 0, sizeof (decoder->fast));
+    canonical_get_codes(&decoder->canon, codes);
+
+    /* Ein Code der Länge l belegt alle 2^(FAST_BITS - l) Einträge, deren
+     * führende Bits er bildet */
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (codes[c].length > 0 && codes[c].length <= CONTEXT_FAST_BITS)
+        {
+            first = (unsigned int) codes[c].bits
+                    << (CONTEXT_FAST_BITS - codes[c].length);
+            count = 1u << (CONTEXT_FAST_BITS - codes[c].length);
+            for (i = 0; i < count; i++)
+            {
+                decoder->fast[first + i] = (unsigned short)
+                        (c | (codes[c].length << 8));
+            }
+        }
+    }
+
+    decoder->table = decode_table_create(codes);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_contexts
+ * ------------------------------------------------------------------------ */
+static bool decode_contexts(const CONTEXT_DECODER *const decoders[],
+                            const unsigned char in[], size_t in_size,
+                            unsigned long long count)
+{
+    /* Die noch nicht ausgewerteten Bits der Eingabe, linksbündig */
+    unsigned long long bit_buffer = 0;
+    /* Anzahl der gültigen Bits im Bitpuffer */
+    int bit_count = 0;
+    /* Position des nächsten Bytes der Eingabe, darf nach dem Ende mit
+     * 0-Bits weiterlaufen */
+    size_t in_pos = 0;
+    const CONTEXT_DECODER *decoder = decoders[0];
+    const DECODE_ENTRY *table_entry;
+    unsigned int entry;
+    unsigned int length;
+    unsigned char symbol = 0;
+    unsigned char out[IO_BUFFER_SIZE];
+    size_t out_pos = 0;
+
+    while (count > 0)
+    {
+        while (bit_count <= 56)
+        {
+            if (in_pos < in_size)
+            {
+                bit_buffer |= (unsigned long long) in[in_pos]
+                              << (56 - bit_count);
+            }
+            else if (in_pos >= in_size + 8)
+            {
+                /* Der Bitpuffer enthält nur noch aufgefüllte Bits */
+                return false;
+            }
+            in_pos++;
+            bit_count += 8;
+        }
+
+        entry = decoder->fast[bit_buffer >> (64 - CONTEXT_FAST_BITS)];
+        if (entry != 0)
+        {
+            symbol = (unsigned char) entry;
+            length = entry >> 8;
+        }
+        else if (decoder->table != NULL)
+        {
+            /* Ein Eintrag mit zwei Zeichen kommt hier nicht vor, da das 
+             * erste Zeichen dann in der Schnelltabelle stünde */
+            length = 0;
+            table_entry = &decoder->table->entries[bit_buffer 
+                                                   >> (64 - DECODE_PRIMARY_BITS)];
+            if (table_entry->count == DECODE_LINK)
+            {
+                length = DECODE_PRIMARY_BITS;
+                table_entry = &decoder->table->entries[table_entry->link 
+                        + ((bit_buffer << DECODE_PRIMARY_BITS) 
+                           >> (64 - table_entry->bits))];
+            }
+            if (table_entry->count != 1)
+            {
+                return false;
+            }
+            symbol = table_entry->symbols[0];
+            length += table_entry->bits;
+        }
+        else
+        {
+            length = canonical_decode(&decoder->canon, bit_buffer, &symbol);
+            if (length == 0)
+            {
+                return false;
+            }
+        }
+
+        bit_buffer <<= length;
+        bit_count -= (int) length;
+
+        if (out_pos == IO_BUFFER_SIZE)
+        {
+            write_bytes(out, out_pos);
+            out_pos = 0;
+        }
+        out[out_pos++] = symbol;
+        decoder = decoders[symbol];
+        count--;
+    }
+    write_bytes(out, out_pos);
+
+    /* Alle verbrauchten Bits müssen in der Eingabe gelegen haben */
+    return in_pos <= in_size || (in_pos - in_size) * 8 <= (size_t) bit_count;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * Dieses Modul realisiert das Kontextformat (#FORMAT_CONTEXT), eine
+ * Huffman-Kodierung der Ordnung 1. Jedes Zeichen wird mit dem Code des
+ * Kontexts kodiert, der durch das vorangehende Zeichen bestimmt ist; vor
+ * dem ersten Zeichen gilt das Zeichen 0 als Vorgänger.
+ *
+ * Damit der Header auch bei kleinen Dateien kurz bleibt, erhält nicht jeder
+ * Kontext eine eigene Codetabelle. Die Kontexte werden zu höchstens
+ * #CONTEXT_MAX_TABLES Gruppen zusammengefasst, die sich eine Tabelle
+ * teilen: Zunächst bilden alle Kontexte eine gemeinsame Gruppe 0, aus der
+ * die häufigsten Kontexte herausgelöst werden, solange ihre eigene Tabelle
+ * mehr Bits spart, als ihr Header kostet. Danach wird jeder Kontext der
+ * Gruppe zugeordnet, deren Codes ihn am kürzesten kodieren.
+ *
+ * Nach dem Container-Header hat das Format folgenden Aufbau:
+ * <UL>
+ * <LI> Varint: Anzahl aller Zeichen
+ * <LI> Varint: Anzahl T der Codetabellen, 1 bis #CONTEXT_MAX_TABLES
+ * <LI> Varint: Anzahl P der Kontexte, die nicht Tabelle 0 verwenden
+ * <LI> P x 2 Byte: Kontext (vorangehendes Zeichen) und Nummer seiner Tabelle
+ * <LI> T Codetabellen: die Codelängen im Format des Moduls canonical
+ * <LI> der Bitstrom, auf ganze Bytes aufgefüllt
+ * </UL>
+ *
+ * Dekodiert wird je Tabelle über eine Schnelltabelle, die mit den nächsten
+ * #CONTEXT_FAST_BITS Bits indiziert wird. Längere Codes werden über die
+ * Dekodiertabelle des Moduls codetable aufgelöst, nur Codes mit mehr als
+ * #DECODE_MAX_CODE_LENGTH Bits über die ersten Codes je Codelänge.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef CONTEXT_H
+#define CONTEXT_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Maximale Anzahl der Codetabellen, die Tabellennummer passt in ein Byte */
+#define CONTEXT_MAX_TABLES 256
+
+/** Anzahl der Bits, mit denen die Schnelltabelle indiziert wird */
+#define CONTEXT_FAST_BITS 10
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Komprimiert die übergebenen Daten im Kontextformat und schreibt das
+ * Ergebnis ohne Container-Header in den Ausgabestrom.
+ *
+ * @param data              die zu komprimierenden Daten
+ * @param size              Größe der Daten in Bytes
+ * @param max_code_length   maximale Codelänge, höchstens
+ *                          #CANONICAL_MAX_LENGTH
+ */
+extern void context_compress(const unsigned char data[], size_t size,
+                             unsigned int max_code_length);
+
+/**
+ * Dekomprimiert Daten im Kontextformat und schreibt das Ergebnis in den
+ * Ausgabestrom.
+ *
+ * @param data      die komprimierten Daten, beginnend nach dem
+ *                  Container-Header
+ * @param size      Größe der komprimierten Daten in Bytes
+ * @return          false, wenn die Daten fehlerhaft sind, true sonst
+ */
+extern bool context_decompress(const unsigned char data[], size_t size);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* CONTEXT_H */
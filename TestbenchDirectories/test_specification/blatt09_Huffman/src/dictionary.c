@@ -0,0 +1,213 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "huffman_common.h"
+#include "io.h"
+#include "histogram.h"
+#include "codelength.h"
+#include "canonical.h"
+#include "codetable.h"
+#include "dictionary.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+/** Startwert der FNV-1a-Prüfsumme, aus der die Kennung berechnet wird */
+#define FNV_OFFSET_BASIS 2166136261u
+
+/** Multiplikator der FNV-1a-Prüfsumme */
+#define FNV_PRIME 16777619u
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Vervollständigt ein Wörterbuch, dessen kanonischer Code gesetzt ist:
+ * Berechnet die Kennung und erzeugt Codes und Dekodiertabelle.
+ *
+ * @param dictionary    das Wörterbuch
+ * @return              false, wenn nicht alle Zeichen einen Code haben oder
+ *                      die Codes zu lang für die Dekodiertabelle sind,
+ *                      true sonst
+ */
+static bool init_dictionary(DICTIONARY *dictionary);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: dictionary_count
+ * ------------------------------------------------------------------------ */
+extern void dictionary_count(char filename[],
+                             unsigned long long frequencys[])
+{
+    BITREADER reader;
+    const unsigned char *data;
+    size_t size;
+
+    memset(&reader, 0, sizeof (BITREADER));
+    data = bitreader_map(&reader, filename, &size);
+    histogram_count(data, size, frequencys);
+    bitreader_unmap(&reader);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: dictionary_create
+ * ------------------------------------------------------------------------ */
+extern DICTIONARY *dictionary_create(const unsigned long long frequencys[],
+                                     unsigned int max_length)
+{
+    DICTIONARY *dictionary;
+    /* Häufigkeiten, in denen jedes Zeichen mindestens einmal vorkommt */
+    unsigned long long smoothed[MAX_CHARACTERS];
+    unsigned char lengths[MAX_CHARACTERS];
+    int i;
+
+    dictionary = malloc(sizeof (DICTIONARY));
+    ENSURE_ENOUGH_MEMORY(dictionary, "dictionary_create");
+
+    for (i = 0; i < MAX_CHARACTERS; i++)
+    {
+        smoothed[i] = frequencys[i] + 1;
+    }
+
+    if (max_length > DECODE_MAX_CODE_LENGTH)
+    {
+        max_length = DECODE_MAX_CODE_LENGTH;
+    }
+    codelength_limited(smoothed, max_length, lengths);
+
+    /* Optimale Codelängen ergeben immer einen gültigen, vollständigen Code
+     * für alle Zeichen */
+    if (!canonical_create(lengths, &dictionary->canon)
+        || !init_dictionary(dictionary))
+    {
+        fprintf(stderr, "dictionary_create: invalid code lengths\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return dictionary;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: dictionary_write
+ * ------------------------------------------------------------------------ */
+extern void dictionary_write(const DICTIONARY *dictionary, char filename[])
+{
+    BITWRITER writer;
+    unsigned char buffer[CANONICAL_MAX_HEADER_SIZE];
+
+    memset(&writer, 0, sizeof (BITWRITER));
+    bitwriter_open(&writer, filename);
+    bitwriter_write_int(&writer, DICTIONARY_MAGIC);
+    bitwriter_write_bytes(&writer, buffer,
+                          canonical_store_header(&dictionary->canon, buffer));
+    bitwriter_close(&writer);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: dictionary_load
+ * ------------------------------------------------------------------------ */
+extern DICTIONARY *dictionary_load(char filename[])
+{
+    DICTIONARY *dictionary;
+    BITREADER reader;
+    const unsigned char *data;
+    size_t size;
+    bool valid;
+
+    dictionary = malloc(sizeof (DICTIONARY));
+    ENSURE_ENOUGH_MEMORY(dictionary, "dictionary_load");
+
+    memset(&reader, 0, sizeof (BITREADER));
+    data = bitreader_map(&reader, filename, &size);
+
+    /* Kennung mit 4 Bytes, höchstwertiges Byte zuerst */
+    valid = size > 4
+            && ((unsigned int) data[0] << 24 | (unsigned int) data[1] << 16
+                | (unsigned int) data[2] << 8 | data[3]) == DICTIONARY_MAGIC
+            && canonical_load_header(&dictionary->canon, data + 4,
+                                     size - 4) == size - 4
+            && init_dictionary(dictionary);
+    bitreader_unmap(&reader);
+
+    if (!valid)
+    {
+        free(dictionary);
+        dictionary = NULL;
+    }
+
+    return dictionary;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: dictionary_destroy
+ * ------------------------------------------------------------------------ */
+extern void dictionary_destroy(DICTIONARY **dictionary)
+{
+    if (dictionary != NULL && *dictionary != NULL)
+    {
+        decode_table_destroy(&(*dictionary)->table);
+        free(*dictionary);
+        *dictionary = NULL;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: init_dictionary
+ * ------------------------------------------------------------------------ */
+static bool init_dictionary(DICTIONARY *dictionary)
+{
+    unsigned char buffer[CANONICAL_MAX_HEADER_SIZE];
+    size_t size;
+    unsigned int hash = FNV_OFFSET_BASIS;
+    bool seen[MAX_CHARACTERS] = {false};
+    size_t i;
+
+    /* Jedes Zeichen muss genau einmal vorkommen, damit jede Datei kodiert
+     * werden kann */
+    if (dictionary->canon.symbol_count != MAX_CHARACTERS)
+    {
+        return false;
+    }
+    for (i = 0; i < MAX_CHARACTERS; i++)
+    {
+        if (seen[dictionary->canon.symbols[i]])
+        {
+            return false;
+        }
+        seen[dictionary->canon.symbols[i]] = true;
+    }
+
+    /* Die Kennung ist die auf 16 Bit gefaltete Prüfsumme der Codelängen */
+    size = canonical_store_header(&dictionary->canon, buffer);
+    for (i = 0; i < size; i++)
+    {
+        hash = (hash ^ buffer[i]) * FNV_PRIME;
+    }
+    dictionary->id = (hash >> 16) ^ (hash & 0xFFFFu);
+
+    canonical_get_codes(&dictionary->canon, dictionary->codes);
+    dictionary->table = decode_table_create(dictionary->codes);
+
+    return dictionary->table != NULL;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file
+ * Dieses Modul verwaltet vortrainierte Wörterbücher (Option -D). Ein
+ * Wörterbuch ist ein fester kanonischer Code für alle #MAX_CHARACTERS
+ * Zeichen, der aus den Häufigkeiten einer Sammlung typischer Dateien
+ * erzeugt wird. Damit jedes Zeichen kodiert werden kann, wird jede
+ * Häufigkeit vorher um 1 erhöht. Komprimierte Dateien im Format
+ * #FORMAT_DICTIONARY speichern statt der Häufigkeiten nur die Kennung des
+ * Wörterbuchs; für sie entfallen Header und Aufbau des Codebaums.
+ *
+ * Die Wörterbuchdatei besteht aus der Kennung #DICTIONARY_MAGIC mit 4 Bytes
+ * und den Codelängen im Format des Moduls canonical. Die 16 Bit lange
+ * Kennung des Wörterbuchs wird aus den Codelängen berechnet, so dass
+ * gleiche Codes dieselbe Kennung erhalten.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include "huffman_common.h"
+#include "codetable.h"
+#include "canonical.h"
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Kennung am Anfang einer Wörterbuchdatei: 0x89 'H' 'D' 'C' */
+#define DICTIONARY_MAGIC 0x89484443u
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Ein geladenes oder erzeugtes Wörterbuch
+ */
+typedef struct
+{
+    /** Kennung des Wörterbuchs (16 Bit) */
+    unsigned int id;
+
+    /** der kanonische Code aller Zeichen */
+    CANONICAL_CODE canon;
+
+    /** die Codes der #MAX_CHARACTERS Zeichen für die Komprimierung */
+    HUFF_CODE codes[MAX_CHARACTERS];
+
+    /** Dekodiertabelle der Codes für die Dekomprimierung */
+    DECODE_TABLE *table;
+} DICTIONARY;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Zählt die Häufigkeiten der Zeichen einer Datei der Sammlung und addiert
+ * sie zu den übergebenen Häufigkeiten.
+ *
+ * @param filename      Name der Datei
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen, zu denen
+ *                      addiert wird
+ */
+extern void dictionary_count(char filename[],
+                             unsigned long long frequencys[]);
+
+/**
+ * Erzeugt ein Wörterbuch aus den Häufigkeiten einer Sammlung. Die Codes
+ * sind höchstens max_length und höchstens #DECODE_MAX_CODE_LENGTH Bits
+ * lang, so dass immer die Dekodiertabelle verwendet werden kann.
+ *
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @param max_length    Maximallänge der Codes
+ * @return              das Wörterbuch, freizugeben mit dictionary_destroy
+ */
+extern DICTIONARY *dictionary_create(const unsigned long long frequencys[],
+                                     unsigned int max_length);
+
+/**
+ * Schreibt das Wörterbuch in die übergebene Datei.
+ *
+ * @param dictionary    das Wörterbuch
+ * @param filename      Name der Wörterbuchdatei
+ */
+extern void dictionary_write(const DICTIONARY *dictionary, char filename[]);
+
+/**
+ * Lädt ein Wörterbuch aus der übergebenen Datei.
+ *
+ * @param filename  Name der Wörterbuchdatei
+ * @return          das Wörterbuch, freizugeben mit dictionary_destroy, oder
+ *                  NULL, wenn die Datei kein gültiges Wörterbuch enthält
+ */
+extern DICTIONARY *dictionary_load(char filename[]);
+
+/**
+ * Gibt das übergebene Wörterbuch frei und setzt den Zeiger auf NULL.
+ *
+ * @param dictionary    das freizugebende Wörterbuch
+ */
+extern void dictionary_destroy(DICTIONARY **dictionary);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* DICTIONARY_H */
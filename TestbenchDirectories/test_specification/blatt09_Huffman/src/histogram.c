@@ -0,0 +1,139 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "huffman_common.h"
+#include "histogram.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/** Anzahl der verschränkten Teilhistogramme */
+#define HISTOGRAM_WAYS 4
+
+/**
+ * Maximale Anzahl Bytes, die in den 32-Bit-Zählern der Teilhistogramme 
+ * gezählt werden, bevor sie in die 64-Bit-Summen übertragen werden
+ */
+#define HISTOGRAM_CHUNK_SIZE ((size_t) 1 << 30)
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Zählt höchstens #HISTOGRAM_CHUNK_SIZE Zeichen in den Teilhistogrammen.
+ *
+ * @param data      die zu zählenden Zeichen
+ * @param size      Anzahl der Zeichen
+ * @param counts    die zuvor mit 0 belegten Teilhistogramme
+ */
+static void count_chunk(const unsigned char data[], size_t size,
+                        unsigned int counts[HISTOGRAM_WAYS][MAX_CHARACTERS]);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: histogram_count
+ * ------------------------------------------------------------------------ */
+extern void histogram_count(const unsigned char data[], size_t size,
+                            unsigned long long frequencys[])
+{
+    unsigned int counts[HISTOGRAM_WAYS][MAX_CHARACTERS];
+    size_t chunk;
+    int way;
+    int c;
+
+    while (size > 0)
+    {
+        chunk = (size < HISTOGRAM_CHUNK_SIZE) ? size : HISTOGRAM_CHUNK_SIZE;
+
+        memset(counts, 0, sizeof (counts));
+        count_chunk(data, chunk, counts);
+
+        for (c = 0; c < MAX_CHARACTERS; c++)
+        {
+            for (way = 0; way < HISTOGRAM_WAYS; way++)
+            {
+                frequencys[c] += counts[way][c];
+            }
+        }
+
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: count_chunk
+ * ------------------------------------------------------------------------ */
+static void count_chunk(const unsigned char data[], size_t size,
+                        unsigned int counts[HISTOGRAM_WAYS][MAX_CHARACTERS])
+{
+    unsigned long long word1;
+    unsigned long long word2;
+    size_t i = 0;
+
+    /* Je Schritt 16 Bytes. Die Bytes eines Wortes werden reihum auf die 
+     * Teilhistogramme verteilt, die Byte-Reihenfolge des Rechners spielt 
+     * für das Zählen keine Rolle. */
+    while (size - i >= 16)
+    {
+        memcpy(&word1, data + i, sizeof (word1));
+        memcpy(&word2, data + i + 8, sizeof (word2));
+
+        counts[0][word1 & 0xFF]++;
+        counts[1][(word1 >> 8) & 0xFF]++;
+        counts[2][(word1 >> 16) & 0xFF]++;
+        counts[3][(word1 >> 24) & 0xFF]++;
+        counts[0][(word1 >> 32) & 0xFF]++;
+        counts[1][(word1 >> 40) & 0xFF]++;
+        counts[2][(word1 >> 48) & 0xFF]++;
+        counts[3][word1 >> 56]++;
+
+        counts[0][word2 & 0xFF]++;
+        counts[1][(word2 >> 8) & 0xFF]++;
+        counts[2][(word2 >> 16) & 0xFF]++;
+        counts[3][(word2 >> 24) & 0xFF]++;
+        counts[0][(word2 >> 32) & 0xFF]++;
+        counts[1][(word2 >> 40) & 0xFF]++;
+        counts[2][(word2 >> 48) & 0xFF]++;
+        counts[3][word2 >> 56]++;
+
+        i += 16;
+    }
+
+    while (i < size)
+    {
+        counts[0][data[i]]++;
+        i++;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: histogram_get_different
+ * ------------------------------------------------------------------------ */
+extern unsigned int histogram_get_different(const unsigned long long frequencys[])
+{
+    unsigned int different = 0;
+    int c;
+
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (frequencys[c] > 0)
+        {
+            different++;
+        }
+    }
+
+    return different;
+}
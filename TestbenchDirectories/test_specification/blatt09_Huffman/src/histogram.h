@@ -0,0 +1,52 @@
+/**
+ * @file
+ * Dieses Modul zählt die Häufigkeiten der Zeichen in einem Speicherbereich.
+ * Gezählt wird in mehreren verschränkten Teilhistogrammen, so dass 
+ * aufeinanderfolgende gleiche Zeichen nicht denselben Zähler erhöhen und
+ * nicht auf das Ergebnis der vorherigen Erhöhung warten müssen. Je Schritt
+ * werden 16 Bytes als zwei 64-Bit-Wörter gelesen. Die Summen werden mit 
+ * 64 Bit geführt, so dass auch Dateien über 4 GiB gezählt werden können.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stddef.h>
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Zählt die Häufigkeiten der Zeichen in data und addiert sie zu den 
+ * übergebenen Häufigkeiten. Vor dem ersten Aufruf müssen die Häufigkeiten
+ * mit 0 belegt werden.
+ *
+ * @param data          die zu zählenden Zeichen
+ * @param size          Anzahl der Zeichen
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen, zu denen
+ *                      addiert wird
+ */
+extern void histogram_count(const unsigned char data[], size_t size,
+                            unsigned long long frequencys[]);
+
+/**
+ * Liefert die Anzahl der Zeichen mit einer Häufigkeit größer 0.
+ *
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @return              Anzahl der vorkommenden Zeichen
+ */
+extern unsigned int histogram_get_different(const unsigned long long frequencys[]);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* HISTOGRAM_H */
@@ -6,263 +6,1856 @@
 #include <stdio.h>
 #include <string.h>
 
-#include "btree.h"
-#include "binary_heap.h"
+#include "huffman_common.h"
+#include "io.h"
+#include "codetable.h"
+#include "hufftree.h"
+#include "canonical.h"
+#include "codelength.h"
+#include "block.h"
+#include "histogram.h"
+#include "transform.h"
+#include "adaptive.h"
+#include "context.h"
+#include "speculative.h"
+#include "dictionary.h"
+#include "threadpool.h"
+#include "profile.h"
+#include "huffman.h"
+
+#include "limits.h"
+
+
+/* ===========================================================================
+ * Makros
+ * ======================================================================== */
+
+/** Kennung am Anfang eines Containers: 0x89 'H' 'U' 'F' */
+#define CONTAINER_MAGIC 0x89485546u
+
+/** Version des Containerformats, die geschrieben und gelesen werden kann */
+#define CONTAINER_VERSION 1
+
+/** Flag im Container-Header: Blöcke mit #DECODE_STREAMS Teilströmen */
+#define CONTAINER_FLAG_STREAMS 0x0001u
+
+/** Flag im Container-Header: kanonisches Format mit Sprungindex */
+#define CONTAINER_FLAG_INDEX 0x0002u
+
+/** 
+ * Mindestgröße der Eingabe in Bytes, ab der sich das Erzeugen der 
+ * Paartabelle für die Komprimierung lohnt
+ */
+#define ENCODE_PAIR_MIN_SIZE (1u << 16)
+
+
+/* ===========================================================================
+ * Funktionsprototypen
+ * ======================================================================== */
+
+/**
+ * Komprimiert die Zeichen der im Speicher liegenden Eingabedatei mit den in 
+ * der Code-Tabelle übergebebenen Codes und schreibt jeden Code als Ganzes in 
+ * die Ausgabedatei. Mit #ENCODER_PAIRS werden ab #ENCODE_PAIR_MIN_SIZE 
+ * Bytes je Schritt zwei Zeichen über eine Paartabelle geschrieben.
+ * 
+ * @param data          Inhalt der Eingabedatei
+ * @param size          Größe der Eingabedatei in Bytes
+ * @param code_table    Code-Tabelle, die für alle Zeichen des Eingabestroms 
+ *                      einen Code für die Komprimierung enthält.
+ */
+static void compress_characters(const unsigned char data[], size_t size,
+                                const HUFF_CODE code_table[]);
+
+/**
+ * Dekomprimiert die Bits des Eingabestroms anhand des übergebebenen 
+ * Huffman-Baums und schreibt die dekomprimierten Zeichen in den Ausgabestrom.
+ * Je nach Einstellung wird dazu eine Dekodiertabelle erzeugt oder der Baum
+ * bitweise durchlaufen. Mit mehr als einem Thread wird die Dekodiertabelle
+ * spekulativ auf Abschnitte des Bitstroms angewendet (Modul speculative).
+ * 
+ * @param hufftree          Huffman-Baum für die Dekomprimierung
+ * @param all_characters    Anzahl der zu dekodierenden Zeichen
+ */
+static void decompress_characters(const HUFFTREE *hufftree, 
+                                  unsigned long long all_characters);
+
+/**
+ * Dekomprimiert die Bits des Eingabestroms, indem für jedes Bit ein Schritt 
+ * im Huffman-Baum ausgeführt wird.
+ * 
+ * @param hufftree          Huffman-Baum für die Dekomprimierung
+ * @param all_characters    Anzahl der zu dekodierenden Zeichen
+ */
+static void decompress_characters_tree(const HUFFTREE *hufftree,
+                                       unsigned long long all_characters);
+
+/**
+ * Dekomprimiert die Bits des Eingabestroms anhand eines kanonischen Codes,
+ * ohne einen Huffman-Baum aufzubauen. Die Codes werden über die ersten 
+ * Codes je Codelänge aufgelöst; dies wird nur für Codes verwendet, die zu
+ * lang für eine Dekodiertabelle sind.
+ * 
+ * @param canon             kanonischer Code für die Dekomprimierung
+ * @param all_characters    Anzahl der zu dekodierenden Zeichen
+ */
+static void decompress_characters_canonical(const CANONICAL_CODE *canon,
+                                            unsigned long long all_characters);
+
+/**
+ * Dekomprimiert eine Datei im ursprünglichen Format oder im Format für 
+ * große Dateien, deren Anzahlen bereits gelesen wurden, und schreibt das 
+ * Ergebnis in die Ausgabedatei.
+ * 
+ * @param all_characters        Anzahl der Zeichen der Ausgangsdatei
+ * @param different_characters  Anzahl der Zeichen/Häufigkeits-Paare
+ * @param out_filename          Name der Ausgabedatei
+ * @param large                 true, wenn die Häufigkeiten als Zahlen 
+ *                              variabler Länge gespeichert sind 
+ *                              (#FORMAT_LARGE)
+ */
+static void decompress_legacy(unsigned long long all_characters,
+                              unsigned int different_characters,
+                              char *out_filename, bool large);
+
+/**
+ * Dekomprimiert eine Datei im Format für große Dateien, deren 
+ * Container-Header bereits gelesen wurde, und schreibt das Ergebnis in die
+ * Ausgabedatei.
+ * 
+ * @param out_filename  Name der Ausgabedatei
+ */
+static void decompress_large(char *out_filename);
+
+/**
+ * Dekomprimiert eine Datei im Format mit Wörterbuch, deren Container-Header
+ * bereits gelesen wurde, mit dem Wörterbuch der Einstellungen.
+ * 
+ * @param out_filename  Name der Ausgabedatei
+ * @param id            Kennung des Wörterbuchs aus dem Container-Header
+ */
+static void decompress_dictionary(char *out_filename, unsigned int id);
+
+/**
+ * Berechnet aus den Häufigkeiten und Codelängen die genaue Größe der
+ * komprimierten Datei im ursprünglichen, großen, kanonischen Format oder
+ * im Format mit Wörterbuch, ohne die Zeichen zu kodieren. Ein Sprungindex
+ * des kanonischen Formats wird nicht mitgezählt.
+ *
+ * @param frequencys            Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @param code_table            Codes der #MAX_CHARACTERS Zeichen
+ * @param different_characters  Anzahl der verschiedenen Zeichen
+ * @param all_characters        Anzahl aller Zeichen
+ * @param canon                 kanonischer Code im kanonischen Format, 
+ *                              sonst NULL
+ * @return                      Größe der komprimierten Datei in Bytes
+ */
+static unsigned long long get_encoded_size(
+        const unsigned long long frequencys[], const HUFF_CODE code_table[],
+        unsigned int different_characters, unsigned long long all_characters,
+        const CANONICAL_CODE *canon);
+
+/**
+ * Liefert die Größe einer Datei im gespeicherten Format (#FORMAT_STORED).
+ *
+ * @param size  Größe der Eingabedatei in Bytes
+ * @return      Größe der gespeicherten Datei in Bytes
+ */
+static unsigned long long get_stored_size(unsigned long long size);
+
+/**
+ * Schreibt die im Speicher liegende Eingabedatei unkodiert im gespeicherten
+ * Format (#FORMAT_STORED) in die Ausgabedatei.
+ *
+ * @param data  Inhalt der Eingabedatei
+ * @param size  Größe der Eingabedatei in Bytes
+ */
+static void compress_stored(const unsigned char data[], size_t size);
+
+/**
+ * Dekomprimiert eine Datei im gespeicherten Format, deren Container-Header
+ * bereits gelesen wurde, indem die Zeichen unverändert kopiert werden.
+ *
+ * @param out_filename  Name der Ausgabedatei
+ */
+static void decompress_stored(char *out_filename);
+
+/**
+ * Dekomprimiert eine Datei im kanonischen Format, deren Container-Header
+ * bereits gelesen wurde, und schreibt das Ergebnis in die Ausgabedatei.
+ * 
+ * @param out_filename  Name der Ausgabedatei
+ * @param has_index     true, wenn auf den Header ein Sprungindex folgt, der
+ *                      übersprungen wird
+ */
+static void decompress_canonical(char *out_filename, bool has_index);
+
+/**
+ * Schreibt den Sprungindex des kanonischen Formats mit einer Sprungmarke je
+ * options.index_interval Zeichen. Die Bitpositionen werden vorab aus den 
+ * Codelängen der Zeichen berechnet, so dass der Index vor dem Bitstrom 
+ * stehen kann.
+ * 
+ * @param data          Inhalt der Eingabedatei
+ * @param size          Größe der Eingabedatei in Bytes
+ * @param code_table    die Codes der Zeichen
+ */
+static void write_seek_index(const unsigned char data[], size_t size,
+                             const HUFF_CODE code_table[]);
+
+/**
+ * Kopiert einen Bereich der im Speicher liegenden Daten im gespeicherten
+ * Format in die Ausgabedatei.
+ * 
+ * @param data          die Daten nach dem Container-Header
+ * @param size          Größe der Daten in Bytes
+ * @param offset        Position des ersten auszugebenden Zeichens
+ * @param length        Anzahl der auszugebenden Zeichen
+ * @return              false, wenn die Daten unvollständig sind, true sonst
+ */
+static bool decompress_range_stored(const unsigned char data[], size_t size,
+                                    unsigned long long offset,
+                                    unsigned long long length);
+
+/**
+ * Dekomprimiert einen Bereich der im Speicher liegenden Daten im 
+ * kanonischen Format. Mit Sprungindex beginnt die Dekodierung an der 
+ * letzten Sprungmarke vor dem Bereich.
+ * 
+ * @param data          die Daten nach dem Container-Header
+ * @param size          Größe der Daten in Bytes
+ * @param has_index     true, wenn die Daten einen Sprungindex enthalten
+ * @param offset        Position des ersten auszugebenden Zeichens
+ * @param length        Anzahl der auszugebenden Zeichen
+ * @return              false, wenn die Daten fehlerhaft sind, true sonst
+ */
+static bool decompress_range_canonical(const unsigned char data[], 
+                                       size_t size, bool has_index,
+                                       unsigned long long offset,
+                                       unsigned long long length);
+
+/**
+ * Erzeugt die Dekodiertabelle zu einem kanonischen Code.
+ * 
+ * @param canon     der kanonische Code
+ * @return          die Dekodiertabelle, freizugeben mit 
+ *                  decode_table_destroy, oder NULL, wenn Codes länger als
+ *                  #DECODE_MAX_CODE_LENGTH sind
+ */
+static DECODE_TABLE *create_canonical_table(const CANONICAL_CODE *canon);
+
+/**
+ * Dekodiert ab einer Bitposition eines im Speicher liegenden Bitstroms 
+ * zunächst skip Zeichen, die verworfen werden, und schreibt die folgenden 
+ * count Zeichen in die Ausgabedatei.
+ * 
+ * @param canon         der kanonische Code
+ * @param table         Dekodiertabelle des Codes oder NULL, wenn über die
+ *                      ersten Codes je Codelänge dekodiert wird
+ * @param in            der Bitstrom
+ * @param in_size       Größe des Bitstroms in Bytes
+ * @param bit_offset    Bitposition, an der die Dekodierung beginnt
+ * @param skip          Anzahl der zu verwerfenden Zeichen
+ * @param count         Anzahl der auszugebenden Zeichen
+ * @return              false, wenn der Bitstrom ungültige Codes enthält 
+ *                      oder zu kurz ist, true sonst
+ */
+static bool decode_canonical_range(const CANONICAL_CODE *canon,
+                                   const DECODE_TABLE *table,
+                                   const unsigned char in[], size_t in_size,
+                                   unsigned long long bit_offset,
+                                   unsigned long long skip,
+                                   unsigned long long count);
+
+/**
+ * Komprimiert die im Speicher liegende Eingabedatei im blockweisen Format.
+ * 
+ * @param data          Inhalt der Eingabedatei
+ * @param size          Größe der Eingabedatei in Bytes
+ * @param out_filename  Name der Ausgabedatei
+ */
+static void compress_blocks(const unsigned char data[], size_t size,
+                            char *out_filename);
+
+/**
+ * Dekomprimiert eine Datei im blockweisen Format. Die Datei wird dazu 
+ * vollständig in den Speicher eingeblendet, damit die Blöcke parallel 
+ * dekomprimiert werden können.
+ * 
+ * @param in_filename   Name der Eingabedatei
+ * @param out_filename  Name der Ausgabedatei
+ * @param streams       Anzahl der Teilströme je Block laut Container-Header
+ *                      (1 oder #DECODE_STREAMS)
+ */
+static void decompress_blocks(char *in_filename, char *out_filename,
+                              unsigned int streams);
+
+/**
+ * Komprimiert die im Speicher liegende Eingabedatei mit Vorverarbeitung.
+ * 
+ * @param data          Inhalt der Eingabedatei
+ * @param size          Größe der Eingabedatei in Bytes
+ * @param out_filename  Name der Ausgabedatei
+ */
+static void compress_transform(const unsigned char data[], size_t size,
+                               char *out_filename);
+
+/**
+ * Dekomprimiert eine Datei im Format mit Vorverarbeitung.
+ * 
+ * @param in_filename   Name der Eingabedatei
+ * @param out_filename  Name der Ausgabedatei
+ * @param streams       Anzahl der Teilströme je Block laut Container-Header
+ *                      (1 oder #DECODE_STREAMS)
+ */
+static void decompress_transform(char *in_filename, char *out_filename,
+                                 unsigned int streams);
+
+/**
+ * Stellt die Daten einer Containerdatei nach dem bereits gelesenen 
+ * Container-Header vollständig im Speicher bereit. Der Speicher muss mit
+ * unmap_infile freigegeben werden.
+ * 
+ * @param in_filename   Name der Eingabedatei
+ * @param size          Größe der Daten nach dem Container-Header in Bytes
+ * @return              die Daten nach dem Container-Header
+ */
+static const unsigned char *load_container_body(char *in_filename, 
+                                                size_t *size);
+
+/**
+ * Komprimiert die Eingabedatei in einem Durchlauf im Stromformat.
+ * 
+ * @param in_filename   Name der Eingabedatei
+ * @param out_filename  Name der Ausgabedatei
+ */
+static void compress_stream(char *in_filename, char *out_filename);
+
+/**
+ * Dekomprimiert den Rest der geöffneten Eingabedatei im Stromformat.
+ * 
+ * @param out_filename  Name der Ausgabedatei
+ * @param streams       Anzahl der Teilströme je Block laut Container-Header
+ *                      (1 oder #DECODE_STREAMS)
+ */
+static void decompress_stream(char *out_filename, unsigned int streams);
+
+/**
+ * Komprimiert die Eingabedatei in einem Durchlauf im adaptiven Format.
+ * 
+ * @param in_filename   Name der Eingabedatei
+ * @param out_filename  Name der Ausgabedatei
+ */
+static void compress_adaptive(char *in_filename, char *out_filename);
+
+/**
+ * Dekomprimiert den Rest der geöffneten Eingabedatei im adaptiven Format.
+ * 
+ * @param out_filename  Name der Ausgabedatei
+ */
+static void decompress_adaptive(char *out_filename);
+
+/**
+ * Komprimiert die übergebenen Daten im Kontextformat in die Zieldatei.
+ *
+ * @param data          die zu komprimierenden Daten
+ * @param size          Größe der Daten in Bytes
+ * @param out_filename  Name der Zieldatei
+ */
+static void compress_context(const unsigned char data[], size_t size,
+                             char *out_filename);
+
+/**
+ * Dekomprimiert eine Datei im Kontextformat, deren Container-Header bereits 
+ * gelesen wurde.
+ *
+ * @param in_filename   Name der Quelldatei
+ * @param out_filename  Name der Zieldatei
+ */
+static void decompress_context(char *in_filename, char *out_filename);
+
+/**
+ * Liefert die maximale Codelänge für die blockweisen Formate, deren Blöcke
+ * immer über die Dekodiertabelle dekodiert werden.
+ * 
+ * @return  maximale Codelänge, höchstens #DECODE_MAX_CODE_LENGTH
+ */
+static unsigned int get_block_code_length(void);
+
+/**
+ * Schreibt den Container-Header für das übergebene Format. In den 
+ * blockweisen Formaten wird die Anzahl der Teilströme je Block als Flag 
+ * vermerkt.
+ * 
+ * @param format    Format der komprimierten Daten
+ */
+static void write_container_header(FORMAT format);
+
+/**
+ * Prüft Version und Flags des zweiten Worts eines Container-Headers und 
+ * bricht das Programm bei unbekannten Werten ab.
+ * 
+ * @param second_word   Format, Version und Flags des Container-Headers
+ * @return              die Flags bzw. im Format mit Wörterbuch dessen 
+ *                      Kennung
+ */
+static unsigned int check_container_header(unsigned int second_word);
+
+/**
+ * Gibt eine Fehlermeldung zu einer fehlerhaften komprimierten Datei aus und
+ * bricht das Programm mit #EXIT_DC_ERROR ab.
+ * 
+ * @param message   auszugebende Fehlermeldung
+ */
+static void report_format_error_and_exit(const char *message);
+
+/**
+ * Dekomprimiert die Bits des Eingabestroms mit Hilfe einer Dekodiertabelle.
+ * Je Schritt werden die nächsten #DECODE_PRIMARY_BITS Bits ausgewertet und
+ * ein oder zwei Zeichen dekodiert.
+ * 
+ * @param table             Dekodiertabelle für die Dekomprimierung
+ * @param all_characters    Anzahl der zu dekodierenden Zeichen
+ */
+static void decompress_characters_table(const DECODE_TABLE *table,
+                                        unsigned long long all_characters);
+
+/**
+ * Erzeugt aus einem Huffman-Baum eine Code-Tabelle, welche die 
+ * Kodierungs-Vorschrift für die Komprimierung einer Datei darstellt.
+ * 
+ * @param hufftree      Huffman-Baum, aus dem die Code-Tabelle erzeugt
+ *                      werden soll
+ * @param code_table    Das Array, in welches die Codes als Paare aus 
+ *                      Bitfolge und Länge geschrieben werden.
+ */
+static void build_code_table(const HUFFTREE *hufftree, 
+                             HUFF_CODE code_table[]);
+
+/**
+ * Schreibt die Informationen, welche zur Dekomprimierung benötigt werden, 
+ * in die Ausgabedatei, die zuvor mit open_outfile geöffnet worden sein muss.
+ * 
+ * @param all_characters        Anzahl aller Zeichern der Eingabedatei
+ * @param different_characters  Anzahl verschiedener Zeichen der Eingabedatei
+ * @param frequencys            Ein Array mit den Häufigkeiten von Zeichen in
+ *                              der zu komprimierenden Datei.
+ * @param large                 true für das Format für große Dateien mit
+ *                              Container-Header und Zahlen variabler Länge
+ *                              (#FORMAT_LARGE), false für das ursprüngliche
+ *                              Format mit 32-Bit-Zahlen
+ */
+static void write_fileheader(unsigned long long all_characters,
+                             unsigned int different_characters,
+                             const unsigned long long frequencys[],
+                             bool large);
+
+/**
+ * Liest die Zeichen/Häufigkeits-Paare, welche zur Dekomprimierung benötigt
+ * werden, aus einer Datei. Die Eingabedatei muss bereits geöffnet sein und
+ * die Anzahl der Zeichen und der Paare bereits gelesen worden sein.
+ * 
+ * @param frequencys            Ein Array mit den Häufigkeiten von Zeichen in
+ *                              der zu komprimierenden Datei.
+ * @param different_characters  Anzahl der zu lesenden Paare
+ * @param large                 true, wenn die Häufigkeiten als Zahlen 
+ *                              variabler Länge gespeichert sind
+ */
+static void read_fileheader(unsigned long long frequencys[],
+                            unsigned int different_characters, bool large);
+
+
+/* ===========================================================================
+ * Globale Variablen
+ * ======================================================================== */
+
+/** Einstellungen für die Komprimierung und Dekomprimierung */
+static HUFFMAN_OPTIONS options = {
+    FORMAT_LEGACY, DEFAULT_MAX_CODE_LENGTH, DECODER_TABLE, ENCODER_PAIRS,
+    BLOCK_DEFAULT_SIZE, 0, 0, BLOCK_DEFAULT_SIZE, DECODE_STREAMS, 0, NULL
+};
+
+
+/* ===========================================================================
+ * Funktionsdefinitionen
+ * ======================================================================== */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: huffman_get_default_options
+ * ------------------------------------------------------------------------ */
+extern void huffman_get_default_options(HUFFMAN_OPTIONS *default_options)
+{
+    default_options->format = FORMAT_LEGACY;
+    default_options->max_code_length = DEFAULT_MAX_CODE_LENGTH;
+    default_options->decoder = DECODER_TABLE;
+    default_options->encoder = ENCODER_PAIRS;
+    default_options->block_size = BLOCK_DEFAULT_SIZE;
+    default_options->threads = 0;
+    default_options->transforms = 0;
+    default_options->transform_block_size = BLOCK_DEFAULT_SIZE;
+    default_options->streams = DECODE_STREAMS;
+    default_options->index_interval = 0;
+    default_options->dictionary = NULL;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: huffman_set_level
+ * ------------------------------------------------------------------------ */
+extern void huffman_set_level(HUFFMAN_OPTIONS *level_options, 
+                              unsigned int level)
+{
+    level_options->transforms = 0;
+
+    switch (level)
+    {
+    case 1:
+        level_options->format = FORMAT_BLOCKS;
+        level_options->block_size = 4 * BLOCK_DEFAULT_SIZE;
+        break;
+
+    case 3:
+        level_options->format = FORMAT_CANONICAL;
+        break;
+
+    case 4:
+        level_options->format = FORMAT_TRANSFORM;
+        level_options->transforms = TRANSFORM_RLE;
+        break;
+
+    case 5:
+    case 6:
+    case 7:
+        level_options->format = FORMAT_TRANSFORM;
+        level_options->transforms = TRANSFORM_BWT | TRANSFORM_MTF 
+                                    | TRANSFORM_RLE;
+        level_options->transform_block_size = 
+                (BLOCK_DEFAULT_SIZE / 4) << (2 * (level - 5));
+        break;
+
+    default:
+        level_options->format = FORMAT_LEGACY;
+        break;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: huffman_set_options
+ * ------------------------------------------------------------------------ */
+extern void huffman_set_options(const HUFFMAN_OPTIONS *new_options)
+{
+    options = *new_options;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: huffman_compress
+ * ------------------------------------------------------------------------ */
+extern void compress(char *in_filename, char *out_filename)
+{
+    /* Häufigkeiten der Zeichen in der Eingabedatei. */
+    unsigned long long frequencys[MAX_CHARACTERS];
+    /* Huffman-Baum */
+    HUFFTREE *hufftree;
+    /* Tabelle mit Huffman-Binärcodes zum Kodieren der Zeichen */
+    HUFF_CODE code_table[MAX_CHARACTERS];
+    /* Anzahl der unterschiedlichen Zeichen in der Eingabedatei */
+    unsigned int different_characters;
+    /* Kanonischer Code mit optimalen Codes beschränkter Länge */
+    CANONICAL_CODE canon;
+    unsigned char lengths[MAX_CHARACTERS];
+    /* Inhalt und Größe der Eingabedatei, die nur einmal gelesen wird */
+    const unsigned char *data;
+    size_t size;
+
+    if (options.format == FORMAT_STREAM)
+    {
+        compress_stream(in_filename, out_filename);
+        return;
+    }
+
+    if (options.format == FORMAT_ADAPTIVE)
+    {
+        compress_adaptive(in_filename, out_filename);
+        return;
+    }
+
+    profile_begin(PROFILE_READ);
+    data = map_infile(in_filename, &size);
+    profile_end();
+
+    if (options.format == FORMAT_BLOCKS || options.format == FORMAT_TRANSFORM
+        || options.format == FORMAT_CONTEXT)
+    {
+        if (options.format == FORMAT_BLOCKS)
+        {
+            compress_blocks(data, size, out_filename);
+        }
+        else if (options.format == FORMAT_TRANSFORM)
+        {
+            compress_transform(data, size, out_filename);
+        }
+        else
+        {
+            compress_context(data, size, out_filename);
+        }
+        profile_begin(PROFILE_FLUSH);
+        unmap_infile();
+        profile_end();
+        return;
+    }
+
+    profile_begin(PROFILE_COUNT);
+    memset(frequencys, 0, sizeof (frequencys));
+    histogram_count(data, size, frequencys);
+    different_characters = histogram_get_different(frequencys);
+    profile_end();
+
+    if (options.format == FORMAT_CANONICAL)
+    {
+        /* Die Codelängen werden direkt aus den 64-Bit-Häufigkeiten 
+         * berechnet. Ist die Maximallänge groß genug, sind sie so kurz wie 
+         * die des Huffman-Baums. */
+        profile_begin(PROFILE_TREE);
+        codelength_limited(frequencys, options.max_code_length, lengths);
+        profile_end();
+        
+        profile_begin(PROFILE_CODES);
+        if (!canonical_create(lengths, &canon))
+        {
+            report_format_error_and_exit("Codes zu lang fuer kanonisches Format.");
+        }
+        canonical_get_codes(&canon, code_table);
+        profile_end();
+    }
+    else if (options.format == FORMAT_DICTIONARY)
+    {
+        /* Die Codes stehen im Wörterbuch fest, ein Baum wird nicht 
+         * aufgebaut */
+        memcpy(code_table, options.dictionary->codes, sizeof (code_table));
+    }
+    else
+    {
+        profile_begin(PROFILE_TREE);
+        hufftree = hufftree_create(frequencys);
+        profile_end();
+
+        profile_begin(PROFILE_CODES);
+        build_code_table(hufftree, code_table);
+
+        /* Freigeben des Baums mit allen Knoten */
+        hufftree_destroy(&hufftree);
+        profile_end();
+    }
+
+    /* Zufällige oder bereits komprimierte Daten werden durch die Kodierung
+     * nicht kleiner und daher unverändert gespeichert */
+    if (get_encoded_size(frequencys, code_table, different_characters, size,
+                         (options.format == FORMAT_CANONICAL) ? &canon : NULL)
+        >= get_stored_size(size))
+    {
+        open_outfile(out_filename);
+        compress_stored(data, size);
+        profile_begin(PROFILE_FLUSH);
+        unmap_infile();
+        close_outfile();
+        profile_end();
+        return;
+    }
+
+    /* Zieldatei zum bitweisen Schreiben öffnen */
+    profile_begin(PROFILE_HEADER);
+    open_outfile(out_filename);
+
+    if (options.format == FORMAT_CANONICAL)
+    {
+        write_container_header(FORMAT_CANONICAL);
+        write_varint(size);
+        canonical_write_header(&canon);
+        if (options.index_interval > 0)
+        {
+            write_seek_index(data, size, code_table);
+        }
+    }
+    else if (options.format == FORMAT_DICTIONARY)
+    {
+        write_container_header(FORMAT_DICTIONARY);
+        write_varint(size);
+    }
+    else
+    {
+        /* Der ursprüngliche Header speichert alle Zahlen mit 32 Bit, 
+         * größere Dateien erhalten das Format mit Varints */
+        write_fileheader(size, different_characters, frequencys,
+                         size > UINT_MAX);
+    }
+    profile_end();
+
+    profile_begin(PROFILE_CODING);
+    compress_characters(data, size, code_table);
+    profile_end();
+
+    /* Freigeben der Quelldatei und Schließen der Zieldatei */
+    profile_begin(PROFILE_FLUSH);
+    unmap_infile();
+    close_outfile();
+    profile_end();
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: compress_characters
+ * ------------------------------------------------------------------------ */
+static void compress_characters(const unsigned char data[], size_t size,
+                                const HUFF_CODE code_table[])
+{
+    BITWRITER *writer = get_outfile_writer();
+    /* Paartabelle für zwei Zeichen je Schritt */
+    ENCODE_PAIR *pair_table = NULL;
+    const ENCODE_PAIR *pair;
+    size_t i = 0;
+
+    SPRINT("Schreibe Binaerdaten...\n");
+
+    /* Schreibe die kodierten Daten in die Datei. Das Auffüllen des letzten 
+     * Bytes mit 0-Bits wird von io.h übernommen. */
+    if (options.encoder == ENCODER_PAIRS && size >= ENCODE_PAIR_MIN_SIZE)
+    {
+        pair_table = encode_pair_table_create(code_table);
+
+        for (; i + 1 < size; i += 2)
+        {
+            pair = &pair_table[data[i] * MAX_CHARACTERS + data[i + 1]];
+            if (pair->length != 0)
+            {
+                bitwriter_write_bits(writer, pair->bits, pair->length);
+            }
+            else
+            {
+                /* Zu lange Paare werden zeichenweise geschrieben */
+                bitwriter_write_bits(writer, code_table[data[i]].bits, 
+                                     code_table[data[i]].length);
+                bitwriter_write_bits(writer, code_table[data[i + 1]].bits, 
+                                     code_table[data[i + 1]].length);
+            }
+        }
+
+        encode_pair_table_destroy(&pair_table);
+    }
+
+    for (; i < size; i++)
+    {
+        bitwriter_write_bits(writer, code_table[data[i]].bits, 
+                             code_table[data[i]].length);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: huffman_decompress
+ * ------------------------------------------------------------------------ */
+extern void decompress(char *in_filename, char *out_filename)
+{
+    /* Die ersten 8 Bytes: Kennung und Format eines Containers oder Anzahl 
+     * aller und verschiedener Zeichen im ursprünglichen Format */
+    unsigned int first_word;
+    unsigned int second_word;
+    /* Flags des Container-Headers */
+    unsigned int flags;
+    /* Anzahl der Teilströme je Block laut Flags */
+    unsigned int streams;
+
+    /* Quelldatei zum bitweisen Zugriff öffnen */
+    profile_begin(PROFILE_READ);
+    open_infile(in_filename);
+    profile_end();
+
+    profile_begin(PROFILE_HEADER);
+    first_word = read_int();
+    second_word = read_int();
+    profile_end();
+
+    if (first_word == CONTAINER_MAGIC && (second_word >> 24) != FORMAT_LEGACY)
+    {
+        flags = check_container_header(second_word);
+        streams = ((flags & CONTAINER_FLAG_STREAMS) != 0) 
+                ? DECODE_STREAMS : 1;
+
+        switch ((FORMAT) (second_word >> 24))
+        {
+        case FORMAT_CANONICAL:
+            decompress_canonical(out_filename, 
+                                 (flags & CONTAINER_FLAG_INDEX) != 0);
+            break;
+
+        case FORMAT_BLOCKS:
+            decompress_blocks(in_filename, out_filename, streams);
+            break;
+
+        case FORMAT_STREAM:
+            decompress_stream(out_filename, streams);
+            break;
+
+        case FORMAT_TRANSFORM:
+            decompress_transform(in_filename, out_filename, streams);
+            break;
+
+        case FORMAT_ADAPTIVE:
+            decompress_adaptive(out_filename);
+            break;
+
+        case FORMAT_CONTEXT:
+            decompress_context(in_filename, out_filename);
+            break;
+
+        case FORMAT_LARGE:
+            decompress_large(out_filename);
+            break;
+
+        case FORMAT_STORED:
+            decompress_stored(out_filename);
+            break;
+
+        case FORMAT_DICTIONARY:
+            decompress_dictionary(out_filename, flags);
+            break;
+
+        default:
+            report_format_error_and_exit("Unbekanntes Format.");
+            break;
+        }
+    }
+    else
+    {
+        decompress_legacy(first_word, second_word, out_filename, false);
+    }
+
+    profile_begin(PROFILE_FLUSH);
+    close_infile();
+    profile_end();
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_range
+ * ------------------------------------------------------------------------ */
+extern void decompress_range(char *in_filename, char *out_filename,
+                             unsigned long long offset,
+                             unsigned long long length)
+{
+    unsigned int first_word;
+    unsigned int second_word;
+    unsigned int flags;
+    const unsigned char *data;
+    size_t size;
+    bool valid;
+
+    open_infile(in_filename);
+
+    first_word = read_int();
+    second_word = read_int();
+
+    /* Nur Formate mit bekannten Positionen erlauben einen Einstieg in der 
+     * Mitte der Daten */
+    if (first_word != CONTAINER_MAGIC 
+        || ((FORMAT) (second_word >> 24) != FORMAT_CANONICAL
+            && (FORMAT) (second_word >> 24) != FORMAT_BLOCKS
+            && (FORMAT) (second_word >> 24) != FORMAT_STORED))
+    {
+        report_format_error_and_exit(
+                "Bereiche nur im kanonischen, blockweisen und gespeicherten "
+                "Format.");
+    }
+    flags = check_container_header(second_word);
+
+    data = load_container_body(in_filename, &size);
+
+    open_outfile(out_filename);
+    if ((FORMAT) (second_word >> 24) == FORMAT_BLOCKS)
+    {
+        valid = block_decompress_range(data, size, 
+                                       ((flags & CONTAINER_FLAG_STREAMS) != 0)
+                                       ? DECODE_STREAMS : 1,
+                                       offset, length);
+    }
+    else if ((FORMAT) (second_word >> 24) == FORMAT_STORED)
+    {
+        valid = decompress_range_stored(data, size, offset, length);
+    }
+    else
+    {
+        valid = decompress_range_canonical(data, size, 
+                                           (flags & CONTAINER_FLAG_INDEX) != 0,
+                                           offset, length);
+    }
+    unmap_infile();
+    close_outfile();
+    close_infile();
+
+    if (!valid)
+    {
+        report_format_error_and_exit("Fehlerhafte Daten in der Eingabedatei.");
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: huffman_check_header
+ * ------------------------------------------------------------------------ */
+extern bool huffman_check_header(const unsigned char header[])
+{
+    /* Die Wörter stehen wie bei write_int mit dem höchstwertigen Byte zuerst */
+    unsigned int first_word = (unsigned int) header[0] << 24 
+                              | (unsigned int) header[1] << 16
+                              | (unsigned int) header[2] << 8 | header[3];
+    unsigned int second_word = (unsigned int) header[4] << 24 
+                               | (unsigned int) header[5] << 16
+                               | (unsigned int) header[6] << 8 | header[7];
+
+    if (first_word == CONTAINER_MAGIC && (second_word >> 24) != FORMAT_LEGACY)
+    {
+        return (second_word >> 24) <= FORMAT_DICTIONARY
+               && ((second_word >> 16) & 0xFF) <= CONTAINER_VERSION;
+    }
+
+    return second_word <= MAX_CHARACTERS;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_legacy
+ * ------------------------------------------------------------------------ */
+static void decompress_legacy(unsigned long long all_characters,
+                              unsigned int different_characters,
+                              char *out_filename, bool large)
+{
+    /* Tabelle mit Häufigkeiten der vorhandenen Zeichen. */
+    unsigned long long frequencys[MAX_CHARACTERS];
+    /* Der Huffman-Baum zum Entschlüsseln der Daten. */
+    HUFFTREE *hufftree;
+
+    if (different_characters > MAX_CHARACTERS)
+    {
+        report_format_error_and_exit("Ungueltige Anzahl von Zeichen im Header.");
+    }
+
+    profile_begin(PROFILE_HEADER);
+    read_fileheader(frequencys, different_characters, large);
+    profile_end();
+
+    profile_begin(PROFILE_TREE);
+    hufftree = hufftree_create(frequencys);
+    profile_end();
+
+    open_outfile(out_filename);
+    decompress_characters(hufftree, all_characters);
+
+    /* Freigeben des Baums mit allen Knoten */
+    hufftree_destroy(&hufftree);
+
+    profile_begin(PROFILE_FLUSH);
+    close_outfile();
+    profile_end();
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_large
+ * ------------------------------------------------------------------------ */
+static void decompress_large(char *out_filename)
+{
+    unsigned long long all_characters;
+    unsigned long long different_characters;
+
+    profile_begin(PROFILE_HEADER);
+    all_characters = read_varint();
+    different_characters = read_varint();
+    profile_end();
+
+    if (different_characters > MAX_CHARACTERS)
+    {
+        report_format_error_and_exit("Ungueltige Anzahl von Zeichen im Header.");
+    }
+
+    decompress_legacy(all_characters, (unsigned int) different_characters,
+                      out_filename, true);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_dictionary
+ * ------------------------------------------------------------------------ */
+static void decompress_dictionary(char *out_filename, unsigned int id)
+{
+    unsigned long long all_characters;
+
+    if (options.dictionary == NULL)
+    {
+        report_format_error_and_exit(
+                "Woerterbuch der Datei fehlt (Option -D).");
+    }
+    if (options.dictionary->id != id)
+    {
+        report_format_error_and_exit(
+                "Datei wurde mit einem anderen Woerterbuch komprimiert.");
+    }
+
+    profile_begin(PROFILE_HEADER);
+    all_characters = read_varint();
+    profile_end();
+
+    open_outfile(out_filename);
+    profile_begin(PROFILE_CODING);
+    decompress_characters_table(options.dictionary->table, all_characters);
+    profile_end();
+
+    profile_begin(PROFILE_FLUSH);
+    close_outfile();
+    profile_end();
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: get_encoded_size
+ * ------------------------------------------------------------------------ */
+static unsigned long long get_encoded_size(
+        const unsigned long long frequencys[], const HUFF_CODE code_table[],
+        unsigned int different_characters, unsigned long long all_characters,
+        const CANONICAL_CODE *canon)
+{
+    unsigned char buffer[CANONICAL_MAX_HEADER_SIZE];
+    unsigned long long header_size;
+    unsigned long long bits = 0;
+    int i;
+
+    if (canon != NULL)
+    {
+        header_size = 8 + store_varint(all_characters, buffer)
+                    + canonical_store_header(canon, buffer);
+    }
+    else if (options.format == FORMAT_DICTIONARY)
+    {
+        header_size = 8 + store_varint(all_characters, buffer);
+    }
+    else if (all_characters > UINT_MAX)
+    {
+        header_size = 8 + store_varint(all_characters, buffer)
+                    + store_varint(different_characters, buffer);
+        for (i = 0; i < MAX_CHARACTERS; i++)
+        {
+            if (frequencys[i] != 0)
+            {
+                header_size += 1 + store_varint(frequencys[i], buffer);
+            }
+        }
+    }
+    else
+    {
+        header_size = 8 + 5ull * different_characters;
+    }
+
+    /* Jedes Zeichen belegt die Länge seines Codes, das letzte Byte wird 
+     * mit 0-Bits aufgefüllt */
+    for (i = 0; i < MAX_CHARACTERS; i++)
+    {
+        bits += frequencys[i] * code_table[i].length;
+    }
+
+    return header_size + (bits + 7) / 8;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: get_stored_size
+ * ------------------------------------------------------------------------ */
+static unsigned long long get_stored_size(unsigned long long size)
+{
+    unsigned char buffer[MAX_VARINT_SIZE];
+
+    return 8 + store_varint(size, buffer) + size;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: compress_stored
+ * ------------------------------------------------------------------------ */
+static void compress_stored(const unsigned char data[], size_t size)
+{
+    profile_begin(PROFILE_HEADER);
+    write_container_header(FORMAT_STORED);
+    write_varint(size);
+    profile_end();
+
+    profile_begin(PROFILE_CODING);
+    write_bytes(data, size);
+    profile_end();
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_stored
+ * ------------------------------------------------------------------------ */
+static void decompress_stored(char *out_filename)
+{
+    unsigned char buffer[IO_BUFFER_SIZE];
+    unsigned long long remaining;
+    size_t wanted;
+    size_t got;
+
+    profile_begin(PROFILE_HEADER);
+    remaining = read_varint();
+    profile_end();
+
+    open_outfile(out_filename);
+
+    profile_begin(PROFILE_CODING);
+    while (remaining > 0)
+    {
+        wanted = (remaining < IO_BUFFER_SIZE) ? (size_t) remaining
+                                              : IO_BUFFER_SIZE;
+        got = read_bytes(buffer, wanted);
+        write_bytes(buffer, got);
+        if (got < wanted)
+        {
+            report_format_error_and_exit("Unvollstaendige gespeicherte Daten.");
+        }
+        remaining -= got;
+    }
+    profile_end();
+
+    profile_begin(PROFILE_FLUSH);
+    close_outfile();
+    profile_end();
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_canonical
+ * ------------------------------------------------------------------------ */
+static void decompress_canonical(char *out_filename, bool has_index)
+{
+    /* Anzahl der Zeichen der Ausgangsdatei */
+    unsigned long long all_characters;
+    /* Der kanonische Code zum Entschlüsseln der Daten. */
+    CANONICAL_CODE canon;
+    /* Dekodiertabelle des Codes */
+    DECODE_TABLE *table;
+    /* Anzahl der Sprungmarken des Sprungindex */
+    unsigned long long marks;
+
+    profile_begin(PROFILE_HEADER);
+    all_characters = read_varint();
+    if (!canonical_read_header(&canon)
+        || (all_characters > 0 && canon.symbol_count == 0))
+    {
+        report_format_error_and_exit("Ungueltige Codelaengen im Header.");
+    }
+
+    /* Der Sprungindex wird beim vollständigen Dekomprimieren übersprungen */
+    if (has_index)
+    {
+        (void) read_varint();
+        for (marks = read_varint(); marks > 0; marks--)
+        {
+            (void) read_varint();
+        }
+    }
+    profile_end();
+
+    profile_begin(PROFILE_CODES);
+    table = create_canonical_table(&canon);
+    profile_end();
+
+    /* Sind Codes zu lang für die Dekodiertabelle, wird über die ersten 
+     * Codes je Codelänge dekodiert */
+    open_outfile(out_filename);
+    profile_begin(PROFILE_CODING);
+    if (table != NULL)
+    {
+        decompress_characters_table(table, all_characters);
+        decode_table_destroy(&table);
+    }
+    else
+    {
+        decompress_characters_canonical(&canon, all_characters);
+    }
+    profile_end();
+
+    profile_begin(PROFILE_FLUSH);
+    close_outfile();
+    profile_end();
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: write_seek_index
+ * ------------------------------------------------------------------------ */
+static void write_seek_index(const unsigned char data[], size_t size,
+                             const HUFF_CODE code_table[])
+{
+    size_t interval = options.index_interval;
+    size_t marks = (size > 0) ? (size - 1) / interval : 0;
+    unsigned long long bits;
+    size_t i;
+    size_t k;
+
+    write_varint(interval);
+    write_varint(marks);
+
+    /* Je Sprungmarke die Bits der Codes seit der vorigen Sprungmarke */
+    for (k = 0; k < marks; k++)
+    {
+        bits = 0;
+        for (i = k * interval; i < (k + 1) * interval; i++)
+        {
+            bits += code_table[data[i]].length;
+        }
+        write_varint(bits);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_range_stored
+ * ------------------------------------------------------------------------ */
+static bool decompress_range_stored(const unsigned char data[], size_t size,
+                                    unsigned long long offset,
+                                    unsigned long long length)
+{
+    unsigned long long all_characters;
+    size_t pos;
+
+    pos = load_varint(data, size, &all_characters);
+    if (pos == 0 || all_characters > size - pos)
+    {
+        return false;
+    }
+
+    /* Der Bereich wird auf das Ende der Daten beschränkt */
+    offset = (offset < all_characters) ? offset : all_characters;
+    length = (length < all_characters - offset) ? length 
+                                                : all_characters - offset;
+
+    write_bytes(data + pos + offset, (size_t) length);
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_range_canonical
+ * ------------------------------------------------------------------------ */
+static bool decompress_range_canonical(const unsigned char data[], 
+                                       size_t size, bool has_index,
+                                       unsigned long long offset,
+                                       unsigned long long length)
+{
+    CANONICAL_CODE canon;
+    unsigned long long all_characters;
+    unsigned long long interval = 0;
+    unsigned long long marks = 0;
+    unsigned long long bits;
+    /* Position und Bitposition der letzten Sprungmarke vor offset */
+    unsigned long long start = 0;
+    unsigned long long start_bit = 0;
+    unsigned long long k;
+    DECODE_TABLE *table;
+    size_t pos;
+    size_t used;
+    bool valid;
+
+    used = load_varint(data, size, &all_characters);
+    pos = used;
+    if (used > 0)
+    {
+        used = canonical_load_header(&canon, data + pos, size - pos);
+        pos += used;
+    }
+    if (used == 0 || (all_characters > 0 && canon.symbol_count == 0))
+    {
+        return false;
+    }
+
+    /* Der Bereich wird auf das Ende der Daten beschränkt */
+    offset = (offset < all_characters) ? offset : all_characters;
+    length = (length < all_characters - offset) ? length 
+                                                : all_characters - offset;
+
+    if (has_index)
+    {
+        used = load_varint(data + pos, size - pos, &interval);
+        pos += used;
+        if (used > 0)
+        {
+            used = load_varint(data + pos, size - pos, &marks);
+            pos += used;
+        }
+        if (used == 0 || interval == 0 || marks > size - pos)
+        {
+            return false;
+        }
+
+        /* Alle Sprungmarken werden gelesen, da der Bitstrom erst nach dem
+         * Index beginnt */
+        for (k = 1; k <= marks; k++)
+        {
+            used = load_varint(data + pos, size - pos, &bits);
+            pos += used;
+            if (used == 0)
+            {
+                return false;
+            }
+            if (k * interval <= offset)
+            {
+                start = k * interval;
+                start_bit += bits;
+            }
+        }
+    }
+
+    table = create_canonical_table(&canon);
+    valid = decode_canonical_range(&canon, table, data + pos, size - pos, 
+                                   start_bit, offset - start, length);
+    decode_table_destroy(&table);
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: create_canonical_table
+ * ------------------------------------------------------------------------ */
+static DECODE_TABLE *create_canonical_table(const CANONICAL_CODE *canon)
+{
+    HUFF_CODE codes[MAX_CHARACTERS];
+
+    if (canon->max_length > DECODE_MAX_CODE_LENGTH)
+    {
+        return NULL;
+    }
+    canonical_get_codes(canon, codes);
+
+    return decode_table_create(codes);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_canonical_range
+ * ------------------------------------------------------------------------ */
+static bool decode_canonical_range(const CANONICAL_CODE *canon,
+                                   const DECODE_TABLE *table,
+                                   const unsigned char in[], size_t in_size,
+                                   unsigned long long bit_offset,
+                                   unsigned long long skip,
+                                   unsigned long long count)
+{
+    /* Die noch nicht ausgewerteten Bits der Eingabe, linksbündig */
+    unsigned long long bit_buffer = 0;
+    /* Anzahl der gültigen Bits im Bitpuffer */
+    int bit_count = 0;
+    /* bereits verbrauchte Bits im ersten Byte */
+    int first_bits = (int) (bit_offset & 7);
+    size_t in_pos;
+    /* Anzahl der Bits, die ein Schritt höchstens verbraucht */
+    int max_bits = (table != NULL) ? DECODE_MAX_CODE_LENGTH 
+                                   : (int) canon->max_length;
+    const DECODE_ENTRY *entry;
+    unsigned int length;
+    /* in einem Schritt dekodierte Zeichen und deren Anzahl */
+    unsigned char symbols[2] = {0, 0};
+    unsigned int decoded;
+    unsigned int i;
+    /* dekodierte Zeichen, die gesammelt geschrieben werden */
+    unsigned char out[IO_BUFFER_SIZE];
+    size_t out_pos = 0;
+
+    if (skip + count == 0)
+    {
+        return true;
+    }
+    if ((bit_offset >> 3) >= in_size)
+    {
+        return false;
+    }
+    in_pos = (size_t) (bit_offset >> 3);
+
+    while (skip + count > 0)
+    {
+        /* Am Ende des Bitstroms wird mit 0-Bits aufgefüllt */
+        if (bit_count < max_bits + first_bits)
+        {
+            while (bit_count <= 56 && in_pos < in_size)
+            {
+                bit_buffer |= (unsigned long long) in[in_pos++] 
+                              << (56 - bit_count);
+                bit_count += 8;
+            }
+            bit_buffer <<= first_bits;
+            bit_count -= first_bits;
+            first_bits = 0;
+        }
+
+        if (table != NULL)
+        {
+            length = 0;
+            entry = &table->entries[bit_buffer >> (64 - DECODE_PRIMARY_BITS)];
+            if (entry->count == DECODE_LINK)
+            {
+                /* langer Code: die folgenden Bits indizieren die 
+                 * Sekundärtabelle */
+                length = DECODE_PRIMARY_BITS;
+                entry = &table->entries[entry->link 
+                        + ((bit_buffer << DECODE_PRIMARY_BITS) 
+                           >> (64 - entry->bits))];
+            }
+            length += entry->bits;
+            decoded = (entry->count == DECODE_INVALID) ? 0 : entry->count;
+            symbols[0] = entry->symbols[0];
+            symbols[1] = entry->symbols[1];
+
+            /* Das zweite Zeichen eines Paares darf am Ende in die 
+             * aufgefüllten Bits reichen, wenn es nicht mehr benötigt wird */
+            if (decoded == 2 && (int) length > bit_count 
+                && skip + count == 1)
+            {
+                decoded = 1;
+                length = (unsigned int) bit_count;
+            }
+        }
+        else
+        {
+            length = canonical_decode(canon, bit_buffer, &symbols[0]);
+            decoded = (length > 0) ? 1 : 0;
+        }
+
+        if (decoded == 0 || (int) length > bit_count)
+        {
+            return false;
+        }
+        bit_buffer <<= length;
+        bit_count -= (int) length;
+
+        for (i = 0; i < decoded && skip + count > 0; i++)
+        {
+            if (skip > 0)
+            {
+                skip--;
+            }
+            else
+            {
+                if (out_pos == IO_BUFFER_SIZE)
+                {
+                    write_bytes(out, out_pos);
+                    out_pos = 0;
+                }
+                out[out_pos++] = symbols[i];
+                count--;
+            }
+        }
+    }
+
+    write_bytes(out, out_pos);
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: compress_blocks
+ * ------------------------------------------------------------------------ */
+static void compress_blocks(const unsigned char data[], size_t size,
+                            char *out_filename)
+{
+    profile_begin(PROFILE_HEADER);
+    open_outfile(out_filename);
+    write_container_header(FORMAT_BLOCKS);
+    profile_end();
+
+    profile_begin(PROFILE_CODING);
+    block_compress(data, size, options.block_size, get_block_code_length(), 
+                   options.streams, options.threads);
+    profile_end();
+
+    profile_begin(PROFILE_FLUSH);
+    close_outfile();
+    profile_end();
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_blocks
+ * ------------------------------------------------------------------------ */
+static void decompress_blocks(char *in_filename, char *out_filename,
+                              unsigned int streams)
+{
+    const unsigned char *data;
+    size_t size;
+    bool valid;
+
+    profile_begin(PROFILE_READ);
+    data = load_container_body(in_filename, &size);
+    profile_end();
+
+    open_outfile(out_filename);
+    profile_begin(PROFILE_CODING);
+    valid = block_decompress(data, size, streams, options.threads);
+    profile_end();
+
+    profile_begin(PROFILE_FLUSH);
+    unmap_infile();
+    close_outfile();
+    profile_end();
+
+    if (!valid)
+    {
+        report_format_error_and_exit("Fehlerhafte Bloecke in der Eingabedatei.");
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: compress_transform
+ * ------------------------------------------------------------------------ */
+static void compress_transform(const unsigned char data[], size_t size,
+                               char *out_filename)
+{
+    unsigned char *transformed;
+    size_t transformed_size;
 
-#include "huffman_common.h"
-#include "io.h"
-#include "frequency.h"
-#include "huffman.h"
+    profile_begin(PROFILE_CODING);
+    transformed = transform_forward(data, size, options.transforms,
+                                    options.transform_block_size,
+                                    options.threads, &transformed_size);
+    profile_end();
 
-#include "limits.h"
+    profile_begin(PROFILE_HEADER);
+    open_outfile(out_filename);
+    write_container_header(FORMAT_TRANSFORM);
+    write_char((unsigned char) options.transforms);
+    write_varint(size);
+    write_varint(options.transform_block_size);
+    profile_end();
+
+    profile_begin(PROFILE_CODING);
+    block_compress(transformed, transformed_size, options.block_size, 
+                   get_block_code_length(), options.streams, options.threads);
+    profile_end();
+
+    profile_begin(PROFILE_FLUSH);
+    close_outfile();
+    free(transformed);
+    profile_end();
+}
 
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_transform
+ * ------------------------------------------------------------------------ */
+static void decompress_transform(char *in_filename, char *out_filename,
+                                 unsigned int streams)
+{
+    const unsigned char *data;
+    size_t size;
+    unsigned int transforms = 0;
+    unsigned long long all_characters = 0;
+    unsigned long long block_size = 0;
+    unsigned char *transformed = NULL;
+    size_t transformed_size;
+    unsigned char *plain = NULL;
+    size_t pos = 1;
+    size_t used = 0;
+
+    profile_begin(PROFILE_READ);
+    data = load_container_body(in_filename, &size);
+    profile_end();
+
+    profile_begin(PROFILE_CODING);
+    if (size > 0)
+    {
+        transforms = data[0];
+        used = load_varint(data + pos, size - pos, &all_characters);
+        pos += used;
+    }
+    if (used > 0)
+    {
+        used = load_varint(data + pos, size - pos, &block_size);
+        pos += used;
+    }
+    if (used > 0 && all_characters <= (size_t) -1 
+        && block_decompress_memory(data + pos, size - pos, streams, 
+                                   options.threads, &transformed, 
+                                   &transformed_size))
+    {
+        plain = transform_inverse(transformed, transformed_size, transforms,
+                                  (size_t) block_size, 
+                                  (size_t) all_characters);
+        free(transformed);
+    }
+    unmap_infile();
+    profile_end();
 
-/* ===========================================================================
- * Makros
- * ======================================================================== */
+    if (plain == NULL)
+    {
+        report_format_error_and_exit("Fehlerhafte Daten in der Eingabedatei.");
+    }
 
-/** 
- * Anzahl der möglichen Zeichen, welche in einer Datei vorkommen können. 
- */
-#define MAX_CHARACTERS 256
+    open_outfile(out_filename);
+    profile_begin(PROFILE_FLUSH);
+    write_bytes(plain, (size_t) all_characters);
+    close_outfile();
+    free(plain);
+    profile_end();
+}
 
-/**
- * Die Länge der Huffman-Codes wird auf maximal 50 festgelegt
- * ToDo: Die Begrenzung auf eine bestimmte Länge aufheben 
- */
-#define CODE_LENGTH 50
+/* ---------------------------------------------------------------------------
+ * Funktion: load_container_body
+ * ------------------------------------------------------------------------ */
+static const unsigned char *load_container_body(char *in_filename, 
+                                                size_t *size)
+{
+    const unsigned char *data;
 
+    /* Die Standardeingabe kann nicht erneut geöffnet werden, von ihr ist 
+     * nur noch der Rest nach dem Container-Header zu lesen */
+    if (strcmp(in_filename, STDIO_FILENAME) == 0)
+    {
+        return read_infile_rest(size);
+    }
 
-/* ===========================================================================
- * Funktionsprototypen
- * ======================================================================== */
+    data = map_infile(in_filename, size);
+    if (*size < 8)
+    {
+        unmap_infile();
+        report_format_error_and_exit("Unvollstaendiger Container-Header.");
+    }
+    *size -= 8;
 
-/**
- * Komprimiert die Zeichen eines Eingabestroms mit den in der Code-Tabelle 
- * übergebebenen Codes und schreibt die Kompromierung bitweise in die 
- * Ausgabedatei.
- * 
- * @param code_table    Code-Tabelle, die für alle Zeichen des Eingabestroms 
- *                      einen Code für die Komprimierung enthält.
- */
-static void compress_characters(char code_table[][CODE_LENGTH]);
+    return data + 8;
+}
 
-/**
- * Dekomprimiert die Bits des Eingabestroms anhand des übergebebenen 
- * Huffman-Baums und schreibt die dekomprimierten Zeichen in den Ausgabestrom.
- * 
- * @param hufftree      Huffman-Baum für die Dekomprimierung
- * @param used_bits     Anzahl der benutzten Bits im letzten Byte
- */
-static void decompress_characters(BTREE *hufftree, unsigned int used_bits);
+/* ---------------------------------------------------------------------------
+ * Funktion: compress_stream
+ * ------------------------------------------------------------------------ */
+static void compress_stream(char *in_filename, char *out_filename)
+{
+    open_infile(in_filename);
+    open_outfile(out_filename);
+    write_container_header(FORMAT_STREAM);
 
-/**
- * Vergleicht 2 Binärbäume miteinander. Dazu werden die Häufigkeiten der in 
- * der Wurzel enthaltenen CharFrequencys verglichen.
- * 
- * @param tree1 Der erste der zu vergleichenden Bäume.
- * @param tree2 Der zweite der zu vergleichenden Bäume.
- * @return      Die Funktion gibt true zurück, wenn die Häufigkeit im ersten
- *              Baum kleiner der im zweiten Baum ist, und false sonst.
- */
-static int compare_trees(BTREE *tree1, BTREE *tree2);
+    /* Lesen, Kodieren und Schreiben sind verschränkt */
+    profile_begin(PROFILE_CODING);
+    block_compress_stream(options.block_size, get_block_code_length(),
+                          options.streams, options.threads);
+    profile_end();
 
-/**
- * Zählt die Anzahl der Zeichen, die Anzahl der unterschiedlichen Zeichen und 
- * die Häufigkeiten der einzelnen Zeichen in einer Datei.
- * 
- * @param source_filename       Name der Datei, in der die Häufigkeiten
- *                              gezählt werden sollen.
- * @param frequencys            Array, in das die Häufigkeiten der Zeichen
- *                              geschrieben werden sollen.
- * @param all_characters        Anzahl aller Zeichen
- * @param different_characters  Anzahl unterschiedlicher Zeichen
- */
-static void count_frequencys(char *source_filename,
-                             unsigned int frequencys[],
-                             unsigned int *all_characters,
-                             unsigned int *different_characters);
+    profile_begin(PROFILE_FLUSH);
+    close_infile();
+    close_outfile();
+    profile_end();
+}
 
-/**
- * Erzeugt einen Huffman-Baum aus den Häufigkeiten von Zeichen.
- * 
- * @param frequencys    Ein Array mit den Häufigkeiten von Zeichen in
- *                      der zu komprimierenden Datei.
- * @return              Ein Pointer auf den erzeugten Huffman-Baum. Der Aufrufer
- *                      dieser Funktion muss sich selbst darum kümmern, dass der
- *                      Speicher für die BTree-Struktur wieder freigegeben wird.
- */
-static BTREE *build_hufftree(unsigned int frequencys[]);
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_stream
+ * ------------------------------------------------------------------------ */
+static void decompress_stream(char *out_filename, unsigned int streams)
+{
+    bool valid;
 
-/**
- * Erzeugt aus einem Huffman-Baum eine Code-Tabelle, welche die 
- * Kodierungs-Vorschrift für die Komprimierung einer Datei darstellt.
- * 
- * @param hufftree      Huffman-Baum, aus dem die Code-Tabelle erzeugt
- *                      werden soll
- * @param code_table    Das 2-dimensionale Array, in welches die Codes 
- *                      (Strings) geschrieben werden.
- */
-static void build_code_table(BTREE *hufftree, char code_table[][CODE_LENGTH]);
+    open_outfile(out_filename);
+    profile_begin(PROFILE_CODING);
+    valid = block_decompress_stream(streams, options.threads);
+    profile_end();
 
-/**
- * Rekursive Erzeugung eines Code anhand des Pfads von einem Knoten im 
- * Huffman-Baum bis zu einem Blatt. Der Code wird um "0" verlängert, wenn der 
- * Pfad über den linken Teilbaum geht und mit "1" sonst. Bei Erreichen eines 
- * Blatts wird der Code in die Code-Tabelle eingetragen.
- * 
- * @param huffnode      Ein Knoten des Huffman-Baums, von dem ausgehend
- *                      der Code verlängert werden soll.
- * @param current_code  Der bislang erzeugte Code.
- * @param code_table    Die Tabelle mit den Binär-Codes für die
- *                      Komprimierung.
- */
-static void build_code_table_rek(BTREE_NODE *huffnode, 
-                                 char *current_code,
-                                 char code_table[][CODE_LENGTH]);
+    profile_begin(PROFILE_FLUSH);
+    close_outfile();
+    profile_end();
 
-/**
- * Schreibt die Informationen, welche zur Dekomprimierung benötigt werden, 
- * in die Ausgabedatei, die zuvor mit open_outfile geöffnet worden sein muss.
- * 
- * @param all_characters        Anzahl aller Zeichern der Eingabedatei
- * @param different_characters  Anzahl verschiedener Zeichen der Eingabedatei
- * @param frequencys            Ein Array mit den Häufigkeiten von Zeichen in
- *                              der zu komprimierenden Datei.
- */
-static void write_fileheader(unsigned int all_characters,
-                             unsigned int different_characters,
-                             unsigned int frequencys[]);
+    if (!valid)
+    {
+        report_format_error_and_exit("Fehlerhafte Bloecke in der Eingabedatei.");
+    }
+}
 
-/**
- * Liest die Informationen, welche zur Dekomprimierung benötigt werden, aus 
- * einer Datei. Die bitaccess-Struktur muss bereits initialisiert sein und
- * auf den Anfang einer geöffneten Datei zeigen.
- * 
- * @param frequencys    Ein Array mit den Häufigkeiten von Zeichen in
- *                      der zu komprimierenden Datei.
- * @param used_bits     Beschreibt, wie viele Bits im letzten Byte der
- *                      Datei noch mit gültigen Informationen gefüllt sind
- */
-static void read_fileheader(unsigned int frequencys[],
-                            unsigned int *used_bits);
+/* ---------------------------------------------------------------------------
+ * Funktion: compress_adaptive
+ * ------------------------------------------------------------------------ */
+static void compress_adaptive(char *in_filename, char *out_filename)
+{
+    open_infile(in_filename);
+    open_outfile(out_filename);
+    write_container_header(FORMAT_ADAPTIVE);
 
+    /* Lesen, Kodieren und Schreiben sind verschränkt */
+    profile_begin(PROFILE_CODING);
+    adaptive_compress();
+    profile_end();
 
-/* ===========================================================================
- * Funktionsdefinitionen
- * ======================================================================== */
+    profile_begin(PROFILE_FLUSH);
+    close_infile();
+    close_outfile();
+    profile_end();
+}
 
 /* ---------------------------------------------------------------------------
- * Funktion: huffman_compress
+ * Funktion: decompress_adaptive
  * ------------------------------------------------------------------------ */
-extern void compress(char *in_filename, char *out_filename)
+static void decompress_adaptive(char *out_filename)
 {
-    /* Häufigkeiten der Zeichen in der Eingabedatei. */
-    unsigned int frequencys[MAX_CHARACTERS];
-    /* Huffman-Baum */
-    BTREE *hufftree;
-    /* Tabelle mit Huffman-Binärcodes zum Kodieren der Zeichen */
-    char code_table[MAX_CHARACTERS][CODE_LENGTH];
-    /* Größe der Eingabedatei */
-    unsigned int all_characters = 0;
-    /* Anzahl der unterschiedlichen Zeichen in der Eingabedatei */
-    unsigned int different_characters = 0;
+    bool valid;
 
-    count_frequencys(in_filename, frequencys, &all_characters, &different_characters);
-
-    hufftree = build_hufftree(frequencys);
+    open_outfile(out_filename);
+    profile_begin(PROFILE_CODING);
+    valid = adaptive_decompress();
+    profile_end();
 
-    build_code_table(hufftree, code_table);
+    profile_begin(PROFILE_FLUSH);
+    close_outfile();
+    profile_end();
 
-    /* Freigeben des Baum und der enthaltenen Daten. */
-    btree_destroy(&hufftree, true);
+    if (!valid)
+    {
+        report_format_error_and_exit("Unerwartetes Ende der Eingabedatei.");
+    }
+}
 
-    /* Zieldatei zum bitweisen Schreiben öffnen */
-    open_infile(in_filename);
+/* ---------------------------------------------------------------------------
+ * Funktion: compress_context
+ * ------------------------------------------------------------------------ */
+static void compress_context(const unsigned char data[], size_t size,
+                             char *out_filename)
+{
     open_outfile(out_filename);
+    write_container_header(FORMAT_CONTEXT);
+    context_compress(data, size, options.max_code_length);
 
-    write_fileheader(all_characters, different_characters, frequencys);
-    compress_characters(code_table);
-
-    /* Schließen der Quell- und Zieldatei */
-    close_infile();
+    profile_begin(PROFILE_FLUSH);
     close_outfile();
+    profile_end();
 }
 
 /* ---------------------------------------------------------------------------
- * Funktion: compress_characters
+ * Funktion: decompress_context
  * ------------------------------------------------------------------------ */
-static void compress_characters(char code_table[][CODE_LENGTH])
+static void decompress_context(char *in_filename, char *out_filename)
 {
-    /* aktuell gelesenes Zeichen */
-    unsigned char next_character;
-    /* Zahldarstellung des aktuell gelesenen Zeichens */
-    unsigned int int_code;
+    const unsigned char *data;
+    size_t size;
+    bool valid;
 
-    unsigned short used_bits = 0;
+    profile_begin(PROFILE_READ);
+    data = load_container_body(in_filename, &size);
+    profile_end();
 
-    /* Laufvariable */
-    unsigned int i;
+    open_outfile(out_filename);
+    valid = context_decompress(data, size);
 
-    SPRINT("Schreibe Binaerdaten...\n");
+    profile_begin(PROFILE_FLUSH);
+    unmap_infile();
+    close_outfile();
+    profile_end();
 
-    /* Schreibe die kodierten Daten in die Datei. */
-    while (has_next_char())
+    if (!valid)
     {
-        next_character = (unsigned char) read_char();
+        report_format_error_and_exit("Fehlerhafte Daten in der Eingabedatei.");
+    }
+}
 
-        /* Schreibe den Code des gelesenen Zeichens in die Datei. */
-        int_code = (unsigned int) next_character;
-        for (i = 0; i < ((unsigned int) strlen(code_table[int_code])); i++)
-        {
-            write_bit((unsigned int) code_table[int_code][i] - '0');
-            used_bits = (used_bits + 1) % 8;
-        }
+/* ---------------------------------------------------------------------------
+ * Funktion: get_block_code_length
+ * ------------------------------------------------------------------------ */
+static unsigned int get_block_code_length(void)
+{
+    return (options.max_code_length < DECODE_MAX_CODE_LENGTH)
+            ? options.max_code_length
+            : DECODE_MAX_CODE_LENGTH;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: write_container_header
+ * ------------------------------------------------------------------------ */
+static void write_container_header(FORMAT format)
+{
+    unsigned int flags = 0;
+
+    if ((format == FORMAT_BLOCKS || format == FORMAT_STREAM 
+         || format == FORMAT_TRANSFORM) && options.streams == DECODE_STREAMS)
+    {
+        flags |= CONTAINER_FLAG_STREAMS;
+    }
+
+    if (format == FORMAT_CANONICAL && options.index_interval > 0)
+    {
+        flags |= CONTAINER_FLAG_INDEX;
     }
 
-    /* Letztes Byte mit 0-Bits auffüllen */
-    /* wird von io.h übernommen
-    while (used_bits < 8)
+    /* Im Format mit Wörterbuch stehen statt der Flags dessen Kennung */
+    if (format == FORMAT_DICTIONARY)
     {
-        write_bit(0);
-        used_bits++;
+        flags = options.dictionary->id;
     }
-     */
+
+    write_int(CONTAINER_MAGIC);
+    write_int(((unsigned int) format << 24) | (CONTAINER_VERSION << 16) 
+              | flags);
 }
 
 /* ---------------------------------------------------------------------------
- * Funktion: huffman_decompress
+ * Funktion: check_container_header
  * ------------------------------------------------------------------------ */
-extern void decompress(char *in_filename, char *out_filename)
+static unsigned int check_container_header(unsigned int second_word)
 {
-    /* Benutzte Bits im letzten Byte der Datei. */
-    unsigned int all_characters = 0;
-    /* Tabelle mit Häufigkeiten der vorhandenen Zeichen. */
-    unsigned int frequencys[MAX_CHARACTERS];
-    /* Der Huffman-Baum zum Entschlüsseln der Daten. */
-    BTREE *hufftree;
-
-    /* Quelldatei zum bitweisen Zugriff öffnen */
-    open_infile(in_filename);
+    if (((second_word >> 16) & 0xFF) > CONTAINER_VERSION)
+    {
+        report_format_error_and_exit("Unbekannte Version des Formats.");
+    }
+    if ((FORMAT) (second_word >> 24) != FORMAT_DICTIONARY
+        && (second_word & 0xFFFF 
+            & ~(CONTAINER_FLAG_STREAMS | CONTAINER_FLAG_INDEX)) != 0)
+    {
+        report_format_error_and_exit("Unbekannte Flags im Format.");
+    }
 
-    read_fileheader(frequencys, &all_characters);
+    return second_word & 0xFFFF;
+}
 
-    hufftree = build_hufftree(frequencys);
+/* ---------------------------------------------------------------------------
+ * Funktion: report_format_error_and_exit
+ * ------------------------------------------------------------------------ */
+static void report_format_error_and_exit(const char *message)
+{
+    fprintf(stderr, "[ERROR]: %s\n", message);
+    exit(EXIT_DC_ERROR);
+}
 
-    open_outfile(out_filename);
-    decompress_characters(hufftree, all_characters);
+/* ---------------------------------------------------------------------------
+ * Funktion: decompress_characters
+ * ------------------------------------------------------------------------ */
+static void decompress_characters(const HUFFTREE *hufftree, 
+                                  unsigned long long all_characters)
+{
+    /* Codes der Zeichen und daraus erzeugte Dekodiertabelle */
+    HUFF_CODE codes[MAX_CHARACTERS];
+    DECODE_TABLE *table = NULL;
+    unsigned int threads = (options.threads == 0) 
+                           ? threadpool_get_processors() 
+                           : options.threads;
+    bool valid;
+
+    if (options.decoder == DECODER_TABLE)
+    {
+        profile_begin(PROFILE_CODES);
+        hufftree_get_codes(hufftree, codes);
+        table = decode_table_create(codes);
+        profile_end();
+    }
 
-    /* Freigeben des Baum und der enthaltenen Daten. */
-    btree_destroy(&hufftree, true);
+    /* Sind Codes zu lang für die Dekodiertabelle, wird der Baum verwendet */
+    profile_begin(PROFILE_CODING);
+    if (table != NULL && threads > 1)
+    {
+        /* Ohne Index wird der Bitstrom spekulativ in Abschnitten dekodiert */
+        valid = speculative_decode(table, codes, all_characters, threads);
+        decode_table_destroy(&table);
 
-    close_infile();
-    close_outfile();
+        if (!valid)
+        {
+            report_format_error_and_exit("Ungueltiger Code in der Eingabedatei.");
+        }
+    }
+    else if (table != NULL)
+    {
+        decompress_characters_table(table, all_characters);
+        decode_table_destroy(&table);
+    }
+    else
+    {
+        decompress_characters_tree(hufftree, all_characters);
+    }
+    profile_end();
 }
 
 /* ---------------------------------------------------------------------------
- * Funktion: decompress_characters
+ * Funktion: decompress_characters_tree
  * ------------------------------------------------------------------------ */
-static void decompress_characters(BTREE *hufftree, unsigned int all_characters)
+static void decompress_characters_tree(const HUFFTREE *hufftree,
+                                       unsigned long long all_characters)
 {
     /* Die Eingabe wird bitweise gelesen. Für jedes Bit wird im Huffmanbaum
      * von der Wurzel bis zu einem Blatt gewandert, bei einem 0-Bit jeweils in
@@ -270,290 +1863,218 @@ static void decompress_characters(BTREE *hufftree, unsigned int all_characters)
      * Das Zeichen des Blattes wird dann in die Ausgabedatei geschrieben.
      * Danach wird wieder bei der Wurzel begonnen. */
 
-    /* aktueller Knoten während des Durchlaufs durch den Huffmannbaum. */
-    BTREE_NODE *current_node;
+    /* Index des aktuellen Knotens während des Durchlaufs durch den Baum */
+    int current_node = hufftree->root;
     /* Daten des aktuellen Knotens */
-    FREQUENCY *cf;
-    /* aktuell gelesenes Bit. */
-    BIT current_bit = 0;
+    const HUFFTREE_NODE *node;
+    /* Kontext der Eingabedatei mit dem Bitfenster */
+    BITREADER *reader = get_infile_reader();
+    /* Kopie des Bitfensters, aus der die Bits des Codes entnommen werden */
+    unsigned long long bits;
+    /* Anzahl der aus der Kopie entnommenen Bits */
+    unsigned int used;
 
 #ifdef DEBUG
 
     printf("Dekomprimiere Binaerdaten...\n");
 #endif
 
-    current_node = btree_get_root(hufftree);
-
-    /* Bitweises Lesen, solange in der Eingabe noch ein Byte oder im letzten
-     * Byte noch belegte Bits vorhanden sind */
-
     while (all_characters > 0)
     {
-        current_bit = read_bit();
+        /* Statt jedes Bit einzeln zu lesen, wird der Baum mit den Bits des
+         * Fensters durchlaufen und erst am Blatt verbraucht. Ein Code, der
+         * länger als das Fenster ist, wird im nächsten Durchlauf ab dem
+         * erreichten Knoten fortgesetzt. Am Dateiende folgen 0-Bits. */
+        BITREADER_ENSURE_BITS(reader, BITREADER_MAX_BITS);
+        bits = reader->bit_window;
+        used = 0;
+
+        do
+        {
+            node = &hufftree->nodes[current_node];
+            current_node = ((bits >> 63) == 0) ? node->left : node->right;
+            bits <<= 1;
+            used++;
+
+            if (current_node == HUFFTREE_NONE)
+            {
+                report_format_error_and_exit("Ungueltiger Code in der Eingabedatei.");
+            }
+        } while (hufftree->nodes[current_node].left != HUFFTREE_NONE
+                 && used < BITREADER_MAX_BITS);
 
-        /* Die Daten des aktuellen Knotens im Binärbaum. */
-        cf = (FREQUENCY *) btreenode_get_data(current_node);
+        BITREADER_CONSUME_BITS(reader, used);
 
-        if (frequency_get_letter(cf) != NO_LETTER)
+        node = &hufftree->nodes[current_node];
+        if (node->left == HUFFTREE_NONE)
         {
-            /* Das entschlüsselte Zeichen in die Datei schreiben */
-            unsigned char character = (unsigned int) frequency_get_letter(cf);
-            write_char((unsigned char) character);
+            /* Das entschlüsselte Zeichen in die Datei schreiben und zur 
+             * Wurzel zurückkehren */
+            write_char(node->symbol);
             all_characters--;
-
-            /* zurückkehren zur Wurzel im Baum */
-            current_node = btree_get_root(hufftree);
+            current_node = hufftree->root;
         }
-
-        current_node = (current_bit == 0)
-                ? btreenode_get_left(current_node)
-                : btreenode_get_right(current_node);
     }
 }
 
 /* ---------------------------------------------------------------------------
- * Funktion: compare_trees
+ * Funktion: decompress_characters_table
  * ------------------------------------------------------------------------ */
-static int compare_trees(BTREE *tree1, BTREE *tree2)
+static void decompress_characters_table(const DECODE_TABLE *table,
+                                        unsigned long long all_characters)
 {
-    FREQUENCY *cf1 =
-            (FREQUENCY *) btreenode_get_data(btree_get_root(tree1));
+    /* Kontext der Eingabedatei mit dem Bitfenster */
+    BITREADER *reader = get_infile_reader();
+    /* aktueller Eintrag der Dekodiertabelle */
+    const DECODE_ENTRY *entry;
+    /* dekodierte Zeichen, die gesammelt geschrieben werden */
+    unsigned char out[IO_BUFFER_SIZE];
+    size_t out_pos = 0;
 
-    FREQUENCY *cf2 =
-            (FREQUENCY *) btreenode_get_data(btree_get_root(tree2));
+    SPRINT("Dekomprimiere Binaerdaten mit Dekodiertabelle...\n");
 
-    return (frequency_get_count(cf1) < frequency_get_count(cf2))
-            ? -1
-            : 1;
-}
+    while (all_characters > 0)
+    {
+        /* Ein Schritt verbraucht höchstens DECODE_MAX_CODE_LENGTH Bits. Am
+         * Dateiende wird mit 0-Bits aufgefüllt. */
+        BITREADER_ENSURE_BITS(reader, DECODE_MAX_CODE_LENGTH);
 
-/* ---------------------------------------------------------------------------
- * Funktion: count_frequencys
- * ------------------------------------------------------------------------ */
-static void count_frequencys(char *source_filename,
-                             unsigned int frequencys[],
-                             unsigned int *all_characters,
-                             unsigned int *different_characters)
-{
-    /* das aktuell gelesene Zeichen. */
-    unsigned char next_character;
+        entry = &table->entries[BITREADER_PEEK_BITS(reader, 
+                                                    DECODE_PRIMARY_BITS)];
 
-    /* Anzahl der Zeichen in der Datei */
-    (*all_characters) = 0;
+        if (entry->count == DECODE_LINK)
+        {
+            /* langer Code: die folgenden Bits indizieren die Sekundärtabelle */
+            BITREADER_CONSUME_BITS(reader, DECODE_PRIMARY_BITS);
+            entry = &table->entries[entry->link
+                                    + BITREADER_PEEK_BITS(reader, 
+                                                          entry->bits)];
+        }
 
-    open_infile(source_filename);
+        if (entry->count == DECODE_INVALID)
+        {
+            report_format_error_and_exit("Ungueltiger Code in der Eingabedatei.");
+        }
 
-    /* alle Felder in frequencys mit 0 initialisieren */
-    memset(frequencys, 0, MAX_CHARACTERS * sizeof (unsigned int));
+        BITREADER_CONSUME_BITS(reader, entry->bits);
 
-    /* Lese zeichenweise und zähle die Häufigkeiten der einzelnen Zeichen. */
-    while (has_next_char())
-    {
-        if ((*all_characters) == UINT_MAX)
+        if (out_pos > IO_BUFFER_SIZE - 2)
         {
-            printf("Fehler: Die Datei ist zu gross zum komprimieren.\n");
-            system("PAUSE");
-            exit(EXIT_SUCCESS);
+            write_bytes(out, out_pos);
+            out_pos = 0;
         }
 
-        next_character = (unsigned char) read_char();
-        frequencys[next_character]++;
+        out[out_pos++] = entry->symbols[0];
+        all_characters--;
 
-        (*all_characters)++;
-        if (frequencys[next_character] == 1)
+        if (entry->count == 2 && all_characters > 0)
         {
-            (*different_characters)++;
+            out[out_pos++] = entry->symbols[1];
+            all_characters--;
         }
     }
 
-    close_infile();
+    write_bytes(out, out_pos);
 }
 
 /* ---------------------------------------------------------------------------
- * Funktion: build_hufftree
+ * Funktion: decompress_characters_canonical
  * ------------------------------------------------------------------------ */
-static BTREE *build_hufftree(unsigned int frequencys[])
+static void decompress_characters_canonical(const CANONICAL_CODE *canon,
+                                            unsigned long long all_characters)
 {
-    /* Zahldarstellung des aktuellen Zeichens */
-    unsigned int int_code;
-    /* aktuelles Zeichen */
-    unsigned char character;
-    /* Daten für die Knoten des Huffman-Baums */
-    FREQUENCY *new_cf;
-    FREQUENCY *cf1;
-    FREQUENCY *cf2;
-    /* Binärbäume */
-    BTREE *new_tree;
-    BTREE *tree1 = NULL;
-    BTREE *tree2 = NULL;
-    /* Huffman-Baum */
-    BTREE *hufftree = NULL;
+    /* Kontext der Eingabedatei mit dem Bitfenster */
+    BITREADER *reader = get_infile_reader();
+    /* Länge des aktuell dekodierten Codes */
+    unsigned int length;
+    /* aktuell dekodiertes Zeichen */
+    unsigned char symbol = 0;
+    /* dekodierte Zeichen, die gesammelt geschrieben werden */
+    unsigned char out[IO_BUFFER_SIZE];
+    size_t out_pos = 0;
 
-    heap_init((HEAP_ELEM_COMP) compare_trees, (HEAP_ELEM_PRINT) btree_print);
-
-    /* Füge alle Häufigkeiten jeweils als Wurzel eines Binärbaumes in den
-     * Heap ein */
-    for (int_code = 0; int_code < MAX_CHARACTERS; int_code++)
+    while (all_characters > 0)
     {
-        if (frequencys[int_code] > 0)
-        {
-            character = (unsigned char) int_code;
-            new_cf = frequency_create(character, (int) frequencys[int_code]);
-            new_tree = btree_new(new_cf,
-                                 (DESTROY_DATA_FCT) frequency_destroy,
-                                 (PRINT_DATA_FCT) frequency_print);
-            heap_insert(new_tree);
-        }
-    }
+        BITREADER_ENSURE_BITS(reader, canon->max_length);
 
-    if (heap_get_size() == 0)
-    {
-        /* Heap ist leer, erzeuge leeren Baum */
-        hufftree = btree_new(NULL,
-                             (DESTROY_DATA_FCT) frequency_destroy,
-                             (PRINT_DATA_FCT) frequency_print);
-    }
-    else
-    {
-        /* Aufbauen des Huffman-Baumes mit Hilfe des Heaps. */
-        while (heap_get_size() > 1)
+        length = canonical_decode(canon, reader->bit_window, &symbol);
+        if (length == 0)
         {
-            /* Extrahiere die beiden Binärbäume mit der kleinsten Häufigkeit */
-            heap_extract_min((void **) &tree1);
-            heap_extract_min((void **) &tree2);
-
-            /* Erzeuge die neue Wurzel mit der Summe der Häufigkeiten der beiden
-             * gefundenen Bäume */
-            cf1 = (FREQUENCY *) btreenode_get_data(btree_get_root(tree1));
-            cf2 = (FREQUENCY *) btreenode_get_data(btree_get_root(tree2));
-            new_cf = frequency_create(NO_LETTER,
-                                      frequency_get_count(cf1)
-                                        + frequency_get_count(cf2));
-
-            /* Verbinde die 2 alten Bäume und füge sie mit der neuen Wurzel 
-             * wieder in den Heap ein. */
-            new_tree = btree_merge(tree1, tree2, new_cf);
-            heap_insert(new_tree);
-#ifdef DEBUG
-            btree_print(new_tree);
-#endif
+            report_format_error_and_exit("Ungueltiger Code in der Eingabedatei.");
         }
 
-        /* Der letzte im Heap verbleibene Baum ist nun der Huffman-Baum. */
-        heap_extract_min((void **) &hufftree);
+        BITREADER_CONSUME_BITS(reader, length);
 
-        /* Hat der Huffman-Baum nur einen Knoten: noch eine Wurzel einfügen */
-        if (btreenode_is_leaf(btree_get_root(hufftree)) == true)
+        if (out_pos == IO_BUFFER_SIZE)
         {
-            BTREE_NODE *root = btree_get_root(hufftree);
-            FREQUENCY *cf1 = btreenode_get_data(root);
-            FREQUENCY *cf2 = frequency_create(NO_LETTER,
-                                              frequency_get_count(cf1));
-            hufftree = btree_new(cf2,
-                                 (DESTROY_DATA_FCT) frequency_destroy,
-                                 (PRINT_DATA_FCT) frequency_print);
-            btreenode_set_left(btree_get_root(hufftree), root);
+            write_bytes(out, out_pos);
+            out_pos = 0;
         }
-#ifdef DEBUG
-        btree_print(hufftree);
-#endif
+        out[out_pos++] = symbol;
+        all_characters--;
     }
-    heap_destroy();
-    return hufftree;
+
+    write_bytes(out, out_pos);
 }
 
 /* ---------------------------------------------------------------------------
  * Funktion: build_code_table
  * ------------------------------------------------------------------------ */
-static void build_code_table(BTREE *hufftree,
-                             char code_table[][CODE_LENGTH])
+static void build_code_table(const HUFFTREE *hufftree, 
+                             HUFF_CODE code_table[])
 {
-    int i;
-
-    /* Initialisiere alle Elemente der Code-Tabelle mit einem Leerstring. */
-    for (i = 0; i < MAX_CHARACTERS; i++)
-    {
-        code_table[i][0] = '\0';
-    }
-
-    build_code_table_rek(btree_get_root(hufftree), "", code_table);
+    hufftree_get_codes(hufftree, code_table);
 
 #ifdef DEBUG
     printf("Code-Tabelle:\n");
     {
         int code;
+        int i;
         for (code = 0; code < MAX_CHARACTERS; code++)
         {
-            if (code_table[code][0] != '\0')
+            if (code_table[code].length > 0)
             {
-                printf("Code fuer %d: %s\n", code, code_table[code]);
+                printf("Code fuer %d: ", code);
+                for (i = code_table[code].length - 1; i >= 0; i--)
+                {
+                    printf("%d", (int) (code_table[code].bits >> i) & 1);
+                }
+                printf("\n");
             }
         }
     }
 #endif
 }
 
-/* ---------------------------------------------------------------------------
- * Funktion: build_code_table_rek
- * ------------------------------------------------------------------------ */
-static void build_code_table_rek(BTREE_NODE *huffnode,
-                                 char *current_code,
-                                 char code_table[][CODE_LENGTH])
-{
-    /* Linker oder rechter Kindknoten des aktuellen Knotens */
-    BTREE_NODE *child_node;
-    /* Codes für Verlängerung im linken und rechten Teilbaum */
-    char left_code[CODE_LENGTH];
-    char right_code[CODE_LENGTH];
-
-    FREQUENCY *cf = (FREQUENCY*) btreenode_get_data(huffnode);
-    if (frequency_get_letter(cf) != NO_LETTER)
-    {
-        /* Ein Zeichen wurde gefunden. Der Code muss nun zugeordnet werden. */
-        int code = frequency_get_letter(cf);
-        strcpy(code_table[code], current_code);
-    }
-
-    /* Falls vorhanden, Code für das linke Kind verlängern */
-    child_node = btreenode_get_left(huffnode);
-    if (child_node != NULL)
-    {
-        /* Anhängen des linken Bits (0) an den Code */
-        strcpy(left_code, current_code);
-        strcat(left_code, "0");
-        build_code_table_rek(child_node, left_code, code_table);
-    }
-
-    /* Falls vorhanden, Code für das rechte Kind verlängern */
-    child_node = btreenode_get_right(huffnode);
-    if (child_node != NULL)
-    {
-        /* Anhängen des linken Bits (0) an den Code */
-        strcpy(right_code, current_code);
-        strcat(right_code, "1");
-        build_code_table_rek(child_node, right_code, code_table);
-    }
-}
-
 /* ---------------------------------------------------------------------------
  * Funktion: write_fileheader
  * ------------------------------------------------------------------------ */
-static void write_fileheader(unsigned int all_characters,
+static void write_fileheader(unsigned long long all_characters,
                              unsigned int different_characters,
-                             unsigned int frequencys[])
+                             const unsigned long long frequencys[],
+                             bool large)
 {
     int i;
 
 #ifdef DEBUG
     printf("Schreibe Header...\n");
     printf("- Anzahl kodierter Zeichen : %d\n", different_characters);
-    printf("- Anzahl aller Zeichern    : %u\n", all_characters);
+    printf("- Anzahl aller Zeichern    : %llu\n", all_characters);
 #endif
 
     /* Schreibe Anzahl Zeichen und Anzahl unterschiedlicher Zeichen 
      * in der Eingabedatei */
-    write_int((unsigned int) all_characters);
-    write_int((unsigned int) different_characters);
+    if (large)
+    {
+        write_container_header(FORMAT_LARGE);
+        write_varint(all_characters);
+        write_varint(different_characters);
+    }
+    else
+    {
+        write_int((unsigned int) all_characters);
+        write_int((unsigned int) different_characters);
+    }
 
     /* Schreibe Zeichen und Häufigkeit */
     for (i = 0; i < MAX_CHARACTERS; i++)
@@ -561,7 +2082,14 @@ static void write_fileheader(unsigned int all_characters,
         if (frequencys[i] != 0)
         {
             write_char((unsigned char) i);
-            write_int((unsigned int) frequencys[i]);
+            if (large)
+            {
+                write_varint(frequencys[i]);
+            }
+            else
+            {
+                write_int((unsigned int) frequencys[i]);
+            }
         }
     }
 }
@@ -569,38 +2097,31 @@ static void write_fileheader(unsigned int all_characters,
 /* ---------------------------------------------------------------------------
  * Funktion: read_fileheader
  * ------------------------------------------------------------------------ */
-static void read_fileheader(unsigned int frequencys[],
-                            unsigned int *all_characters)
+static void read_fileheader(unsigned long long frequencys[],
+                            unsigned int different_characters, bool large)
 {
-    /* Anzahl der kodierten Zeichen */
-    unsigned int different_characters = 0;
     /* Das aktuell gelesene Zeichen. */
     unsigned char current_character = 0;
     /* Die Häufigkeit des aktuell gelesenen Zeichens */
-    unsigned int current_frequency = 0;
+    unsigned long long current_frequency = 0;
 
     /* Laufvariable. */
     unsigned int i;
 
-    /* Lese Anzahl kodierter Zeichen lesen */
-    *all_characters = (unsigned int) read_int();
-    different_characters = (unsigned int) read_int();
-
     /* Initialisiere die Häufigkeiten-Tabelle mit 0 */
-    memset(frequencys, 0, MAX_CHARACTERS * sizeof (unsigned int));
+    memset(frequencys, 0, MAX_CHARACTERS * sizeof (unsigned long long));
 
     /* Setze für jedes Zeichen die eingelesene Häufigkeit */
     for (i = 0; i < different_characters; i++)
     {
         current_character = (unsigned char) read_char();
-        current_frequency = (unsigned int) read_int();
+        current_frequency = large ? read_varint() : read_int();
 
         frequencys[current_character] = current_frequency;
     }
 #ifdef DEBUG
     printf("Header der komprimierten Datei:\n");
     printf("- Anzahl kodierter Zeichen : %d\n", different_characters);
-    printf("- Anzahl aller Zeichen     : %u\n", *all_characters);
     printf("- Haeufigkeiten der Zeichen: \n");
     {
         int code;
@@ -608,7 +2129,7 @@ static void read_fileheader(unsigned int frequencys[],
         {
             if (frequencys[code] != 0)
             {
-                printf("  - '%d' : %d\n", code, frequencys[code]);
+                printf("  - '%d' : %llu\n", code, frequencys[code]);
             }
         }
     }
@@ -1,16 +1,15 @@
 /**
  * @file
- * In diesem Modul werden die Huffman-Komprmierung und die 
- * Dieses Modul realisiert den Komprimierung und Dekomprimierung anhand der 
+ * Dieses Modul realisiert die Komprimierung und Dekomprimierung anhand der 
  * Huffman-Kodierung. Um eine Dekomprimierung zu ermoeglichen, wird beim
- * Komprimieren ein Header von folgendem Format in die Dateien geschrieben:
+ * Komprimieren ein Header in die Dateien geschrieben. Im urspruenglichen 
+ * Format (#FORMAT_LEGACY) hat der Header folgendes Format:
  * 
  * <UL>
+ * <LI> -1x 4 Byte: unsigned int, welcher die Anzahl der Zeichen in der 
+ *                  Ausgangsdatei angibt.
  * <LI> -1x 4 Byte: unsigned int, welcher die Anzahl der
  *                  Zeichen/Haeufigkeits-Paare im Header angibt.
- * <LI> -1x 4 Byte: unsigned int, welcher festlegt wie viele
- *                  Bits des letzten Bytes in der Datei noch mit
- *                  sinnvollen Daten belegt sind.
  * <LI> -Nx 5 Byte: Diese bestehen aus einem Character-Byte
  *                  welches ein Zeichen beschreibt und einem
  *                  unsigned int, welcher die Haeufigkeit
@@ -19,6 +18,57 @@
  *                  Zeichen in der Ausgangsdatei.
  * </UL>
  * 
+ * Alle weiteren Formate beginnen mit einem Container-Header:
+ * 
+ * <UL>
+ * <LI> -1x 4 Byte: Kennung 0x89 'H' 'U' 'F'
+ * <LI> -1x 1 Byte: Format (#FORMAT), niemals 0
+ * <LI> -1x 1 Byte: Version des Formats
+ * <LI> -1x 2 Byte: Flags, Bit 0 kennzeichnet in den blockweisen Formaten 
+ *                  vier Teilstroeme je Block, Bit 1 im kanonischen Format
+ *                  einen Sprungindex
+ * </UL>
+ * 
+ * Da im urspruenglichen Format das fuenfte Byte als hoechstwertiges Byte der 
+ * Anzahl verschiedener Zeichen immer 0 ist, lassen sich beide Varianten 
+ * sicher unterscheiden. Im kanonischen Format (#FORMAT_CANONICAL) folgen 
+ * die Anzahl der Zeichen als Zahl variabler Laenge und die Codelaengen im 
+ * Format des Moduls canonical. Ist der Sprungindex vorhanden, folgen darauf
+ * als Zahlen variabler Laenge der Abstand N der Sprungmarken in Zeichen, 
+ * die Anzahl M der Sprungmarken und fuer jede Sprungmarke k = 1..M die 
+ * Anzahl der Bits, um die der Bitstrom seit der vorigen Sprungmarke 
+ * gewachsen ist. Sprungmarke k steht damit fuer das Zeichen an Position 
+ * k * N und dessen Bitposition im Bitstrom. Das blockweise Format (#FORMAT_BLOCKS) und 
+ * das Stromformat (#FORMAT_STREAM) sind im Modul block beschrieben. Im 
+ * Format mit Vorverarbeitung (#FORMAT_TRANSFORM) folgen ein Byte mit den 
+ * Vorverarbeitungen, die Anzahl der Zeichen und die Blockgröße der BWT als
+ * Zahlen variabler Laenge und die vorverarbeiteten Daten im blockweisen 
+ * Format. Im adaptiven Format (#FORMAT_ADAPTIVE) folgen direkt die Codes, 
+ * die Kodierer und Dekodierer aus einem schrittweise angepassten Baum 
+ * bestimmen (siehe Modul adaptive). Das Kontextformat (#FORMAT_CONTEXT) 
+ * mit je einer Codetabelle fuer eine Gruppe vorangehender Zeichen ist im 
+ * Modul context beschrieben.
+ * 
+ * Dateien, deren Groesse nicht in 32 Bit passt, werden statt im 
+ * urspruenglichen Format im Format fuer grosse Dateien (#FORMAT_LARGE) 
+ * geschrieben. Nach dem Container-Header folgen die Anzahl aller Zeichen 
+ * und die Anzahl N der Zeichen/Haeufigkeits-Paare als Zahlen variabler 
+ * Laenge und N Paare aus einem Character-Byte und der Haeufigkeit als Zahl 
+ * variabler Laenge. Baum und Bitstrom entsprechen dem urspruenglichen 
+ * Format.
+ * 
+ * Waere die Datei im urspruenglichen, grossen oder kanonischen Format nicht
+ * kleiner als unkodiert, etwa bei zufaelligen oder bereits komprimierten
+ * Daten, wird sie im gespeicherten Format (#FORMAT_STORED) geschrieben. 
+ * Nach dem Container-Header folgen die Anzahl der Zeichen als Zahl 
+ * variabler Laenge und die unveraenderten Zeichen.
+ * 
+ * Im Format mit Woerterbuch (#FORMAT_DICTIONARY) stehen im Container-Header
+ * statt der Flags die 16 Bit der Kennung des Woerterbuchs. Es folgen die 
+ * Anzahl der Zeichen als Zahl variabler Laenge und der Bitstrom mit den 
+ * Codes des Woerterbuchs. Zur Dekomprimierung wird dasselbe Woerterbuch 
+ * benoetigt.
+ * 
  * @author S.Schmidt, U. Griefahn
  * @date 2017-01-12
  *
@@ -29,14 +79,203 @@
 /* ------------------------------------------------------------------------- */
 
 
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include "dictionary.h"
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** 
+ * Standardwert für die maximale Codelänge im kanonischen Format. Codes bis
+ * zu dieser Länge können über die Dekodiertabelle aufgelöst werden.
+ */
+#define DEFAULT_MAX_CODE_LENGTH 24
+
+/** Kleinste Komprimierungsstufe */
+#define HUFFMAN_MIN_LEVEL 1
+
+/** Größte Komprimierungsstufe */
+#define HUFFMAN_MAX_LEVEL 7
+
+/** Standard-Komprimierungsstufe, entspricht den Standardeinstellungen */
+#define HUFFMAN_DEFAULT_LEVEL 2
+
+/** Groesse der ersten beiden Woerter, mit denen jede komprimierte Datei beginnt */
+#define HUFFMAN_HEADER_SIZE 8
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Verfahren, mit dem bei der Dekomprimierung die Codes aufgelöst werden
+ */
+typedef enum
+{
+    /** Auflösen über eine Dekodiertabelle, mehrere Bits je Schritt */
+    DECODER_TABLE,
+    /** bitweises Durchlaufen des Huffman-Baums */
+    DECODER_TREE
+} DECODER;
+
+/**
+ * Verfahren, mit dem bei der Komprimierung die Codes geschrieben werden
+ */
+typedef enum
+{
+    /** 
+     * zwei Zeichen je Schritt über eine Paartabelle, siehe Modul codetable;
+     * für kleine Dateien wie #ENCODER_SINGLE
+     */
+    ENCODER_PAIRS,
+    /** ein Zeichen je Schritt über die Code-Tabelle */
+    ENCODER_SINGLE
+} ENCODER;
+
+/**
+ * Format der komprimierten Datei. Der Wert wird als Formatkennung in den
+ * Container-Header geschrieben.
+ */
+typedef enum
+{
+    /** Häufigkeiten aller Zeichen im Header, ohne Container-Header */
+    FORMAT_LEGACY = 0,
+    /** Codelängen eines kanonischen Codes im Header */
+    FORMAT_CANONICAL = 1,
+    /** unabhängig und parallel komprimierte Blöcke mit Index */
+    FORMAT_BLOCKS = 2,
+    /** Blöcke ohne Index, in einem Durchlauf über einen Strom erzeugt */
+    FORMAT_STREAM = 3,
+    /** vorverarbeitete (BWT, MTF, RLE) und danach blockweise kodierte Daten */
+    FORMAT_TRANSFORM = 4,
+    /** adaptive Huffman-Kodierung ohne Header, siehe Modul adaptive */
+    FORMAT_ADAPTIVE = 5,
+    /** Codetabellen je vorangehendem Zeichen, siehe Modul context */
+    FORMAT_CONTEXT = 6,
+    /** 
+     * Häufigkeiten wie im ursprünglichen Format, aber als Zahlen variabler
+     * Länge, für Dateien ab 4 GiB
+     */
+    FORMAT_LARGE = 7,
+    /** unkodierte Zeichen, wenn die Kodierung die Datei nicht verkleinert */
+    FORMAT_STORED = 8,
+    /** Codes eines vortrainierten Wörterbuchs, siehe Modul dictionary */
+    FORMAT_DICTIONARY = 9
+} FORMAT;
+
+/**
+ * Einstellungen für die Komprimierung und Dekomprimierung
+ */
+typedef struct
+{
+    /** Format, in dem komprimiert wird */
+    FORMAT format;
+
+    /**
+     * Maximale Codelänge im kanonischen Format. Sind die Codes des 
+     * Huffman-Baums länger, werden mit dem Package-Merge-Verfahren optimale
+     * Codes dieser Maximallänge berechnet. Das ursprüngliche Format speichert
+     * Häufigkeiten statt Codelängen und ist daher nicht beschränkt.
+     */
+    unsigned int max_code_length;
+
+
+    /**
+     * Verfahren für die Dekomprimierung. Kann die Dekodiertabelle für einen
+     * Huffman-Baum nicht erzeugt werden, wird immer der Baum durchlaufen.
+     */
+    DECODER decoder;
+
+    /** Verfahren für das Schreiben der Codes im ursprünglichen Format */
+    ENCODER encoder;
+
+    /** Größe der Blöcke in Bytes im blockweisen Format */
+    unsigned int block_size;
+
+    /**
+     * Anzahl der Threads für das blockweise Format, 0 für die Anzahl der
+     * Prozessoren
+     */
+    unsigned int threads;
+
+    /**
+     * Vorverarbeitungen im Format #FORMAT_TRANSFORM als Kombination der 
+     * TRANSFORM-Konstanten des Moduls transform
+     */
+    unsigned int transforms;
+
+    /** Blockgröße der Burrows-Wheeler-Transformation in Bytes */
+    unsigned int transform_block_size;
+
+    /**
+     * Anzahl der Teilströme je Block in den blockweisen Formaten: 1 oder 
+     * #DECODE_STREAMS, damit der Dekodierer mehrere Bitströme gleichzeitig 
+     * verfolgen kann
+     */
+    unsigned int streams;
+
+    /**
+     * Abstand der Sprungmarken des Sprungindex im kanonischen Format in 
+     * Zeichen, 0 ohne Sprungindex
+     */
+    unsigned int index_interval;
+
+    /**
+     * Wörterbuch für das Format #FORMAT_DICTIONARY, NULL ohne Wörterbuch
+     */
+    const DICTIONARY *dictionary;
+} HUFFMAN_OPTIONS;
+
+
 /* ============================================================================
  * Funktions-Prototypen
  * ========================================================================= */
 
+/**
+ * Belegt die übergebenen Einstellungen mit den Standardwerten.
+ *
+ * @param options   die zu belegenden Einstellungen
+ */
+extern void huffman_get_default_options(HUFFMAN_OPTIONS *options);
+
+/**
+ * Wählt Format und Vorverarbeitung zur übergebenen Komprimierungsstufe. Mit
+ * steigender Stufe wird langsamer, aber stärker komprimiert:
+ * <UL>
+ * <LI> 1: parallel kodierte Blöcke von 4 MiB mit je einer Code-Tabelle
+ * <LI> 2: das ursprüngliche Format (Standard)
+ * <LI> 3: kanonische Codes mit kompaktem Header
+ * <LI> 4: Lauflängenkodierung vor der Kodierung
+ * <LI> 5 bis 7: BWT, Move-To-Front und Lauflängenkodierung mit BWT-Blöcken
+ *      von 256 KiB, 1 MiB bzw. 4 MiB
+ * </UL>
+ *
+ * @param options   die anzupassenden Einstellungen
+ * @param level     Komprimierungsstufe von #HUFFMAN_MIN_LEVEL bis 
+ *                  #HUFFMAN_MAX_LEVEL
+ */
+extern void huffman_set_level(HUFFMAN_OPTIONS *options, unsigned int level);
+
+/**
+ * Legt die Einstellungen für alle folgenden Aufrufe von compress und
+ * decompress fest. Ohne Aufruf dieser Funktion gelten die Standardwerte.
+ *
+ * @param options   die zu verwendenden Einstellungen
+ */
+extern void huffman_set_options(const HUFFMAN_OPTIONS *options);
+
 /**
  * Komprimiert den Inhalt der Eingabedatei in_filename und schreibt das 
  * Ergebnis in die Ausgabedatei out_filename. Bei einem Fehler wird das 
- * Programm abgebrochen.
+ * Programm abgebrochen. Der Dateiname #STDIO_FILENAME steht für die 
+ * Standardeingabe bzw. -ausgabe. Nur im Stromformat wird die Eingabe dabei
+ * nicht vollständig in den Speicher gelesen.
  * 
  * @param in_filename   Name der Eingabedatei
  * @param out_filename  Name der Ausgabedatei
@@ -46,13 +285,45 @@ extern void compress(char *in_filename, char *out_filename);
 /**
  * Dekomprimiert den Inhalt der Eingabedatei in_filename und 
  * schreibt das Ergebnis in die Ausgabedatei out_filename. Bei einem Fehler
- * wird das Programm abgebrochen.
+ * wird das Programm abgebrochen. Der Dateiname #STDIO_FILENAME steht für 
+ * die Standardeingabe bzw. -ausgabe.
  * 
  * @param in_filename   Name der Eingabedatei
  * @param out_filename  Name der Ausgabedatei
  */
 extern void decompress(char *in_filename, char *out_filename);
 
+/**
+ * Dekomprimiert nur die length Zeichen ab Position offset der Eingabedatei 
+ * in_filename und schreibt sie in die Ausgabedatei out_filename. Im 
+ * blockweisen Format werden nur die betroffenen Bloecke dekodiert, im 
+ * kanonischen Format beginnt die Dekodierung an der letzten Sprungmarke vor
+ * offset bzw. ohne Sprungindex am Anfang. Im gespeicherten Format werden
+ * die Zeichen direkt kopiert. Ein Bereich ueber das Ende der 
+ * Daten hinaus wird dort abgeschnitten. Andere Formate und Fehler fuehren
+ * zum Abbruch des Programms.
+ * 
+ * @param in_filename   Name der Eingabedatei
+ * @param out_filename  Name der Ausgabedatei
+ * @param offset        Position des ersten auszugebenden Zeichens
+ * @param length        Anzahl der auszugebenden Zeichen
+ */
+extern void decompress_range(char *in_filename, char *out_filename,
+                             unsigned long long offset,
+                             unsigned long long length);
+
+/**
+ * Prueft anhand der ersten #HUFFMAN_HEADER_SIZE Bytes einer Datei, ob sie 
+ * eine komprimierte Datei sein kann: ein Container mit bekanntem Format 
+ * und bekannter Version oder das urspruengliche Format mit hoechstens 
+ * #MAX_CHARACTERS verschiedenen Zeichen. Die Daten danach werden nicht 
+ * geprueft.
+ * 
+ * @param header    die ersten #HUFFMAN_HEADER_SIZE Bytes der Datei
+ * @return          true, wenn der Header gueltig ist
+ */
+extern bool huffman_check_header(const unsigned char header[]);
+
 /* ------------------------------------------------------------------------- */
 #endif	/* HUFFMAN_H */
 
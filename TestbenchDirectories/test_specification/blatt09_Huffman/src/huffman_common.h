@@ -25,6 +25,9 @@
 /** Maixmale Länge des Dateinamens */
 #define MAX_FILENAME 255
 
+/** Anzahl der möglichen Zeichen, welche in einer Datei vorkommen können. */
+#define MAX_CHARACTERS 256
+
 
 /* ===========================================================================
  * Aufzählungstypen
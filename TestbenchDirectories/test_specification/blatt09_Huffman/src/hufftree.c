@@ -0,0 +1,290 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "huffman_common.h"
+#include "codetable.h"
+#include "hufftree.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+/** Position des Elternelements im Heap */
+#define PARENT_POSITION(POSITION) (((POSITION) - 1) / 2)
+
+/** Position des linken Kindelements im Heap */
+#define LEFT_CHILD_POSITION(POSITION) (((POSITION) * 2) + 1)
+
+/** Position des rechten Kindelements im Heap */
+#define RIGHT_CHILD_POSITION(POSITION) (((POSITION) * 2) + 2)
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Binärer Heap aus Knotenindizes, geordnet nach der Häufigkeit der Knoten
+ */
+typedef struct
+{
+    /** Indizes der Knoten */
+    short elements[MAX_CHARACTERS];
+
+    /** Anzahl der Elemente */
+    int size;
+} NODE_HEAP;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Vergleicht zwei Knoten nach ihrer Häufigkeit. Gleich häufige Knoten 
+ * gelten nicht als kleiner.
+ *
+ * @param tree  der Huffman-Baum
+ * @param node1 Index des ersten Knotens
+ * @param node2 Index des zweiten Knotens
+ * @return      true, wenn der erste Knoten seltener ist
+ */
+static bool is_less(const HUFFTREE *tree, short node1, short node2);
+
+/**
+ * Fügt einen Knoten in den Heap ein. Das neue Element wird bis zur Wurzel
+ * mit seinen Vorgängern verglichen.
+ *
+ * @param heap  der Heap
+ * @param tree  der Huffman-Baum
+ * @param node  Index des einzufügenden Knotens
+ */
+static void heap_push(NODE_HEAP *heap, const HUFFTREE *tree, short node);
+
+/**
+ * Entnimmt den seltensten Knoten aus dem Heap. Das letzte Element rückt an
+ * die Wurzel und sinkt ab.
+ *
+ * @param heap  der Heap, nicht leer
+ * @param tree  der Huffman-Baum
+ * @return      Index des entnommenen Knotens
+ */
+static short heap_pop(NODE_HEAP *heap, const HUFFTREE *tree);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: hufftree_create
+ * ------------------------------------------------------------------------ */
+extern HUFFTREE *hufftree_create(const unsigned long long frequencys[])
+{
+    HUFFTREE *tree;
+    HUFFTREE_NODE *node;
+    NODE_HEAP heap;
+    short size = 0;
+    short left;
+    short right;
+    int c;
+
+    tree = (HUFFTREE *) malloc(sizeof (HUFFTREE));
+    ENSURE_ENOUGH_MEMORY(tree, "hufftree_create");
+    heap.size = 0;
+
+    /* Alle vorkommenden Zeichen als Blätter in den Heap einfügen */
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        if (frequencys[c] > 0)
+        {
+            node = &tree->nodes[size];
+            node->count = frequencys[c];
+            node->left = HUFFTREE_NONE;
+            node->right = HUFFTREE_NONE;
+            node->symbol = (unsigned char) c;
+            heap_push(&heap, tree, size);
+            size++;
+        }
+    }
+
+    if (heap.size == 0)
+    {
+        tree->root = HUFFTREE_NONE;
+        return tree;
+    }
+
+    /* Die beiden seltensten Teilbäume unter einer neuen Wurzel verbinden */
+    while (heap.size > 1)
+    {
+        left = heap_pop(&heap, tree);
+        right = heap_pop(&heap, tree);
+
+        node = &tree->nodes[size];
+        node->count = tree->nodes[left].count + tree->nodes[right].count;
+        node->left = left;
+        node->right = right;
+        node->symbol = 0;
+        heap_push(&heap, tree, size);
+        size++;
+    }
+    tree->root = heap_pop(&heap, tree);
+
+    /* Besteht der Baum nur aus einem Blatt, erhält er eine Wurzel */
+    if (tree->nodes[tree->root].left == HUFFTREE_NONE)
+    {
+        node = &tree->nodes[size];
+        node->count = tree->nodes[tree->root].count;
+        node->left = (short) tree->root;
+        node->right = HUFFTREE_NONE;
+        node->symbol = 0;
+        tree->root = size;
+    }
+
+    return tree;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: hufftree_get_codes
+ * ------------------------------------------------------------------------ */
+extern void hufftree_get_codes(const HUFFTREE *tree, HUFF_CODE codes[])
+{
+    /* Pfade von der Wurzel zu allen Knoten */
+    HUFF_CODE paths[HUFFTREE_MAX_NODES];
+    const HUFFTREE_NODE *node;
+    int i;
+
+    memset(codes, 0, MAX_CHARACTERS * sizeof (HUFF_CODE));
+
+    if (tree->root == HUFFTREE_NONE)
+    {
+        return;
+    }
+
+    /* Jeder Elternknoten steht hinter seinen Kindern, daher kennt ein
+     * Durchlauf von der Wurzel abwärts den Pfad jedes Elternknotens schon */
+    paths[tree->root].bits = 0;
+    paths[tree->root].length = 0;
+    for (i = tree->root; i >= 0; i--)
+    {
+        node = &tree->nodes[i];
+        if (node->left == HUFFTREE_NONE)
+        {
+            codes[node->symbol] = paths[i];
+        }
+        else
+        {
+            paths[node->left].bits = paths[i].bits << 1;
+            paths[node->left].length = (unsigned char) (paths[i].length + 1);
+            if (node->right != HUFFTREE_NONE)
+            {
+                paths[node->right].bits = (paths[i].bits << 1) | 1;
+                paths[node->right].length =
+                        (unsigned char) (paths[i].length + 1);
+            }
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: hufftree_destroy
+ * ------------------------------------------------------------------------ */
+extern void hufftree_destroy(HUFFTREE **tree)
+{
+    free(*tree);
+    *tree = NULL;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: is_less
+ * ------------------------------------------------------------------------ */
+static bool is_less(const HUFFTREE *tree, short node1, short node2)
+{
+    return tree->nodes[node1].count < tree->nodes[node2].count;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: heap_push
+ * ------------------------------------------------------------------------ */
+static void heap_push(NODE_HEAP *heap, const HUFFTREE *tree, short node)
+{
+    int position = heap->size;
+    int parent_pos;
+    short swap;
+
+    heap->elements[heap->size++] = node;
+
+    /* Auch nach einem ausgebliebenen Tausch wird bis zur Wurzel weiter 
+     * verglichen; davon hängt die Reihenfolge gleich häufiger Knoten ab */
+    while (position > 0)
+    {
+        parent_pos = PARENT_POSITION(position);
+        if (is_less(tree, heap->elements[position],
+                    heap->elements[parent_pos]))
+        {
+            swap = heap->elements[position];
+            heap->elements[position] = heap->elements[parent_pos];
+            heap->elements[parent_pos] = swap;
+        }
+        position = parent_pos;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: heap_pop
+ * ------------------------------------------------------------------------ */
+static short heap_pop(NODE_HEAP *heap, const HUFFTREE *tree)
+{
+    short min_node = heap->elements[0];
+    int parent_pos = 0;
+    int min_pos;
+    int child_pos;
+    short swap;
+
+    heap->size--;
+    heap->elements[0] = heap->elements[heap->size];
+
+    /* Tausch mit dem kleineren Kind, solange eines kleiner ist */
+    for (;;)
+    {
+        min_pos = parent_pos;
+        child_pos = LEFT_CHILD_POSITION(parent_pos);
+        if (child_pos < heap->size
+            && is_less(tree, heap->elements[child_pos],
+                       heap->elements[parent_pos]))
+        {
+            min_pos = child_pos;
+        }
+        child_pos = RIGHT_CHILD_POSITION(parent_pos);
+        if (child_pos < heap->size
+            && is_less(tree, heap->elements[child_pos],
+                       heap->elements[min_pos]))
+        {
+            min_pos = child_pos;
+        }
+
+        if (min_pos == parent_pos)
+        {
+            return min_node;
+        }
+
+        swap = heap->elements[parent_pos];
+        heap->elements[parent_pos] = heap->elements[min_pos];
+        heap->elements[min_pos] = swap;
+        parent_pos = min_pos;
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file
+ * Dieses Modul stellt den Huffman-Baum des ursprünglichen Formats als
+ * flaches Array bereit. Alle Knoten liegen zusammenhängend in einem einzigen
+ * Speicherblock und verweisen über Indizes auf ihre Kinder, so dass der Baum
+ * mit einer Speicheranforderung erzeugt und mit einem Aufruf freigegeben
+ * wird. Kodierer und Dekodierer durchlaufen so nur wenige Cache-Zeilen.
+ *
+ * Der Baum wird über einen binären Heap aus Knotenindizes aufgebaut. Dessen
+ * Reihenfolge bei gleichen Häufigkeiten legt die Form des Baums und damit 
+ * die Codes des ursprünglichen Formats fest; Einfügen und Entnehmen folgen
+ * daher genau den Regeln, mit denen bestehende Dateien erzeugt wurden.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef HUFFTREE_H
+#define HUFFTREE_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include "huffman_common.h"
+#include "codetable.h"
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Maximale Anzahl der Knoten eines Huffman-Baums */
+#define HUFFTREE_MAX_NODES (2 * MAX_CHARACTERS - 1)
+
+/** Index für ein nicht vorhandenes Kind bzw. einen leeren Baum */
+#define HUFFTREE_NONE (-1)
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Knoten des Huffman-Baums. Ein Blatt hat keine Kinder.
+ */
+typedef struct
+{
+    /** Summe der Häufigkeiten der Zeichen im Teilbaum */
+    unsigned long long count;
+
+    /** Index des linken Kindes (0-Bit) oder #HUFFTREE_NONE */
+    short left;
+
+    /** Index des rechten Kindes (1-Bit) oder #HUFFTREE_NONE */
+    short right;
+
+    /** Zeichen eines Blatts */
+    unsigned char symbol;
+} HUFFTREE_NODE;
+
+/**
+ * Huffman-Baum in einem flachen Array. Die Blätter liegen vorne, jeder
+ * innere Knoten folgt auf seine Kinder, die Wurzel ist damit der letzte
+ * Knoten.
+ */
+typedef struct
+{
+    /** die Knoten */
+    HUFFTREE_NODE nodes[HUFFTREE_MAX_NODES];
+
+    /** Index der Wurzel oder #HUFFTREE_NONE für einen leeren Baum */
+    int root;
+} HUFFTREE;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Erzeugt den Huffman-Baum zu den übergebenen Häufigkeiten. Kommt nur ein
+ * Zeichen vor, erhält die Wurzel dieses als linkes Kind, so dass es den
+ * Code 0 bekommt.
+ *
+ * @param frequencys    Häufigkeiten der #MAX_CHARACTERS Zeichen
+ * @return              der Huffman-Baum, freizugeben mit hufftree_destroy
+ */
+extern HUFFTREE *hufftree_create(const unsigned long long frequencys[]);
+
+/**
+ * Ermittelt die Codes aller Zeichen aus dem Huffman-Baum. Ein Schritt in den
+ * linken Teilbaum verlängert den Code um ein 0-Bit, ein Schritt in den
+ * rechten Teilbaum um ein 1-Bit. Zeichen, die im Baum nicht vorkommen,
+ * erhalten die Codelänge 0.
+ *
+ * @param tree      der Huffman-Baum
+ * @param codes     Array, in das die Codes der #MAX_CHARACTERS Zeichen
+ *                  geschrieben werden
+ */
+extern void hufftree_get_codes(const HUFFTREE *tree, HUFF_CODE codes[]);
+
+/**
+ * Gibt den Huffman-Baum frei und setzt den Zeiger auf NULL.
+ *
+ * @param tree  der freizugebende Huffman-Baum
+ */
+extern void hufftree_destroy(HUFFTREE **tree);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* HUFFTREE_H */
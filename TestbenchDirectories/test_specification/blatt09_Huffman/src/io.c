@@ -4,6 +4,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 /* Definiere Variablen, damit sie in dieser Datei für Splint bekannt sind. Sie
  * werden in errno.h definiert. */
@@ -12,6 +13,20 @@
 #define EMFILE 0
 #include <errno.h>
 
+/* Splint definiert S_SPLINT_S. Die POSIX-Header für das Einblenden von 
+ * Dateien werden von der Splint-Prüfung ausgeklammert. */
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(S_SPLINT_S)
+#define USE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/* Unter Windows müssen die Standardströme für Binärdaten umgestellt werden */
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
 #include "huffman_common.h"
 #include "io.h"
 
@@ -24,7 +39,25 @@
  * Blockgröße, mit der aus der Eingabedatei gelesen und in die Ausgabedatei 
  * geschrieben wird.
  */
-#define BUF_SIZE 4096
+#define BUF_SIZE IO_BUFFER_SIZE
+
+/**
+ * Anfangsgröße des Puffers, wenn eine Eingabe unbekannter Länge (bspw. eine
+ * Pipe) vollständig in den Speicher gelesen wird. Der Puffer wird bei Bedarf
+ * verdoppelt.
+ */
+#define INITIAL_LOAD_SIZE (1024 * 1024)
+
+/**
+ * Speicherklasse der Standardkontexte. Mit GCC und Clang erhält jeder Thread
+ * eigene Standardkontexte, so dass im Stapelbetrieb mehrere Dateien 
+ * gleichzeitig mit den Funktionen ohne Kontext bearbeitet werden können.
+ */
+#if defined(__GNUC__) && !defined(S_SPLINT_S)
+#define THREAD_LOCAL __thread
+#else
+#define THREAD_LOCAL
+#endif
 
 
 /* ============================================================================
@@ -32,20 +65,10 @@
  * ========================================================================= */
 
 /**
- * Liefert das Bit von C an der Position POS. Ist POS gleich 0, wird  
- * das höchstwertigste Bit geliefert, für POS gleich 7 wird das 
- * niederwertigste Bit geliefert. Es wird davon ausgegangen, dass POS einen
- * Wert zwischen 0 und 7 hat. Ansonsten ist die Rückgabe undefiniert.
- */
-#define GET_BIT(C, POS) ((C) >> (7 - (POS)) & (unsigned char) 0x01)
-
-/**
- * Schreibt das Bit BIT an der Position POS in das Zeichen C. Ist POS 
- * gleich 0, wird das höchstwertigste Bit geliefert, für POS gleich 7 wird  
- * das niederwertigste Bit geliefert. Es wird davon ausgegangen, dass POS 
- * einen Wert zwischen 0 und 7 hat. Ansonsten ist die Rückgabe undefiniert.
+ * Anzahl der Bits, ab der der Bitakkumulator als 32-Bit-Wort in den 
+ * Ausgabepuffer geschrieben wird.
  */
-#define PUT_BIT(C, BIT, POS) ((C) | ((unsigned char) (BIT) << (7 - (POS))))
+#define WORD_BITS 32
 
 
 /* ============================================================================
@@ -80,102 +103,432 @@ typedef union
  */
 static void report_error_and_exit(void);
 
+/**
+ * Schreibt den Inhalt des Ausgabepuffers in die Ausgabedatei und leert den
+ * Puffer.
+ * 
+ * @param writer    Kontext der Ausgabedatei
+ */
+static void flush_out_buffer(BITWRITER *writer);
+
+/**
+ * Liest den übergebenen Strom mit möglichst einem Aufruf von fread 
+ * vollständig in einen neu allokierten Speicherbereich des Kontexts.
+ * 
+ * @param reader    Kontext, in dem die Daten abgelegt werden
+ * @param stream    der zu lesende Strom
+ * @param size      Größe der Daten, falls bekannt, sonst 0
+ */
+static void load_stream(BITREADER *reader, FILE *stream, size_t size);
+
+/**
+ * Öffnet die übergebene Datei oder liefert für #STDIO_FILENAME den 
+ * übergebenen Standardstrom im Binärmodus.
+ * 
+ * @param filename  zu öffnende Datei
+ * @param mode      Modus für fopen
+ * @param standard  Standardstrom für #STDIO_FILENAME
+ * @return          der geöffnete Strom. Das Programm wird abgebrochen, wenn
+ *                  die Datei nicht geöffnet werden konnte.
+ */
+static FILE *open_stream(char filename[], const char *mode, FILE *standard);
+
+/**
+ * Schließt den übergebenen Strom. Standardströme werden nur geleert.
+ * 
+ * @param stream    der zu schließende Strom
+ */
+static void close_stream(FILE *stream);
+
 
 /* ============================================================================
  * Globale Variablen
  * ========================================================================= */
 
-/** Eingabestrom */
-static FILE *in_stream;
+/** Standardkontext der Eingabedatei für die Funktionen ohne Kontext */
+static THREAD_LOCAL BITREADER default_reader;
 
-/** Puffer für den Eingabestrom */
-static unsigned char in_buffer[BUF_SIZE];
+/** Standardkontext der Ausgabedatei für die Funktionen ohne Kontext */
+static THREAD_LOCAL BITWRITER default_writer;
 
-/** Enthält die erste freie Position des Puffers nach dem letzten Zeichen */
-static int last_in_pos;
 
-/** Aktuelle Position im Eingabepuffer */
-static int curr_in_pos;
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
 
-/** Das aktuelle Zeichen im Eingangspuffer */
-static unsigned char curr_in_char;
+/* ----------------------------------------------------------------------------
+ * Funktionen auf den Standardkontexten
+ * ------------------------------------------------------------------------- */
 
-/** Aktuelle Bit-Position im aktuellen Zeichen */
-static int curr_in_bit_pos;
+extern BITREADER *get_infile_reader(void)
+{
+    return &default_reader;
+}
 
-/** Ausgabestrom */
-static FILE *out_stream;
+extern BITWRITER *get_outfile_writer(void)
+{
+    return &default_writer;
+}
 
-/** Puffer für den Ausgabestrom */
-static unsigned char out_buffer[BUF_SIZE];
+extern void get_io_statistics(IO_STATISTICS *statistics)
+{
+    statistics->read_calls = default_reader.read_calls;
+    statistics->bytes_read = default_reader.bytes_read;
+    statistics->write_calls = default_writer.write_calls;
+    statistics->bytes_written = default_writer.bytes_written;
+}
 
-/** Nächste freie Position im Ausgabepuffer */
-static int last_out_pos;
+extern void open_infile(char filename[])
+{
+    bitreader_open(&default_reader, filename);
+}
 
-/** das aktuell Zeichen im Ausgangspuffer */
-static unsigned char curr_out_char;
-    
-/** die aktuelle Bit-Position im aktuellen Zeichen im Ausgangspuffer */
-static int curr_out_bit_pos;
+extern void close_infile(void)
+{
+    bitreader_close(&default_reader);
+}
 
+extern void open_outfile(char filename[])
+{
+    bitwriter_open(&default_writer, filename);
+}
 
-/* ============================================================================
- * Funktions-Definitionen
- * ========================================================================= */
+extern void close_outfile(void)
+{
+    bitwriter_close(&default_writer);
+}
+
+extern const unsigned char *map_infile(char filename[], size_t *size)
+{
+    return bitreader_map(&default_reader, filename, size);
+}
+
+extern const unsigned char *read_infile_rest(size_t *size)
+{
+    return bitreader_read_rest(&default_reader, size);
+}
+
+extern void unmap_infile(void)
+{
+    bitreader_unmap(&default_reader);
+}
+
+extern bool has_next_char(void)
+{
+    return bitreader_has_next_char(&default_reader);
+}
+
+extern unsigned char read_char(void)
+{
+    return bitreader_read_char(&default_reader);
+}
+
+extern size_t read_bytes(unsigned char data[], size_t size)
+{
+    return bitreader_read_bytes(&default_reader, data, size);
+}
+
+extern void write_char(unsigned char c)
+{
+    bitwriter_write_char(&default_writer, c);
+}
+
+extern void write_bytes(const unsigned char data[], size_t size)
+{
+    bitwriter_write_bytes(&default_writer, data, size);
+}
+
+extern bool has_next_bit(void)
+{
+    return bitreader_has_next_bit(&default_reader);
+}
+
+extern BIT read_bit(void)
+{
+    return bitreader_read_bit(&default_reader);
+}
+
+extern unsigned long long peek_bits(unsigned int count)
+{
+    return bitreader_peek_bits(&default_reader, count);
+}
+
+extern void consume_bits(unsigned int count)
+{
+    bitreader_consume_bits(&default_reader, count);
+}
+
+extern void write_bit(BIT bit)
+{
+    bitwriter_write_bit(&default_writer, bit);
+}
+
+extern void write_bits(unsigned long long bits, unsigned int count)
+{
+    bitwriter_write_bits(&default_writer, bits, count);
+}
+
+extern unsigned int read_int(void)
+{
+    return bitreader_read_int(&default_reader);
+}
+
+extern void write_int(unsigned int i)
+{
+    bitwriter_write_int(&default_writer, i);
+}
+
+extern unsigned long long read_varint(void)
+{
+    return bitreader_read_varint(&default_reader);
+}
+
+extern void write_varint(unsigned long long number)
+{
+    bitwriter_write_varint(&default_writer, number);
+}
 
 /* ----------------------------------------------------------------------------
  * Oeffnen und Schliessen von Dateien
  * ------------------------------------------------------------------------- */
 
-extern void open_infile(char filename[])
+extern void bitreader_open(BITREADER *reader, char filename[])
 {
-    errno = 0;
-    in_stream = fopen(filename, "rb");
-    if (in_stream == NULL)
+    reader->stream = open_stream(filename, "rb", stdin);
+    reader->last_pos = (int) fread(reader->buffer, sizeof (unsigned char),
+                                   BUF_SIZE, reader->stream);
+    reader->read_calls++;
+    reader->bytes_read += (unsigned long long) reader->last_pos;
+    reader->curr_pos = 0;
+    reader->bit_window = 0;
+    reader->window_bits = 0;
+}
+
+extern void bitreader_close(BITREADER *reader)
+{
+    close_stream(reader->stream);
+    reader->stream = NULL;
+}
+
+extern void bitwriter_open(BITWRITER *writer, char filename[])
+{
+    writer->stream = open_stream(filename, "wb", stdout);
+    writer->last_pos = 0;
+    writer->bit_buffer = 0;
+    writer->bit_count = 0;
+}
+
+extern void bitwriter_close(BITWRITER *writer)
+{
+    /* Verbliebene Bits schreiben, das letzte Byte mit 0-Bits auffüllen */
+    while (writer->bit_count > 0) 
     {
-        report_error_and_exit();
+        writer->bit_count -= 8;
+        bitwriter_write_char(writer, (unsigned char) (writer->bit_count >= 0
+                ? writer->bit_buffer >> writer->bit_count
+                : writer->bit_buffer << -writer->bit_count));
     }
-    last_in_pos = (int) fread(in_buffer, sizeof (unsigned char),
-                                     BUF_SIZE, in_stream);
-    curr_in_pos = 0;
-    curr_in_bit_pos = 8;
+    writer->bit_count = 0;
+    
+    flush_out_buffer(writer);
+    close_stream(writer->stream);
 }
 
-extern void close_infile(void)
+static FILE *open_stream(char filename[], const char *mode, FILE *standard)
 {
+    FILE *stream = standard;
+
     errno = 0;
-    if (fclose(in_stream) == EOF)
+    if (strcmp(filename, STDIO_FILENAME) == 0)
     {
-        report_error_and_exit();
-    };
+#ifdef _WIN32
+        (void) _setmode(_fileno(standard), _O_BINARY);
+#endif
+    }
+    else
+    {
+        stream = fopen(filename, mode);
+        if (stream == NULL)
+        {
+            report_error_and_exit();
+        }
+    }
+
+    return stream;
 }
 
-extern void open_outfile(char filename[])
+static void close_stream(FILE *stream)
 {
     errno = 0;
-    out_stream = fopen(filename, "wb");
-    if (out_stream == NULL)
+    if (stream == stdin || stream == stdout)
+    {
+        if (stream == stdout && fflush(stream) == EOF)
+        {
+            report_error_and_exit();
+        }
+    }
+    else if (fclose(stream) == EOF)
     {
         report_error_and_exit();
     }
-    last_out_pos = 0;
 }
 
-extern void close_outfile(void)
+
+/* ----------------------------------------------------------------------------
+ * Eingabedatei im Speicher
+ * ------------------------------------------------------------------------- */
+
+extern const unsigned char *bitreader_map(BITREADER *reader, char filename[],
+                                          size_t *size)
+{
+    FILE *stream;
+    size_t file_size = 0;
+    /* Bytes, die über den noch geöffneten Puffer bereits gelesen und 
+     * gezählt wurden, etwa beim Prüfen des Headers */
+    long counted = (reader->stream != NULL) ? ftell(reader->stream) : 0;
+
+    stream = open_stream(filename, "rb", stdin);
+
+    reader->map_data = NULL;
+    reader->map_size = 0;
+    reader->map_is_mapped = false;
+
+#ifdef USE_MMAP
+    {
+        struct stat attribut;
+
+        /* Nur reguläre Dateien können eingeblendet werden, Pipes u.ä. 
+         * werden gelesen */
+        if (fstat(fileno(stream), &attribut) == 0 
+            && S_ISREG(attribut.st_mode))
+        {
+            file_size = (size_t) attribut.st_size;
+        }
+
+        if (file_size > 0)
+        {
+            void *data = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE,
+                              fileno(stream), 0);
+            if (data != MAP_FAILED)
+            {
+                (void) madvise(data, file_size, MADV_SEQUENTIAL);
+                reader->map_data = (unsigned char *) data;
+                reader->map_size = file_size;
+                reader->map_is_mapped = true;
+                reader->read_calls++;
+                reader->bytes_read += file_size;
+            }
+        }
+    }
+#endif
+
+    if (!reader->map_is_mapped)
+    {
+        load_stream(reader, stream, file_size);
+    }
+
+    close_stream(stream);
+
+    /* Jedes Byte der Datei nur einmal zählen */
+    if (counted > 0)
+    {
+        reader->bytes_read -= ((size_t) counted < reader->map_size) 
+                              ? (unsigned long long) counted 
+                              : reader->map_size;
+    }
+
+    *size = reader->map_size;
+    return reader->map_data;
+}
+
+extern const unsigned char *bitreader_read_rest(BITREADER *reader, 
+                                                size_t *size)
 {
-    if (curr_out_bit_pos > 0) 
+    /* bereits gepufferte, aber noch nicht gelesene Zeichen */
+    size_t buffered = (size_t) (reader->last_pos - reader->curr_pos);
+    unsigned char *data;
+
+    reader->map_is_mapped = false;
+    load_stream(reader, reader->stream, 0);
+
+    if (buffered > 0)
     {
-        write_char((unsigned char) curr_out_char);
-        curr_out_bit_pos = 0;
-        curr_out_char = '\0';
+        data = (unsigned char *) realloc(reader->map_data, 
+                                         reader->map_size + buffered);
+        if (data == NULL)
+        {
+            report_error_and_exit();
+        }
+        memmove(data + buffered, data, reader->map_size);
+        memcpy(data, reader->buffer + reader->curr_pos, buffered);
+        reader->map_data = data;
+        reader->map_size += buffered;
     }
-    
+    reader->curr_pos = reader->last_pos;
+
+    *size = reader->map_size;
+    return reader->map_data;
+}
+
+extern void bitreader_unmap(BITREADER *reader)
+{
+#ifdef USE_MMAP
+    if (reader->map_is_mapped)
+    {
+        (void) munmap(reader->map_data, reader->map_size);
+    }
+    else
+#endif
+    {
+        free(reader->map_data);
+    }
+
+    reader->map_data = NULL;
+    reader->map_size = 0;
+    reader->map_is_mapped = false;
+}
+
+static void load_stream(BITREADER *reader, FILE *stream, size_t size)
+{
+    /* Größe des allokierten Puffers */
+    size_t capacity = (size > 0) ? size : INITIAL_LOAD_SIZE;
+    size_t count;
+
+    reader->map_data = (unsigned char *) malloc(capacity);
+    if (reader->map_data == NULL)
+    {
+        report_error_and_exit();
+    }
+
     errno = 0;
-    (void) fwrite(out_buffer, sizeof(unsigned char), (size_t) last_out_pos, out_stream);
-    if (fclose(out_stream) == EOF)
+    count = fread(reader->map_data, sizeof (unsigned char), capacity, stream);
+    reader->map_size = count;
+    reader->read_calls++;
+
+    /* Bei unbekannter Größe solange verdoppeln und weiterlesen, bis die 
+     * Eingabe erschöpft ist */
+    while (count > 0 && reader->map_size == capacity)
+    {
+        unsigned char *larger = (unsigned char *) realloc(reader->map_data, 
+                                                          2 * capacity);
+        if (larger == NULL)
+        {
+            report_error_and_exit();
+        }
+        reader->map_data = larger;
+
+        count = fread(reader->map_data + reader->map_size, 
+                      sizeof (unsigned char), capacity, stream);
+        reader->map_size += count;
+        reader->read_calls++;
+        capacity *= 2;
+    }
+    reader->bytes_read += reader->map_size;
+
+    if (ferror(stream))
     {
         report_error_and_exit();
-    };
+    }
 }
 
 
@@ -183,29 +536,63 @@ extern void close_outfile(void)
  * Byteweises Lesen und Schreiben
  * ------------------------------------------------------------------------- */
 
-extern bool has_next_char(void)
+extern bool bitreader_has_next_char(BITREADER *reader)
 {
     /* Buffer erneut füllen, falls letztes Zeichen ausgelesen */
-    if (curr_in_pos >= last_in_pos)
+    if (reader->curr_pos >= reader->last_pos)
     {
-        last_in_pos = (int) fread(in_buffer, sizeof(unsigned char), 
-                                         BUF_SIZE, in_stream);
-        curr_in_pos = 0;
+        reader->last_pos = (int) fread(reader->buffer, sizeof(unsigned char), 
+                                       BUF_SIZE, reader->stream);
+        reader->read_calls++;
+        reader->bytes_read += (unsigned long long) reader->last_pos;
+        reader->curr_pos = 0;
     }
 
-    return curr_in_pos < last_in_pos;
+    return reader->curr_pos < reader->last_pos;
 }
 
-extern unsigned char read_char(void)
+extern size_t bitreader_read_bytes(BITREADER *reader, unsigned char data[], 
+                                   size_t size)
+{
+    /* zuerst die gepufferten Zeichen, den Rest direkt aus der Datei */
+    size_t count = (size_t) (reader->last_pos - reader->curr_pos);
+
+    if (count > size)
+    {
+        count = size;
+    }
+    memcpy(data, reader->buffer + reader->curr_pos, count);
+    reader->curr_pos += (int) count;
+
+    if (count < size)
+    {
+        size_t direct;
+
+        errno = 0;
+        direct = fread(data + count, sizeof (unsigned char), size - count, 
+                       reader->stream);
+        if (ferror(reader->stream))
+        {
+            report_error_and_exit();
+        }
+        reader->read_calls++;
+        reader->bytes_read += direct;
+        count += direct;
+    }
+
+    return count;
+}
+
+extern unsigned char bitreader_read_char(BITREADER *reader)
 {
     /* Nächstes Zeichen aus dem Buffer lesen */
-    unsigned char c = in_buffer[curr_in_pos];
-    curr_in_pos++;
+    unsigned char c = reader->buffer[reader->curr_pos];
+    reader->curr_pos++;
 
     return c;
 }
 
-extern void write_char(unsigned char c)
+extern void bitwriter_write_char(BITWRITER *writer, unsigned char c)
 {
     /* 
      * Schreibt das Zeichen in den Puffer, bis dieser voll ist. Ist dieser voll,
@@ -214,14 +601,48 @@ extern void write_char(unsigned char c)
      */
 
     /* Zeichen an nächste freie Pufferposition schreiben */
-    out_buffer[last_out_pos] = c;
-    last_out_pos++;
+    writer->buffer[writer->last_pos] = c;
+    writer->last_pos++;
 
     /* Vollen Puffer zuerst schreiben */
-    if (last_out_pos >= BUF_SIZE)
+    if (writer->last_pos >= BUF_SIZE)
+    {
+        flush_out_buffer(writer);
+    }
+}
+
+extern void bitwriter_write_bytes(BITWRITER *writer, 
+                                  const unsigned char data[], size_t size)
+{
+    /* Kleine Blöcke über den Puffer, große direkt in die Datei schreiben */
+    if (size <= (size_t) (BUF_SIZE - writer->last_pos))
+    {
+        memcpy(writer->buffer + writer->last_pos, data, size);
+        writer->last_pos += (int) size;
+    }
+    else
     {
-        (void) fwrite(out_buffer, sizeof(unsigned char), BUF_SIZE, out_stream);
-        last_out_pos = 0;
+        flush_out_buffer(writer);
+        errno = 0;
+        if (fwrite(data, sizeof (unsigned char), size, writer->stream) 
+            != size)
+        {
+            report_error_and_exit();
+        }
+        writer->write_calls++;
+        writer->bytes_written += size;
+    }
+}
+
+static void flush_out_buffer(BITWRITER *writer)
+{
+    if (writer->last_pos > 0)
+    {
+        (void) fwrite(writer->buffer, sizeof(unsigned char), 
+                      (size_t) writer->last_pos, writer->stream);
+        writer->write_calls++;
+        writer->bytes_written += (unsigned long long) writer->last_pos;
+        writer->last_pos = 0;
     }
 }
 
@@ -229,54 +650,139 @@ extern void write_char(unsigned char c)
  * Bitweises Lesen und Schreiben
  * ------------------------------------------------------------------------- */
 
-extern bool has_next_bit(void)
+extern bool bitreader_has_next_bit(BITREADER *reader)
 {
-    return curr_in_bit_pos < 8 || has_next_char();
+    return reader->window_bits > 0 || bitreader_has_next_char(reader);
 }
 
-extern BIT read_bit(void)
+extern BIT bitreader_read_bit(BITREADER *reader)
 {
-    /* 
-     * Liest so lange aus dem Puffer, bis dieser leer ist. Ist dieser leer,
-     * wird der Inhalt des Puffers aus der Eingabedatei erneut gefuellt.
-     */
-
     /* das aktuelle Bit */
     BIT bit;
 
-    /* das allererste Zeichen holen, weil statische Variable nicht mit 
-     * Rückgabe einer Funktion initialisiert werden kann */
-    if (curr_in_bit_pos % 8 == 0 && has_next_char())
+    BITREADER_ENSURE_BITS(reader, 1);
+
+    /* Hinter dem Dateiende liefert das leere Fenster 0-Bits */
+    bit = (BIT) (reader->bit_window >> 63);
+    if (reader->window_bits > 0)
     {
-        curr_in_char = read_char();
-        curr_in_bit_pos = 0;
+        BITREADER_CONSUME_BITS(reader, 1);
     }
 
-    /* Bit aus dem aktuellen Zeichen auslesen und weitersetzen */
-    bit = GET_BIT(curr_in_char, curr_in_bit_pos);
-    curr_in_bit_pos++;
-
     return bit;
 }
 
-extern void write_bit(BIT bit)
+extern void bitreader_refill(BITREADER *reader)
+{
+    /* ein Wort der Eingabe, höchstwertiges Byte zuerst */
+    unsigned long long word;
+    const unsigned char *p;
+
+    /* Das Fenster ist voll oder es wurde über das Dateiende hinaus gelesen,
+     * dann folgen keine Bits mehr */
+    if (reader->window_bits < 0 || reader->window_bits >= BITREADER_MAX_BITS)
+    {
+        return;
+    }
+
+    if (reader->last_pos - reader->curr_pos >= 8)
+    {
+        /* 
+         * Schneller Pfad: Ein ganzes Wort hinter die gültigen Bits legen und
+         * so viele ganze Zeichen verbrauchen, wie vollständig hineinpassen.
+         * Die übrigen Bits des Wortes sind bereits die folgenden Bits der
+         * Eingabe und werden beim nächsten Nachfüllen identisch überlagert.
+         */
+        p = reader->buffer + reader->curr_pos;
+        word = (unsigned long long) p[0] << 56 
+               | (unsigned long long) p[1] << 48
+               | (unsigned long long) p[2] << 40 
+               | (unsigned long long) p[3] << 32
+               | (unsigned long long) p[4] << 24 
+               | (unsigned long long) p[5] << 16
+               | (unsigned long long) p[6] << 8 
+               | (unsigned long long) p[7];
+        reader->bit_window |= word >> reader->window_bits;
+        reader->curr_pos += (63 - reader->window_bits) >> 3;
+        reader->window_bits |= 56;
+    }
+    else
+    {
+        /* Pufferende: zeichenweise, bei Bedarf erneut aus der Datei */
+        while (reader->window_bits <= 56 && bitreader_has_next_char(reader))
+        {
+            reader->bit_window |= (unsigned long long) 
+                                  bitreader_read_char(reader) 
+                                  << (56 - reader->window_bits);
+            reader->window_bits += 8;
+        }
+    }
+}
+
+extern unsigned long long bitreader_peek_bits(BITREADER *reader, 
+                                              unsigned int count)
+{
+    BITREADER_ENSURE_BITS(reader, count);
+
+    return BITREADER_PEEK_BITS(reader, count);
+}
+
+extern void bitreader_consume_bits(BITREADER *reader, unsigned int count)
+{
+    BITREADER_ENSURE_BITS(reader, count);
+
+    if ((int) count > reader->window_bits)
+    {
+        /* Am Dateiende nur die vorhandenen Bits verbrauchen */
+        count = (reader->window_bits > 0) 
+                ? (unsigned int) reader->window_bits 
+                : 0;
+    }
+    BITREADER_CONSUME_BITS(reader, count);
+}
+
+extern void bitwriter_write_bit(BITWRITER *writer, BIT bit)
+{
+    bitwriter_write_bits(writer, (unsigned long long) bit, 1);
+}
+
+extern void bitwriter_write_bits(BITWRITER *writer, unsigned long long bits, 
+                                 unsigned int count)
 {
     /* 
-     * Schreibt so lange in den Puffer, bis dieser voll ist. Ist dieser voll,
-     * wird der Inhalt des Puffers in die Ausgabedatei geschrieben und der 
-     * Puffer erneut gefüllt.
+     * Sammelt die Bits im Akkumulator. Sobald ein 32-Bit-Wort vollständig
+     * ist, wird es als Ganzes in den Ausgabepuffer geschrieben.
      */
 
-    /* Bit im aktuellen Zeichen setzen */
-    curr_out_char = PUT_BIT(curr_out_char, bit, curr_out_bit_pos);
-    curr_out_bit_pos++;
+    /* das zu schreibende Wort */
+    unsigned int word;
 
-    /* Wenn Byte voll, dann Zeichen schreiben */
-    if (curr_out_bit_pos == 8)
+    /* Höchstens 32 Bits auf einmal aufnehmen, damit der Akkumulator nicht
+     * überläuft */
+    if (count > WORD_BITS)
     {
-        write_char((unsigned char) curr_out_char);
-        curr_out_bit_pos = 0;
-        curr_out_char = '\0';
+        bitwriter_write_bits(writer, bits >> WORD_BITS, count - WORD_BITS);
+        bits &= 0xFFFFFFFFull;
+        count = WORD_BITS;
+    }
+
+    writer->bit_buffer = (writer->bit_buffer << count) | bits;
+    writer->bit_count += (int) count;
+
+    if (writer->bit_count >= WORD_BITS)
+    {
+        writer->bit_count -= WORD_BITS;
+        word = (unsigned int) (writer->bit_buffer >> writer->bit_count);
+
+        if (writer->last_pos > BUF_SIZE - 4)
+        {
+            flush_out_buffer(writer);
+        }
+        writer->buffer[writer->last_pos] = (unsigned char) (word >> 24);
+        writer->buffer[writer->last_pos + 1] = (unsigned char) (word >> 16);
+        writer->buffer[writer->last_pos + 2] = (unsigned char) (word >> 8);
+        writer->buffer[writer->last_pos + 3] = (unsigned char) word;
+        writer->last_pos += 4;
     }
 }
 
@@ -284,7 +790,7 @@ extern void write_bit(BIT bit)
  * Int-weises Lesen und Schreiben
  * ------------------------------------------------------------------------- */
 
-extern unsigned int read_int(void)
+extern unsigned int bitreader_read_int(BITREADER *reader)
 {
     /* 
      * Liest so lange aus dem Puffer, bis dieser leer ist. Ist dieser leer,
@@ -301,9 +807,9 @@ extern unsigned int read_int(void)
 
     for (i = 0; i < (unsigned int) sizeof (unsigned int); i++)
     {
-        if (has_next_char())
+        if (bitreader_has_next_char(reader))
         {
-            c = read_char();
+            c = bitreader_read_char(reader);
             number.int_text[sizeof (unsigned int) - 1 - i] = c;
         }
     }
@@ -316,7 +822,7 @@ extern unsigned int read_int(void)
     return i;
 }
 
-extern void write_int(unsigned int i)
+extern void bitwriter_write_int(BITWRITER *writer, unsigned int i)
 {
     /* 
      * Schreibt so lange in den Puffer, bis dieser voll ist. Ist dieser voll,
@@ -330,8 +836,80 @@ extern void write_int(unsigned int i)
 
     for (i = 0; i < (unsigned int) sizeof (int); i++)
     {
-        write_char(number.int_text[sizeof (int) - 1 - i]);
+        bitwriter_write_char(writer, number.int_text[sizeof (int) - 1 - i]);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+ * Lesen und Schreiben von Zahlen variabler Länge
+ * ------------------------------------------------------------------------- */
+
+extern unsigned long long bitreader_read_varint(BITREADER *reader)
+{
+    /* die aktuelle Zahl */
+    unsigned long long number = 0;
+
+    /* Position der nächsten 7 Bits in der Zahl */
+    unsigned int shift = 0;
+
+    /* das aktuelle Zeichen */
+    unsigned char c = 0x80;
+
+    while ((c & 0x80) != 0 && shift < 64 && bitreader_has_next_char(reader))
+    {
+        c = bitreader_read_char(reader);
+        number |= (unsigned long long) (c & 0x7F) << shift;
+        shift += 7;
+    }
+
+    return number;
+}
+
+extern void bitwriter_write_varint(BITWRITER *writer, 
+                                   unsigned long long number)
+{
+    unsigned char buffer[MAX_VARINT_SIZE];
+
+    bitwriter_write_bytes(writer, buffer, store_varint(number, buffer));
+}
+
+extern size_t store_varint(unsigned long long number, unsigned char buffer[])
+{
+    size_t size = 0;
+
+    /* Je 7 Bits, beginnend mit den niederwertigsten, in ein Byte schreiben.
+     * Das höchstwertige Bit zeigt an, dass ein weiteres Byte folgt. */
+    while (number >= 0x80)
+    {
+        buffer[size] = (unsigned char) ((number & 0x7F) | 0x80);
+        number >>= 7;
+        size++;
     }
+    buffer[size] = (unsigned char) number;
+
+    return size + 1;
+}
+
+extern size_t load_varint(const unsigned char data[], size_t size,
+                          unsigned long long *number)
+{
+    unsigned int shift = 0;
+    size_t i = 0;
+
+    *number = 0;
+    while (i < size && shift < 64)
+    {
+        *number |= (unsigned long long) (data[i] & 0x7F) << shift;
+        shift += 7;
+        i++;
+        if ((data[i - 1] & 0x80) == 0)
+        {
+            return i;
+        }
+    }
+
+    /* Zahl nicht vollständig oder zu lang */
+    return 0;
 }
 
 /* ----------------------------------------------------------------------------
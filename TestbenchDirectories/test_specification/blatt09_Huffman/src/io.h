@@ -5,6 +5,21 @@
  * geschrieben wird. Das Modul bietet Funktionen an, um bit-, byte- und 
  * intweise zu lesen und zu schreiben.
  *
+ * Der Zustand einer Eingabe bzw. Ausgabe liegt in einem Kontext (#BITREADER
+ * bzw. #BITWRITER). Die Funktionen mit dem Praefix bitreader_ bzw. 
+ * bitwriter_ arbeiten auf einem uebergebenen Kontext, so dass mehrere 
+ * Dateien gleichzeitig und in verschiedenen Threads bearbeitet werden 
+ * koennen. Die Funktionen ohne Kontext arbeiten auf je einem 
+ * Standardkontext fuer die Eingabe- und die Ausgabedatei. Mit GCC und Clang
+ * hat jeder Thread eigene Standardkontexte.
+ *
+ * Beim bitweisen Lesen werden die Bits der Eingabe in einem 64-Bit-Fenster
+ * gesammelt, das mit bitreader_refill wortweise aus dem Eingabepuffer
+ * nachgefuellt wird. Mit bitreader_peek_bits und bitreader_consume_bits
+ * koennen Dekodierer mehrere Bits auf einmal ansehen und verbrauchen. Das
+ * Fenster entnimmt dem Puffer Zeichen im Voraus; nach dem ersten bitweisen
+ * Lesen darf daher nicht mehr byteweise gelesen werden.
+ *
  * @author Ulrike Griefahn
  * @date 2018-01-12
  */
@@ -13,12 +28,176 @@
 #define	IO_H
 /* ------------------------------------------------------------------------- */
 
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stdio.h>
+#include <stddef.h>
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Dateiname fuer die Standardeingabe bzw. die Standardausgabe */
+#define STDIO_FILENAME "-"
+
+/** Maximale Anzahl Bytes einer Zahl variabler Laenge mit 64 Bits */
+#define MAX_VARINT_SIZE 10
+
+/**
+ * Blockgroesse, mit der aus der Eingabedatei gelesen und in die Ausgabedatei 
+ * geschrieben wird.
+ */
+#define IO_BUFFER_SIZE 4096
+
+/**
+ * Maximale Anzahl Bits, die nach bitreader_refill ohne erneutes Nachfuellen
+ * angesehen und verbraucht werden koennen, sofern die Datei nicht vorher
+ * endet.
+ */
+#define BITREADER_MAX_BITS 57
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/**
+ * Fuellt das Bitfenster des Kontexts R nach, wenn es weniger als N Bits
+ * enthaelt. N darf hoechstens #BITREADER_MAX_BITS sein.
+ */
+#define BITREADER_ENSURE_BITS(R, N) \
+{if ((R)->window_bits < (int) (N)) { bitreader_refill(R); }}
+
+/**
+ * Liefert die naechsten N Bits des Kontexts R rechtsbuendig, ohne sie zu
+ * verbrauchen. N muss zwischen 1 und #BITREADER_MAX_BITS liegen, zuvor muss
+ * #BITREADER_ENSURE_BITS mit mindestens N aufgerufen worden sein. Bits
+ * hinter dem Dateiende sind 0.
+ */
+#define BITREADER_PEEK_BITS(R, N) ((R)->bit_window >> (64 - (N)))
+
+/**
+ * Verbraucht die naechsten N Bits des Kontexts R, die zuvor mit
+ * #BITREADER_PEEK_BITS angesehen wurden. Hinter dem Dateiende wird
+ * window_bits negativ.
+ */
+#define BITREADER_CONSUME_BITS(R, N) \
+{(R)->bit_window <<= (N); (R)->window_bits -= (int) (N);}
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Kontext einer zum Lesen geoeffneten Datei
+ */
+typedef struct
+{
+    /** Eingabestrom */
+    FILE *stream;
+
+    /** Puffer fuer den Eingabestrom */
+    unsigned char buffer[IO_BUFFER_SIZE];
+
+    /** Enthaelt die erste freie Position des Puffers nach dem letzten Zeichen */
+    int last_pos;
+
+    /** Aktuelle Position im Eingabepuffer */
+    int curr_pos;
+
+    /** 
+     * Die noch nicht verbrauchten Bits beim bitweisen Lesen, linksbuendig.
+     * Unterhalb der gueltigen Bits stehen 0-Bits oder bereits die 
+     * folgenden Bits der Eingabe.
+     */
+    unsigned long long bit_window;
+
+    /** 
+     * Anzahl der gueltigen Bits im Bitfenster, negativ, wenn ueber das 
+     * Dateiende hinaus gelesen wurde
+     */
+    int window_bits;
+
+    /** Vollstaendig im Speicher liegende Eingabedatei (siehe bitreader_map) */
+    unsigned char *map_data;
+
+    /** Groesse der im Speicher liegenden Eingabedatei */
+    size_t map_size;
+
+    /** true, wenn map_data eingeblendet und nicht allokiert wurde */
+    bool map_is_mapped;
+
+    /** 
+     * Anzahl der Leseaufrufe (fread bzw. mmap) und der dabei gelesenen 
+     * Bytes. Die Zaehler werden beim Oeffnen nicht zurueckgesetzt, ein 
+     * Kontext muss daher mit 0 initialisiert sein. Jedes Byte der Datei 
+     * wird nur einmal gezaehlt, auch wenn sie nach dem Lesen des Headers 
+     * mit bitreader_map eingeblendet wird.
+     */
+    unsigned long long read_calls;
+    unsigned long long bytes_read;
+} BITREADER;
+
+/**
+ * Kontext einer zum Schreiben geoeffneten Datei
+ */
+typedef struct
+{
+    /** Ausgabestrom */
+    FILE *stream;
+
+    /** Puffer fuer den Ausgabestrom */
+    unsigned char buffer[IO_BUFFER_SIZE];
+
+    /** Naechste freie Position im Ausgabepuffer */
+    int last_pos;
+
+    /**
+     * Bitakkumulator. Die zuletzt geschriebenen bit_count Bits stehen 
+     * rechtsbuendig im Akkumulator.
+     */
+    unsigned long long bit_buffer;
+
+    /** Anzahl der noch nicht in den Ausgabepuffer geschriebenen Bits */
+    int bit_count;
+
+    /** 
+     * Anzahl der Schreibaufrufe (fwrite) und der dabei geschriebenen Bytes, 
+     * wie bei #BITREADER ueber alle geoeffneten Dateien gezaehlt
+     */
+    unsigned long long write_calls;
+    unsigned long long bytes_written;
+} BITWRITER;
+
+/**
+ * Zugriffe der Standardkontexte auf die Dateien fuer die 
+ * Ausfuehrungsstatistik. Da Ein- und Ausgabe ueber eigene Puffer von 
+ * #IO_BUFFER_SIZE Bytes laufen, entspricht jeder Aufruf etwa einem 
+ * Systemaufruf read bzw. write.
+ */
+typedef struct
+{
+    /** Anzahl der Leseaufrufe und gelesene Bytes */
+    unsigned long long read_calls;
+    unsigned long long bytes_read;
+
+    /** Anzahl der Schreibaufrufe und geschriebene Bytes */
+    unsigned long long write_calls;
+    unsigned long long bytes_written;
+} IO_STATISTICS;
+
+
 /* ============================================================================
  * Funktions-Prototypen
  * ========================================================================= */
 
 /**
- * Oeffnet die uebergebene Datei zum Lesen
+ * Oeffnet die uebergebene Datei zum Lesen, fuer #STDIO_FILENAME die 
+ * Standardeingabe
  * 
  * @param filename zu oeffnende Datei
  * @return  liefert den Eingabestrom oder bricht das Programm ab, wenn die 
@@ -34,7 +213,8 @@ extern void open_infile(char filename[]);
 extern void close_infile(void);
 
 /**
- * Oeffnet die uebergebene Datei zum Schreiben
+ * Oeffnet die uebergebene Datei zum Schreiben, fuer #STDIO_FILENAME die 
+ * Standardausgabe
  * 
  * @param filename zu oeffnende Datei
  * @return  liefert den Ausgabestrom oder bricht das Programm ab, wenn die 
@@ -49,6 +229,37 @@ extern void open_outfile(char filename[]);
  */
 extern void close_outfile(void);
 
+/**
+ * Stellt den gesamten Inhalt der uebergebenen Datei im Speicher zur 
+ * Verfuegung. Regulaere Dateien werden dazu in den Speicher eingeblendet 
+ * (mmap), andere Eingaben wie Pipes werden mit einem grossen Lesezugriff 
+ * vollstaendig eingelesen. Es kann immer nur eine Datei gleichzeitig 
+ * eingeblendet sein.
+ * 
+ * @param filename  einzublendende Datei
+ * @param size      Groesse der Datei in Bytes
+ * @return          Inhalt der Datei oder NULL bei einer leeren Datei. Das
+ *                  Programm wird abgebrochen, wenn die Datei nicht gelesen
+ *                  werden konnte.
+ */
+extern const unsigned char *map_infile(char filename[], size_t *size);
+
+/**
+ * Liest den Rest der mit open_infile geoeffneten Datei vollstaendig in den
+ * Speicher. Dies ist auch fuer die Standardeingabe moeglich, die nicht 
+ * erneut geoeffnet werden kann.
+ * 
+ * @param size  Anzahl der gelesenen Bytes
+ * @return      die gelesenen Bytes, freizugeben mit unmap_infile
+ */
+extern const unsigned char *read_infile_rest(size_t *size);
+
+/**
+ * Gibt die mit map_infile oder read_infile_rest bereitgestellte Datei 
+ * wieder frei.
+ */
+extern void unmap_infile(void);
+
 /**
  * Liefert true, wenn noch mindestens ein weiteres Zeichen vorhanden ist.
  * 
@@ -62,6 +273,16 @@ extern bool has_next_char(void);
  */
 extern unsigned char read_char(void);
 
+/**
+ * Liest bis zu size Zeichen am Stueck aus dem Eingabestrom.
+ * 
+ * @param data  Speicher fuer die gelesenen Zeichen
+ * @param size  Anzahl der zu lesenden Zeichen
+ * @return      Anzahl der gelesenen Zeichen, weniger als size nur am Ende 
+ *              der Eingabe
+ */
+extern size_t read_bytes(unsigned char data[], size_t size);
+
 /**
  * Schreibt das Zeichen in den Ausgabestrom
  * 
@@ -69,6 +290,15 @@ extern unsigned char read_char(void);
  */
 extern void write_char(unsigned char c);
 
+/**
+ * Schreibt size Zeichen am Stueck in den Ausgabestrom. Darf nur aufgerufen
+ * werden, wenn keine einzelnen Bits mehr auf das Schreiben warten.
+ * 
+ * @param data  die zu schreibenden Zeichen
+ * @param size  Anzahl der zu schreibenden Zeichen
+ */
+extern void write_bytes(const unsigned char data[], size_t size);
+
 /**
  * Liefert true, wenn noch mindestens ein weiteres Bit vorhanden ist.
  * 
@@ -82,6 +312,23 @@ extern bool has_next_bit(void);
  */
 extern BIT read_bit(void);
 
+/**
+ * Liefert die naechsten count Bits aus dem Eingabestrom rechtsbuendig, ohne
+ * sie zu verbrauchen (siehe bitreader_peek_bits).
+ * 
+ * @param count Anzahl der Bits (1 bis #BITREADER_MAX_BITS)
+ * @return      die naechsten Bits, hinter dem Dateiende 0-Bits
+ */
+extern unsigned long long peek_bits(unsigned int count);
+
+/**
+ * Verbraucht die naechsten count Bits aus dem Eingabestrom (siehe
+ * bitreader_consume_bits).
+ * 
+ * @param count Anzahl der Bits (0 bis #BITREADER_MAX_BITS)
+ */
+extern void consume_bits(unsigned int count);
+
 /**
  * Schreibt das Zeichen c, das nur den Zahlwert 0 oder 1 haben darf in den 
  * Ausgabestrom
@@ -90,6 +337,17 @@ extern BIT read_bit(void);
  */
 extern void write_bit(BIT c);
 
+/**
+ * Schreibt die count niederwertigsten Bits von bits in den Ausgabestrom, 
+ * beginnend mit dem hoechstwertigen dieser Bits. Alle uebrigen Bits von bits 
+ * muessen 0 sein. Die Bits werden gesammelt und wortweise in den 
+ * Ausgabepuffer uebertragen.
+ * 
+ * @param bits  die zu schreibenden Bits, rechtsbuendig
+ * @param count Anzahl der zu schreibenden Bits (0 bis 64)
+ */
+extern void write_bits(unsigned long long bits, unsigned int count);
+
 /**
  * Liefert den naechsten Int-Wert aus dem Eingabestrom, ist kein vollständiger 
  * Int-Wert mehr im Eingabestrom vorhanden, werden die letzten Bytes ignoriert
@@ -107,6 +365,287 @@ extern unsigned int read_int(void);
  */
 extern void write_int(unsigned int i);
 
+/**
+ * Liefert die naechste Zahl variabler Laenge aus dem Eingabestrom. Die Zahl
+ * ist in Gruppen von 7 Bits abgelegt, beginnend mit den niederwertigsten
+ * Bits. Das hoechstwertige Bit jedes Bytes gibt an, ob ein weiteres Byte
+ * folgt.
+ * 
+ * @return naechste Zahl variabler Laenge
+ */
+extern unsigned long long read_varint(void);
+
+/**
+ * Schreibt die Zahl number mit variabler Laenge in den Ausgabestrom, d.h. 
+ * mit so vielen Bytes, wie fuer ihre Darstellung in 7-Bit-Gruppen noetig 
+ * sind.
+ * 
+ * @param number    die zu schreibende Zahl
+ */
+extern void write_varint(unsigned long long number);
+
+/**
+ * Legt die Zahl number mit variabler Laenge im Speicher ab, im selben Format
+ * wie write_varint.
+ * 
+ * @param number    die abzulegende Zahl
+ * @param buffer    Speicher fuer mindestens #MAX_VARINT_SIZE Bytes
+ * @return          Anzahl der abgelegten Bytes
+ */
+extern size_t store_varint(unsigned long long number, unsigned char buffer[]);
+
+/**
+ * Liest eine Zahl variabler Laenge aus dem Speicher, im selben Format wie
+ * read_varint.
+ * 
+ * @param data      Anfang der Zahl
+ * @param size      Anzahl der hoechstens zu lesenden Bytes
+ * @param number    die gelesene Zahl
+ * @return          Anzahl der gelesenen Bytes oder 0, wenn die Zahl nicht 
+ *                  vollstaendig ist
+ */
+extern size_t load_varint(const unsigned char data[], size_t size,
+                          unsigned long long *number);
+
+/* ----------------------------------------------------------------------------
+ * Funktionen mit Kontext. Sie entsprechen den gleichnamigen Funktionen ohne
+ * Praefix, arbeiten aber auf dem uebergebenen Kontext.
+ * ------------------------------------------------------------------------- */
+
+/**
+ * Liefert den Standardkontext der mit open_infile geoeffneten Datei, damit 
+ * haeufig aufgerufene Schleifen direkt auf dem Kontext arbeiten koennen.
+ * 
+ * @return  Kontext der Eingabedatei
+ */
+extern BITREADER *get_infile_reader(void);
+
+/**
+ * Liefert den Standardkontext der mit open_outfile geoeffneten Datei.
+ * 
+ * @return  Kontext der Ausgabedatei
+ */
+extern BITWRITER *get_outfile_writer(void);
+
+/**
+ * Liefert die Zugriffe der Standardkontexte des aufrufenden Threads auf die 
+ * Dateien seit dessen Start.
+ * 
+ * @param statistics    die Anzahl der Aufrufe und Bytes
+ */
+extern void get_io_statistics(IO_STATISTICS *statistics);
+
+/**
+ * Oeffnet die uebergebene Datei zum Lesen, fuer #STDIO_FILENAME die 
+ * Standardeingabe (siehe open_infile).
+ * 
+ * @param reader    zu initialisierender Kontext
+ * @param filename  zu oeffnende Datei
+ */
+extern void bitreader_open(BITREADER *reader, char filename[]);
+
+/**
+ * Schliesst die zum Lesen geoeffnete Datei (siehe close_infile).
+ * 
+ * @param reader    Kontext der Datei
+ */
+extern void bitreader_close(BITREADER *reader);
+
+/**
+ * Stellt den gesamten Inhalt der uebergebenen Datei im Speicher zur 
+ * Verfuegung (siehe map_infile). Der Kontext muss nicht geoeffnet sein.
+ * Ist in ihm dieselbe Datei noch geoeffnet, etwa nach dem Lesen des 
+ * Headers, werden die darueber bereits gelesenen Bytes nicht erneut 
+ * gezaehlt.
+ * 
+ * @param reader    Kontext, in dem die Daten verwaltet werden
+ * @param filename  einzublendende Datei
+ * @param size      Groesse der Datei in Bytes
+ * @return          Inhalt der Datei oder NULL bei einer leeren Datei
+ */
+extern const unsigned char *bitreader_map(BITREADER *reader, char filename[],
+                                          size_t *size);
+
+/**
+ * Liest den Rest der geoeffneten Datei in den Speicher (siehe 
+ * read_infile_rest).
+ * 
+ * @param reader    Kontext der Datei
+ * @param size      Anzahl der gelesenen Bytes
+ * @return          die gelesenen Bytes, freizugeben mit bitreader_unmap
+ */
+extern const unsigned char *bitreader_read_rest(BITREADER *reader, 
+                                                size_t *size);
+
+/**
+ * Gibt die im Speicher bereitgestellte Datei wieder frei (siehe 
+ * unmap_infile).
+ * 
+ * @param reader    Kontext der Datei
+ */
+extern void bitreader_unmap(BITREADER *reader);
+
+/**
+ * Liefert true, wenn noch mindestens ein weiteres Zeichen vorhanden ist.
+ * 
+ * @param reader    Kontext der Datei
+ * @return          true, wenn ein weiteres Zeichen vorhanden ist
+ */
+extern bool bitreader_has_next_char(BITREADER *reader);
+
+/**
+ * Liefert das naechste Zeichen, nachdem bitreader_has_next_char true 
+ * geliefert hat.
+ * 
+ * @param reader    Kontext der Datei
+ * @return          das naechste Zeichen
+ */
+extern unsigned char bitreader_read_char(BITREADER *reader);
+
+/**
+ * Liest bis zu size Zeichen am Stueck (siehe read_bytes).
+ * 
+ * @param reader    Kontext der Datei
+ * @param data      Speicher fuer die gelesenen Zeichen
+ * @param size      Anzahl der zu lesenden Zeichen
+ * @return          Anzahl der gelesenen Zeichen
+ */
+extern size_t bitreader_read_bytes(BITREADER *reader, unsigned char data[], 
+                                   size_t size);
+
+/**
+ * Liefert true, wenn noch mindestens ein weiteres Bit vorhanden ist.
+ * 
+ * @param reader    Kontext der Datei
+ * @return          true, wenn ein weiteres Bit vorhanden ist
+ */
+extern bool bitreader_has_next_bit(BITREADER *reader);
+
+/**
+ * Liefert das naechste Bit.
+ * 
+ * @param reader    Kontext der Datei
+ * @return          das naechste Bit
+ */
+extern BIT bitreader_read_bit(BITREADER *reader);
+
+/**
+ * Fuellt das Bitfenster auf mindestens #BITREADER_MAX_BITS gueltige Bits
+ * auf, solange die Datei nicht endet. Liegen noch 8 Zeichen im Puffer, wird
+ * ohne Schleife ein ganzes Wort geladen, sonst zeichenweise und am 
+ * Pufferende mit erneutem Lesen aus der Datei.
+ * 
+ * @param reader    Kontext der Datei
+ */
+extern void bitreader_refill(BITREADER *reader);
+
+/**
+ * Liefert die naechsten count Bits rechtsbuendig, ohne sie zu verbrauchen.
+ * Das Bitfenster wird bei Bedarf nachgefuellt; hinter dem Dateiende werden
+ * 0-Bits geliefert.
+ * 
+ * @param reader    Kontext der Datei
+ * @param count     Anzahl der Bits (1 bis #BITREADER_MAX_BITS)
+ * @return          die naechsten Bits
+ */
+extern unsigned long long bitreader_peek_bits(BITREADER *reader, 
+                                              unsigned int count);
+
+/**
+ * Verbraucht die naechsten count Bits. Hinter dem Dateiende werden keine
+ * Bits mehr verbraucht.
+ * 
+ * @param reader    Kontext der Datei
+ * @param count     Anzahl der Bits (0 bis #BITREADER_MAX_BITS)
+ */
+extern void bitreader_consume_bits(BITREADER *reader, unsigned int count);
+
+/**
+ * Liefert den naechsten Int-Wert (siehe read_int).
+ * 
+ * @param reader    Kontext der Datei
+ * @return          naechster Int-Wert
+ */
+extern unsigned int bitreader_read_int(BITREADER *reader);
+
+/**
+ * Liefert die naechste Zahl variabler Laenge (siehe read_varint).
+ * 
+ * @param reader    Kontext der Datei
+ * @return          naechste Zahl variabler Laenge
+ */
+extern unsigned long long bitreader_read_varint(BITREADER *reader);
+
+/**
+ * Oeffnet die uebergebene Datei zum Schreiben, fuer #STDIO_FILENAME die 
+ * Standardausgabe (siehe open_outfile).
+ * 
+ * @param writer    zu initialisierender Kontext
+ * @param filename  zu oeffnende Datei
+ */
+extern void bitwriter_open(BITWRITER *writer, char filename[]);
+
+/**
+ * Schreibt die verbliebenen Bits und schliesst die Datei (siehe 
+ * close_outfile).
+ * 
+ * @param writer    Kontext der Datei
+ */
+extern void bitwriter_close(BITWRITER *writer);
+
+/**
+ * Schreibt das Zeichen c.
+ * 
+ * @param writer    Kontext der Datei
+ * @param c         das zu schreibende Zeichen
+ */
+extern void bitwriter_write_char(BITWRITER *writer, unsigned char c);
+
+/**
+ * Schreibt size Zeichen am Stueck (siehe write_bytes).
+ * 
+ * @param writer    Kontext der Datei
+ * @param data      die zu schreibenden Zeichen
+ * @param size      Anzahl der zu schreibenden Zeichen
+ */
+extern void bitwriter_write_bytes(BITWRITER *writer, 
+                                  const unsigned char data[], size_t size);
+
+/**
+ * Schreibt das Bit bit.
+ * 
+ * @param writer    Kontext der Datei
+ * @param bit       das zu schreibende Bit
+ */
+extern void bitwriter_write_bit(BITWRITER *writer, BIT bit);
+
+/**
+ * Schreibt die count niederwertigsten Bits von bits (siehe write_bits).
+ * 
+ * @param writer    Kontext der Datei
+ * @param bits      die zu schreibenden Bits, rechtsbuendig
+ * @param count     Anzahl der zu schreibenden Bits (0 bis 64)
+ */
+extern void bitwriter_write_bits(BITWRITER *writer, unsigned long long bits, 
+                                 unsigned int count);
+
+/**
+ * Schreibt den Int-Wert i (siehe write_int).
+ * 
+ * @param writer    Kontext der Datei
+ * @param i         der zu schreibende Wert
+ */
+extern void bitwriter_write_int(BITWRITER *writer, unsigned int i);
+
+/**
+ * Schreibt die Zahl number mit variabler Laenge (siehe write_varint).
+ * 
+ * @param writer    Kontext der Datei
+ * @param number    die zu schreibende Zahl
+ */
+extern void bitwriter_write_varint(BITWRITER *writer, 
+                                   unsigned long long number);
+
 
 /* ------------------------------------------------------------------------- */
 #endif	/* IO_H */
@@ -14,7 +14,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 /* Splint definiert S_SPLINT_S. Da die Splint-Prüfung von stat.h zum parse
  * error und Abbruch führt, wird der folgende Codeteil von der Splint-Prüfung 
@@ -26,6 +25,11 @@
 
 #include "huffman_common.h"
 #include "huffman.h"
+#include "block.h"
+#include "io.h"
+#include "profile.h"
+#include "batch.h"
+#include "dictionary.h"
 
 
 /* ===========================================================================
@@ -40,7 +44,8 @@ typedef enum
     NO_MODE,
     HELP,
     COMPRESS,
-    DECOMPRESS
+    DECOMPRESS,
+    TRAIN
 } MODE;
 
 
@@ -54,15 +59,72 @@ typedef enum
 /** Kommandozeilen-Option fuer das Dekomprimieren */
 #define DECOMPRESS_OPTION "-d"
 
+/** Kommandozeilen-Option für die adaptive Kodierung in einem Durchlauf */
+#define ADAPTIVE_OPTION "-a"
+
 /** Kommandozeilen-Option für die Ausgabedatei */
 #define OUTFILE_OPTION "-o"
 
+/** Kommandozeilen-Option für das kanonische Format mit kompaktem Header */
+#define CANONICAL_OPTION "-k"
+
+/** Kommandozeilen-Option für das Kontextformat mit Codes je Vorgänger */
+#define CONTEXT_OPTION "-x"
+
+/** Kommandozeilen-Option für die maximale Codelänge im kanonischen Format */
+#define CODE_LENGTH_OPTION "-m"
+
+/** Kommandozeilen-Option für das blockweise Format mit Blockgröße in KiB */
+#define BLOCK_OPTION "-b"
+
+/** Kommandozeilen-Option für den Sprungindex mit Abstand in KiB */
+#define INDEX_OPTION "-i"
+
+/** Kommandozeilen-Option für die Dekomprimierung eines Bereichs */
+#define RANGE_OPTION "-r"
+
+/** Kommandozeilen-Option für die Anzahl der Threads */
+#define THREADS_OPTION "-t"
+
+/** Kommandozeilen-Option für das Verfahren der Dekodierung */
+#define DECODER_OPTION "-u"
+
+/** Wert der Option -u für die Dekodierung über den Huffman-Baum */
+#define DECODER_TREE_NAME "tree"
+
+/** Wert der Option -u für die Dekodierung über die Dekodiertabelle */
+#define DECODER_TABLE_NAME "table"
+
+/** Kommandozeilen-Option für das Verfahren der Kodierung */
+#define ENCODER_OPTION "-e"
+
+/** Wert der Option -e für die Kodierung von zwei Zeichen je Schritt */
+#define ENCODER_PAIRS_NAME "pairs"
+
+/** Wert der Option -e für die Kodierung von einem Zeichen je Schritt */
+#define ENCODER_SINGLE_NAME "single"
+
+/** Kommandozeilen-Option für den Stapelbetrieb mit Anzahl der Threads */
+#define BATCH_OPTION "-j"
+
+/** Kommandozeilen-Option für das Wörterbuch */
+#define DICTIONARY_OPTION "-D"
+
+/** Kommandozeilen-Option für das Trainieren eines Wörterbuchs */
+#define TRAIN_OPTION "-T"
+
+/** Präfix einer Manifestdatei mit den Dateien des Stapelbetriebs */
+#define MANIFEST_PREFIX '@'
+
 /** Kommandozeilen-Option für die Wahl der Komprimierungsstärke */
 #define LEVEL_OPTION "-l"
 
 /** Kommandozeilen-Option für die Ausgabe von Informationen */
 #define VERBOSE_OPTION "-v"
 
+/** Kommandozeilen-Option für die Ausgabe von Informationen mit JSON-Zeile */
+#define VERBOSE_JSON_OPTION "-vj"
+
 /** Kommandozeilen-Option für die Unterdrückung des Ausgabe von Informationen */
 #define HELP_OPTION "-h"
 
@@ -72,6 +134,36 @@ typedef enum
 /** Maximaler Level für Komprimierung */
 #define MAX_LEVEL 7
 
+/** Kleinster Level, der die Daten vor der Kodierung transformiert */
+#define MIN_TRANSFORM_LEVEL 4
+
+/** Minimale Codelänge, die als Maximum vorgegeben werden kann */
+#define MIN_CODE_LENGTH 1
+
+/** Maximale Codelänge, die als Maximum vorgegeben werden kann */
+#define MAX_CODE_LENGTH 56
+
+/** Minimale Blockgröße in KiB */
+#define MIN_BLOCK_SIZE 64
+
+/** Maximale Blockgröße in KiB */
+#define MAX_BLOCK_SIZE 65536
+
+/** Maximale Anzahl Threads */
+#define MAX_THREADS 256
+
+/** Minimaler Abstand der Sprungmarken in KiB */
+#define MIN_INDEX_INTERVAL 1
+
+/** Maximaler Abstand der Sprungmarken in KiB */
+#define MAX_INDEX_INTERVAL 65536
+
+/** Standard-Abstand der Sprungmarken in KiB */
+#define STD_INDEX_INTERVAL 64
+
+/** Bytes je MB für die Angabe des Durchsatzes */
+#define MEGABYTE 1000000.0
+
 /** ---------------------------------------------------------------------- */
 /** Dateiendung fuer die Ergebnisdatei, je nach Modus 'hc' oder 'hd' */
 #define GET_STD_SUFFIX(MODE) (((MODE) == COMPRESS) ? ".hc" : ".hd")
@@ -99,6 +191,42 @@ typedef enum
 /** Fehlermeldung wenn Ausgabedatei nicht angegeben wurde */
 #define EMSG_INVALID_LEVEL "Ungueltiger Level für Komprimierung."
 
+/** Fehlermeldung wenn die maximale Codelänge ungültig ist */
+#define EMSG_INVALID_CODE_LENGTH "Ungueltige maximale Codelaenge."
+
+/** Fehlermeldung wenn die Blockgröße ungültig ist */
+#define EMSG_INVALID_BLOCK_SIZE "Ungueltige Blockgroesse."
+
+/** Fehlermeldung wenn die Anzahl der Threads ungültig ist */
+#define EMSG_INVALID_THREADS "Ungueltige Anzahl Threads."
+
+/** Fehlermeldung wenn der Abstand des Sprungindex ungültig ist */
+#define EMSG_INVALID_INDEX_INTERVAL "Ungueltiger Abstand des Sprungindex."
+
+/** Fehlermeldung wenn das Verfahren der Dekodierung ungültig ist */
+#define EMSG_INVALID_DECODER "Ungueltiges Verfahren der Dekodierung, erwartet tree oder table."
+
+/** Fehlermeldung wenn das Verfahren der Kodierung ungültig ist */
+#define EMSG_INVALID_ENCODER "Ungueltiges Verfahren der Kodierung, erwartet pairs oder single."
+
+/** Fehlermeldung wenn der Sprungindex im gewählten Format nicht möglich ist */
+#define EMSG_INDEX_FORMAT "Die Option -i ist nicht mit -a, -x, -D oder -l4 bis -l7 erlaubt."
+
+/** Fehlermeldung wenn der Bereich ungültig ist */
+#define EMSG_INVALID_RANGE "Ungueltiger Bereich, erwartet <offset>:<length>."
+
+/** Fehlermeldung wenn eine Datei des Stapels ungültig ist */
+#define EMSG_INVALID_BATCH_FILE "Ungueltige Datei oder Manifestdatei im Stapel."
+
+/** Fehlermeldung wenn eine Option nicht im Stapelbetrieb erlaubt ist */
+#define EMSG_BATCH_OPTION "Die Optionen -o und -r sind im Stapelbetrieb und beim Trainieren nicht erlaubt."
+
+/** Fehlermeldung wenn das Wörterbuch nicht angegeben wurde */
+#define EMSG_DICTIONARY_MISSING "Es wurde kein Woerterbuch angegeben."
+
+/** Fehlermeldung wenn das Wörterbuch ungültig ist */
+#define EMSG_INVALID_DICTIONARY "Ungueltiges Woerterbuch."
+
 /** Fehlermeldung fuer unbekannte Option */
 #define EMSG_UNKNOWN_OPTION "Unbekannte Option."
 
@@ -133,10 +261,63 @@ static MODE mode = NO_MODE;
 static bool verbose = false;
 
 /**
- * Level der Komprimierung, wird derzeit nicht verwendet.
+ * Flag, ob die Ausführungsstatistik zusätzlich als JSON-Zeile ausgegeben 
+ * wird.
+ */
+static bool verbose_json = false;
+
+/**
+ * Level der Komprimierung, wählt Format und Vorverarbeitung, sofern diese 
+ * nicht ausdrücklich mit -a, -k, -b oder -x gewählt werden.
  */
 static int level = STD_LEVEL;
 
+/**
+ * Flag, ob das Format ausdrücklich über eine Option gewählt wurde.
+ */
+static bool format_selected = false;
+
+/**
+ * Einstellungen für die Komprimierung und Dekomprimierung
+ */
+static HUFFMAN_OPTIONS options;
+
+/**
+ * Flag, ob bei der Dekomprimierung nur ein Bereich ausgegeben wird
+ */
+static bool range_selected = false;
+
+/**
+ * Position des ersten und Anzahl der auszugebenden Zeichen des Bereichs
+ */
+static unsigned long long range_offset = 0;
+static unsigned long long range_length = 0;
+
+/**
+ * Flag, ob mehrere Dateien im Stapelbetrieb bearbeitet werden
+ */
+static bool batch_selected = false;
+
+/**
+ * Anzahl der Threads des Stapelbetriebs, 0 für die Anzahl der Prozessoren
+ */
+static unsigned int batch_threads = 0;
+
+/**
+ * Die Dateien des Stapelbetriebs bzw. die Sammlung für das Trainieren
+ */
+static BATCH batch;
+
+/**
+ * Name der Wörterbuchdatei, leer ohne Wörterbuch
+ */
+static char dictionary_filename[MAX_FILENAME + 1] = "";
+
+/**
+ * Das für alle Dateien einmal geladene Wörterbuch
+ */
+static DICTIONARY *dictionary = NULL;
+
 
 /* ===========================================================================
  * Funktionsprototypen
@@ -162,9 +343,40 @@ static void print_help();
  * and size of input and output files. If switched off, nothing ist done.
  * 
  * @param verbose   info is printed if set to true, 
- * @param prg_start cpu time at program start
+ * @param prg_start wall and cpu time at program start
+ */
+static void print_info(bool verbose, const PROFILE_TIME *prg_start);
+
+/**
+ * Prints the execution statistics as a single JSON line.
+ * 
+ * @param info      stream to print to
+ * @param in_size   size of the input file, 0 for stdin
+ * @param out_size  size of the output file, 0 for stdout
+ * @param total     wall and cpu time of the whole program
+ * @param io        calls and bytes of file accesses
+ */
+static void print_info_json(FILE *info, unsigned long long in_size,
+                            unsigned long long out_size, 
+                            const PROFILE_TIME *total, 
+                            const IO_STATISTICS *io);
+
+/**
+ * Prints the summed up sizes, run time and file accesses of all files of the
+ * batch if verbose is switched on.
+ * 
+ * @param verbose   info is printed if set to true, 
+ * @param prg_start wall and cpu time at program start
+ */
+static void print_batch_info(bool verbose, const PROFILE_TIME *prg_start);
+
+/**
+ * Trains a dictionary from the files of the batch and writes it to the 
+ * dictionary file.
+ * 
+ * @param corpus    the files to count
  */
-static void print_info(bool verbose, clock_t prg_start);
+static void train_dictionary(const BATCH *corpus);
 
 
 /* ===========================================================================
@@ -180,29 +392,95 @@ static void print_info(bool verbose, clock_t prg_start);
  */
 int main(int argc, char** argv)
 {
-    clock_t prg_start = clock();
+    PROFILE_TIME prg_start;
     int exit_status = EXIT_SUCCESS;
 
+    profile_now(&prg_start);
+    huffman_get_default_options(&options);
     exit_status = read_arguments(argc, argv);
 
     if (exit_status == EXIT_SUCCESS)
     {
+        /* Das Wörterbuch wird einmal für alle Dateien geladen */
+        if (mode != TRAIN && strcmp(dictionary_filename, "") != 0)
+        {
+            dictionary = dictionary_load(dictionary_filename);
+            if (dictionary == NULL)
+            {
+                fprintf(stderr, "[ERROR]: %s: %s\n", EMSG_INVALID_DICTIONARY,
+                        dictionary_filename);
+                exit(EXIT_DC_ERROR);
+            }
+            options.dictionary = dictionary;
+        }
+
+        huffman_set_options(&options);
+
+        /* Die Messung der Phasen ist nicht threadsicher */
+        if (verbose && !batch_selected)
+        {
+            profile_enable();
+        }
+
         switch (mode)
         {
         case COMPRESS:
-            compress(in_filename, out_filename); /* level nicht verwendet */
-            print_info(verbose, prg_start);
+            if (batch_selected)
+            {
+                /* Fehlgeschlagene Dateien brechen den Stapel nicht ab, 
+                 * werden aber im Rückgabewert gemeldet */
+                if (batch_run(&batch, batch_threads) > 0)
+                {
+                    exit_status = EXIT_IO_ERROR;
+                }
+                print_batch_info(verbose, &prg_start);
+                batch_destroy(&batch);
+            }
+            else
+            {
+                compress(in_filename, out_filename);
+                print_info(verbose, &prg_start);
+            }
             break;
 
         case DECOMPRESS:
-            decompress(in_filename, out_filename);
-            print_info(verbose, prg_start);
+            if (batch_selected)
+            {
+                /* Fehlgeschlagene Dateien brechen den Stapel nicht ab, 
+                 * werden aber im Rückgabewert gemeldet */
+                if (batch_run(&batch, batch_threads) > 0)
+                {
+                    exit_status = EXIT_IO_ERROR;
+                }
+                print_batch_info(verbose, &prg_start);
+                batch_destroy(&batch);
+            }
+            else
+            {
+                if (range_selected)
+                {
+                    decompress_range(in_filename, out_filename, range_offset, 
+                                     range_length);
+                }
+                else
+                {
+                    decompress(in_filename, out_filename);
+                }
+                print_info(verbose, &prg_start);
+            }
+            break;
+
+        case TRAIN:
+            train_dictionary(&batch);
+            batch_destroy(&batch);
             break;
 
         default:
             print_help();
             break;
         }
+
+        dictionary_destroy(&dictionary);
     }
     else
     {
@@ -217,6 +495,9 @@ static int read_arguments(int argc, char **argv)
     int i;
     int exit_status = EXIT_SUCCESS;
     bool resume = true;
+    /* Position des ersten Arguments, das keine Option ist, 0 wenn nur die 
+     * Eingabedatei folgt */
+    int first_file = 0;
 
     /* Sind genügend Argumente vorhanden? (mind. Eingabedatei) */
     if (argc < 2)
@@ -263,10 +544,203 @@ static int read_arguments(int argc, char **argv)
             {
                 mode = DECOMPRESS;
             }
+            else if (strcmp(argv[i], ADAPTIVE_OPTION) == 0)
+            {
+                options.format = FORMAT_ADAPTIVE;
+                format_selected = true;
+            }
             else if (strcmp(argv[i], VERBOSE_OPTION) == 0)
             {
                 verbose = true;
             }
+            else if (strcmp(argv[i], VERBOSE_JSON_OPTION) == 0)
+            {
+                verbose = true;
+                verbose_json = true;
+            }
+            else if (strcmp(argv[i], CANONICAL_OPTION) == 0)
+            {
+                options.format = FORMAT_CANONICAL;
+                format_selected = true;
+            }
+            else if (strcmp(argv[i], CONTEXT_OPTION) == 0)
+            {
+                options.format = FORMAT_CONTEXT;
+                format_selected = true;
+            }
+            else if (strncmp(argv[i], CODE_LENGTH_OPTION, 2) == 0)
+            {
+                /* CODE_LENGTH_OPTION: nächste Zeichen bilden die Codelänge */
+                int max_code_length = atoi(argv[i] + 2);
+
+                if (max_code_length < MIN_CODE_LENGTH 
+                    || max_code_length > MAX_CODE_LENGTH)
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", EMSG_INVALID_CODE_LENGTH);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+                else
+                {
+                    options.max_code_length = (unsigned int) max_code_length;
+                }
+            }
+            else if (strncmp(argv[i], BLOCK_OPTION, 2) == 0)
+            {
+                /* BLOCK_OPTION: optional folgt die Blockgröße in KiB */
+                int block_size = (argv[i][2] == '\0') 
+                        ? (int) (BLOCK_DEFAULT_SIZE / 1024)
+                        : atoi(argv[i] + 2);
+
+                if (block_size < MIN_BLOCK_SIZE || block_size > MAX_BLOCK_SIZE)
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", EMSG_INVALID_BLOCK_SIZE);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+                else
+                {
+                    options.format = FORMAT_BLOCKS;
+                    options.block_size = (unsigned int) block_size * 1024;
+                    format_selected = true;
+                }
+            }
+            else if (strncmp(argv[i], INDEX_OPTION, 2) == 0)
+            {
+                /* INDEX_OPTION: optional folgt der Abstand in KiB */
+                int interval = (argv[i][2] == '\0') 
+                        ? STD_INDEX_INTERVAL
+                        : atoi(argv[i] + 2);
+
+                if (interval < MIN_INDEX_INTERVAL 
+                    || interval > MAX_INDEX_INTERVAL)
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", 
+                            EMSG_INVALID_INDEX_INTERVAL);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+                else
+                {
+                    options.index_interval = (unsigned int) interval * 1024;
+                    
+                    /* Der Sprungindex gehört zum kanonischen Format */
+                    if (!format_selected)
+                    {
+                        options.format = FORMAT_CANONICAL;
+                        format_selected = true;
+                    }
+                }
+            }
+            else if (strncmp(argv[i], RANGE_OPTION, 2) == 0)
+            {
+                /* RANGE_OPTION: es folgen Position und Länge des Bereichs */
+                char *start = argv[i] + 2;
+                char *end;
+
+                range_offset = strtoull(start, &end, 10);
+                if (end != start && *end == ':')
+                {
+                    start = end + 1;
+                    range_length = strtoull(start, &end, 10);
+                    range_selected = end != start && *end == '\0';
+                }
+
+                if (!range_selected)
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", EMSG_INVALID_RANGE);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+            }
+            else if (strncmp(argv[i], THREADS_OPTION, 2) == 0)
+            {
+                /* THREADS_OPTION: nächste Zeichen bilden die Anzahl */
+                int threads = atoi(argv[i] + 2);
+
+                if (threads < 1 || threads > MAX_THREADS)
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", EMSG_INVALID_THREADS);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+                else
+                {
+                    options.threads = (unsigned int) threads;
+                }
+            }
+            else if (strncmp(argv[i], DECODER_OPTION, 2) == 0)
+            {
+                /* DECODER_OPTION: es folgt der Name des Verfahrens */
+                if (strcmp(argv[i] + 2, DECODER_TREE_NAME) == 0)
+                {
+                    options.decoder = DECODER_TREE;
+                }
+                else if (strcmp(argv[i] + 2, DECODER_TABLE_NAME) == 0)
+                {
+                    options.decoder = DECODER_TABLE;
+                }
+                else
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", EMSG_INVALID_DECODER);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+            }
+            else if (strncmp(argv[i], ENCODER_OPTION, 2) == 0)
+            {
+                /* ENCODER_OPTION: es folgt der Name des Verfahrens */
+                if (strcmp(argv[i] + 2, ENCODER_PAIRS_NAME) == 0)
+                {
+                    options.encoder = ENCODER_PAIRS;
+                }
+                else if (strcmp(argv[i] + 2, ENCODER_SINGLE_NAME) == 0)
+                {
+                    options.encoder = ENCODER_SINGLE;
+                }
+                else
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", EMSG_INVALID_ENCODER);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+            }
+            else if (strncmp(argv[i], BATCH_OPTION, 2) == 0)
+            {
+                /* BATCH_OPTION: optional folgt die Anzahl der Threads */
+                int threads = (argv[i][2] == '\0') ? 0 : atoi(argv[i] + 2);
+
+                if (threads < 0 || threads > MAX_THREADS
+                    || (threads == 0 && argv[i][2] != '\0'))
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", EMSG_INVALID_THREADS);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+                else
+                {
+                    batch_selected = true;
+                    batch_threads = (unsigned int) threads;
+                }
+            }
+            else if (strcmp(argv[i], TRAIN_OPTION) == 0)
+            {
+                mode = TRAIN;
+            }
+            else if (strncmp(argv[i], DICTIONARY_OPTION, 2) == 0)
+            {
+                /* DICTIONARY_OPTION: es folgt der Name der Wörterbuchdatei */
+                if (argv[i][2] == '\0')
+                {
+                    fprintf(stderr, "[ERROR]: %s\n\n", EMSG_DICTIONARY_MISSING);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+                else
+                {
+                    strncpy(dictionary_filename, argv[i] + 2, MAX_FILENAME);
+                    options.format = FORMAT_DICTIONARY;
+                    format_selected = true;
+                }
+            }
+            else if (argv[i][0] != '-')
+            {
+                /* Ab dem ersten Argument, das keine Option ist, folgen im
+                 * Stapelbetrieb die Dateien */
+                first_file = i;
+                resume = false;
+            }
             else if (strncmp(argv[i], LEVEL_OPTION, 2) == 0)
             {
                 /* LEVEL_OPTION: nächste Zeichen bilden die Zahl des Levels */
@@ -293,11 +767,85 @@ static int read_arguments(int argc, char **argv)
             i++;
         }
     
-        if (mode == NO_MODE)
+        /* Einen Sprungindex schreiben nur das kanonische und das blockweise
+         * Format, -i ersetzt nicht stillschweigend eine Transformation */
+        if (options.index_interval > 0
+            && ((options.format != FORMAT_CANONICAL 
+                 && options.format != FORMAT_BLOCKS)
+                || level >= MIN_TRANSFORM_LEVEL))
+        {
+            fprintf(stderr, "[ERROR]: %s\n\n", EMSG_INDEX_FORMAT);
+            exit_status = EXIT_OPTION_ERROR;
+        }
+
+        /* Format und Vorverarbeitung zum Level wählen */
+        if (!format_selected)
+        {
+            huffman_set_level(&options, (unsigned int) level);
+        }
+
+        if (first_file > 0 && !batch_selected && mode != TRAIN)
+        {
+            fprintf(stderr, "[ERROR]: %s: %s\n\n", EMSG_UNKNOWN_OPTION, 
+                    argv[first_file]);
+            exit_status = EXIT_OPTION_ERROR;
+        }
+        else if (mode == NO_MODE)
         {
             fprintf(stderr, "[ERROR]: %s\n\n", EMSG_MODE_MISSSING);
             exit_status = EXIT_OPTION_ERROR;
         }
+        else if ((batch_selected || mode == TRAIN) && mode != HELP)
+        {
+            if (strcmp(out_filename, "") != 0 || range_selected)
+            {
+                fprintf(stderr, "[ERROR]: %s\n\n", EMSG_BATCH_OPTION);
+                exit_status = EXIT_OPTION_ERROR;
+            }
+            if (mode == TRAIN && strcmp(dictionary_filename, "") == 0)
+            {
+                fprintf(stderr, "[ERROR]: %s\n\n", EMSG_DICTIONARY_MISSING);
+                exit_status = EXIT_OPTION_ERROR;
+            }
+
+            /* Die Dateien laufen bis einschließlich der Eingabedatei */
+            batch_init(&batch, mode == DECOMPRESS);
+            for (i = (first_file > 0) ? first_file : argc; 
+                 i <= argc && exit_status == EXIT_SUCCESS; i++)
+            {
+                if (!((argv[i][0] == MANIFEST_PREFIX)
+                      ? batch_add_manifest(&batch, argv[i] + 1, 
+                                           GET_STD_SUFFIX(mode))
+                      : batch_add_file(&batch, argv[i], GET_STD_SUFFIX(mode))))
+                {
+                    fprintf(stderr, "[ERROR]: %s: %s\n\n", 
+                            EMSG_INVALID_BATCH_FILE, argv[i]);
+                    exit_status = EXIT_OPTION_ERROR;
+                }
+            }
+
+            /* Die Threads verteilen die Dateien, nicht die Blöcke einer 
+             * Datei, sofern die Anzahl nicht mit -t vorgegeben ist */
+            if (options.threads == 0)
+            {
+                options.threads = 1;
+            }
+        }
+        else if (strcmp(in_filename, STDIO_FILENAME) == 0)
+        {
+            /* Standardeingabe: ohne Ausgabedatei auf die Standardausgabe */
+            if (strcmp(out_filename, "") == 0)
+            {
+                strncpy(out_filename, STDIO_FILENAME, MAX_FILENAME);
+            }
+
+            /* Ohne ausdrücklich gewähltes Format wird in einem Durchlauf
+             * komprimiert, ohne die Eingabe vollständig zu speichern */
+            if (mode == COMPRESS && options.format == FORMAT_LEGACY)
+            {
+                options.format = FORMAT_STREAM;
+            }
+        }
         else 
         {
             /* Standard-Ausgabedateinamen erstellen */
@@ -329,16 +877,69 @@ static int read_arguments(int argc, char **argv)
 static void print_help()
 {
     printf("Usage: huffman <options> infilename\n"
-           "  depending on options compresses oder decompresses infilename\n");
+           "  depending on options compresses oder decompresses infilename\n"
+           "  infilename '-' reads from stdin and writes to stdout unless -o\n"
+           "  is given; without -a, -k, -b or -x stdin is compressed in one pass\n");
     
     printf("Options are:\n");
     printf("  -c           compress file (mandatory) \n");
     printf("  -d           decompress file (mandatory) \n"
            "                  if options -c and -d are both given, the latter\n"
            "                  determines the mode of execution\n");
-    printf("  -l<level>    level (1-7) of compression (optional, default: 2) \n");
-    printf("  -v           prints size of outfile and used time to de-/compress (optional) \n");
-    printf("  -o <outfile> name of output file (optional)\n"
+    printf("  -a           compress adaptively in one pass without header\n"
+           "                  (optional, decompression detects the format)\n");
+    printf("  -l<level>    level (1-7) of compression (optional, default: 2)\n"
+           "                  1: fast parallel blocks, 2: classic format,\n"
+           "                  3: canonical codes, 4: run-length encoding,\n"
+           "                  5-7: BWT + move-to-front + run-length encoding\n"
+           "                  with growing block sizes; ignored with -a, -k, -b or -x\n");
+    printf("  -k           compress with canonical codes and a compact header (optional) \n");
+    printf("  -x           compress with one code table per preceding byte or group\n"
+           "                  of preceding bytes (order-1 context model, optional) \n");
+    printf("  -m<bits>     maximum code length (1-56) for options -k and -x (optional,\n"
+           "                  default: 24) \n");
+    printf("  -b[<KiB>]    compress independent blocks of the given size (64-65536)\n"
+           "                  in parallel (optional, default: 1024) \n");
+    printf("  -i[<KiB>]    write a seek index with a checkpoint every KiB (1-65536)\n"
+           "                  of input (optional, default: 64), implies -k unless\n"
+           "                  -b is given; not allowed with -a, -x, -D or\n"
+           "                  -l4 to -l7\n");
+    printf("  -r<off>:<len> decompress only <len> bytes starting at byte <off>\n"
+           "                  (optional, only with -d for files created with\n"
+           "                  -k, -i or -b or stored uncompressed)\n");
+    printf("  -t<threads>  number of threads for option -b and for decompressing\n"
+           "                  the default format (optional, default: number of\n"
+           "                  processors) \n");
+    printf("  -u<decoder>  decoder for the default format: 'table' resolves\n"
+           "                  several bits per step through a decode table,\n"
+           "                  'tree' walks the Huffman tree bit by bit\n"
+           "                  (optional, used by -d, default: table) \n");
+    printf("  -e<encoder>  encoder for the default format and options -k and -D:\n"
+           "                  'pairs' writes two bytes per step through a pair\n"
+           "                  table for inputs of 64 KiB and more, 'single' one\n"
+           "                  byte per step (optional, used by -c, default: pairs)\n");
+    printf("  -j[<threads>] batch mode: the last argument and all arguments after\n"
+           "                  the options are input files, @<file> names a\n"
+           "                  manifest with one input file per line; the files\n"
+           "                  are processed concurrently by the given number of\n"
+           "                  threads (optional, default: number of processors),\n"
+           "                  output files get the standard suffix; missing or\n"
+           "                  invalid input files are reported and skipped, the\n"
+           "                  exit state is then 3\n");
+    printf("  -D<dict>     compress with the codes of a pre-trained dictionary\n"
+           "                  instead of a frequency header, the file only\n"
+           "                  stores the dictionary id; decompressing such a\n"
+           "                  file needs the same dictionary (optional) \n");
+    printf("  -T           train a dictionary from the last argument and all\n"
+           "                  arguments after the options (@<file> names a\n"
+           "                  manifest) and write it to the file given with\n"
+           "                  -D, codes are at most -m bits long (max. 24) \n");
+    printf("  -v           prints size of outfile and used time to de-/compress,\n"
+           "                  wall and cpu time of each phase and number of\n"
+           "                  read/write calls (optional) \n");
+    printf("  -vj          like -v, additionally prints the statistics as one\n"
+           "                  JSON line (optional) \n");
+    printf("  -o <outfile> name of output file, '-' for stdout (optional)\n"
            "                  if option -o is not given, a standard suffix is added\n"
            "                  to the infilename: 'hc' in case of compression, 'hd' in\n"
            "                  case of decompression\n");
@@ -353,29 +954,193 @@ static void print_help()
     printf("  4:           error caused by compression/decompression\n\n");
 }
 
-static void print_info(bool verbose, clock_t prg_start)
+static void print_info(bool verbose, const PROFILE_TIME *prg_start)
 {
 #ifndef S_SPLINT_S
 
     if (verbose)
     {
         struct stat attribut;
-        clock_t prg_end = clock();
+        PROFILE_TIME prg_end;
+        PROFILE_TIME total;
+        PROFILE_TIME phase_time;
+        IO_STATISTICS io;
+        PROFILE_PHASE phase;
+        /* Größe der Ein- und Ausgabedatei, 0 für Standardströme */
+        unsigned long long in_size = 0;
+        unsigned long long out_size = 0;
+        /* Anzahl der unkomprimierten Zeichen für den Durchsatz */
+        unsigned long long plain_size;
+        /* Schreibt das Programm auf die Standardausgabe, werden die 
+         * Informationen auf die Fehlerausgabe umgeleitet */
+        FILE *info = (strcmp(out_filename, STDIO_FILENAME) == 0) 
+                ? stderr 
+                : stdout;
         
-        printf("\nAusfuehrungsstatistik\n");
+        profile_now(&prg_end);
+        total.wall = prg_end.wall - prg_start->wall;
+        total.cpu = prg_end.cpu - prg_start->cpu;
+        get_io_statistics(&io);
+        plain_size = (mode == COMPRESS) ? io.bytes_read : io.bytes_written;
+        
+        fprintf(info, "\nAusfuehrungsstatistik\n");
+        
+        if (strcmp(in_filename, STDIO_FILENAME) != 0)
+        {
+            stat(in_filename, &attribut);
+            in_size = (unsigned long long) attribut.st_size;
+            fprintf(info, " - Groesse der Eingabedatei %s (byte): %llu\n", 
+                    in_filename, in_size);
+        }
         
-        stat(in_filename, &attribut);
-        printf(" - Groesse der Eingabedatei %s (byte): %lu\n", 
-               in_filename, (unsigned long) attribut.st_size);
+        if (strcmp(out_filename, STDIO_FILENAME) != 0)
+        {
+            stat(out_filename, &attribut);
+            out_size = (unsigned long long) attribut.st_size;
+            fprintf(info, " - Groesse der Ausgabedatei %s (byte): %llu\n", 
+                    out_filename, out_size);
+        }
         
-        stat(out_filename, &attribut);
-        printf(" - Groesse der Ausgabedatei %s (byte): %lu\n", 
-               out_filename, (unsigned long) attribut.st_size);
+        if (mode == COMPRESS)
+        {
+            fprintf(info, " - Level der Komprimierung: %d\n", level);
+            if (in_size > 0 && out_size > 0)
+            {
+                fprintf(info, " - Kompressionsrate: %.2f %% (%.3f bit/Zeichen)\n",
+                        100.0 * (double) out_size / (double) in_size,
+                        8.0 * (double) out_size / (double) in_size);
+            }
+        }
         
-        printf(" - Die Programmlaufzeit betrug %.2f Sekunden\n",
-               (float) (prg_end - prg_start) / CLOCKS_PER_SEC);
+        fprintf(info, " - Gelesen: %llu byte in %llu Aufrufen, "
+                "geschrieben: %llu byte in %llu Aufrufen\n",
+                io.bytes_read, io.read_calls, 
+                io.bytes_written, io.write_calls);
         
-        printf("\n");
+        fprintf(info, " - Laufzeit der Phasen (Wanduhr / CPU in Sekunden):\n");
+        for (phase = PROFILE_READ; phase < PROFILE_PHASES; phase++)
+        {
+            profile_get(phase, &phase_time);
+            fprintf(info, "     %-8s %10.6f / %10.6f\n", 
+                    profile_get_name(phase), phase_time.wall, phase_time.cpu);
+        }
+        
+        fprintf(info, " - Die Programmlaufzeit betrug %.2f Sekunden "
+                "(CPU: %.2f Sekunden, %.2f MB/s)\n",
+                total.wall, total.cpu, 
+                (total.wall > 0.0) 
+                ? (double) plain_size / MEGABYTE / total.wall : 0.0);
+        
+        fprintf(info, "\n");
+        
+        if (verbose_json)
+        {
+            print_info_json(info, in_size, out_size, &total, &io);
+        }
     }
 #endif
 }
+
+static void print_info_json(FILE *info, unsigned long long in_size,
+                            unsigned long long out_size, 
+                            const PROFILE_TIME *total, 
+                            const IO_STATISTICS *io)
+{
+    PROFILE_TIME phase_time;
+    PROFILE_PHASE phase;
+    unsigned long long plain_size = (mode == COMPRESS) 
+            ? io->bytes_read 
+            : io->bytes_written;
+
+    fprintf(info, "{\"mode\": \"%s\", \"level\": %d, "
+            "\"in_size\": %llu, \"out_size\": %llu, "
+            "\"bytes_in\": %llu, \"bytes_out\": %llu, "
+            "\"read_calls\": %llu, \"write_calls\": %llu, "
+            "\"wall_s\": %.6f, \"cpu_s\": %.6f, \"mb_per_s\": %.2f, "
+            "\"phases\": {",
+            (mode == COMPRESS) ? "compress" : "decompress", level,
+            in_size, out_size, io->bytes_read, io->bytes_written,
+            io->read_calls, io->write_calls, total->wall, total->cpu,
+            (total->wall > 0.0) 
+            ? (double) plain_size / MEGABYTE / total->wall : 0.0);
+
+    for (phase = PROFILE_READ; phase < PROFILE_PHASES; phase++)
+    {
+        profile_get(phase, &phase_time);
+        fprintf(info, "%s\"%s\": {\"wall_s\": %.6f, \"cpu_s\": %.6f}",
+                (phase == PROFILE_READ) ? "" : ", ",
+                profile_get_name(phase), phase_time.wall, phase_time.cpu);
+    }
+
+    fprintf(info, "}}\n");
+}
+
+static void print_batch_info(bool verbose, const PROFILE_TIME *prg_start)
+{
+    if (verbose)
+    {
+        PROFILE_TIME prg_end;
+        PROFILE_TIME total;
+        IO_STATISTICS io;
+        /* Anzahl der unkomprimierten Zeichen für den Durchsatz */
+        unsigned long long plain_size;
+        double mb_per_s;
+
+        profile_now(&prg_end);
+        total.wall = prg_end.wall - prg_start->wall;
+        total.cpu = prg_end.cpu - prg_start->cpu;
+        batch_get_statistics(&batch, &io);
+        plain_size = (mode == COMPRESS) ? io.bytes_read : io.bytes_written;
+        mb_per_s = (total.wall > 0.0) 
+                ? (double) plain_size / MEGABYTE / total.wall 
+                : 0.0;
+
+        printf("\nAusfuehrungsstatistik\n");
+        printf(" - Anzahl der Dateien: %u\n", batch.count);
+        printf(" - Gelesen: %llu byte in %llu Aufrufen, "
+               "geschrieben: %llu byte in %llu Aufrufen\n",
+               io.bytes_read, io.read_calls, io.bytes_written, io.write_calls);
+
+        if (mode == COMPRESS && io.bytes_read > 0)
+        {
+            printf(" - Kompressionsrate: %.2f %% (%.3f bit/Zeichen)\n",
+                   100.0 * (double) io.bytes_written / (double) io.bytes_read,
+                   8.0 * (double) io.bytes_written / (double) io.bytes_read);
+        }
+
+        printf(" - Die Programmlaufzeit betrug %.2f Sekunden "
+               "(CPU: %.2f Sekunden, %.2f MB/s)\n",
+               total.wall, total.cpu, mb_per_s);
+        printf("\n");
+
+        if (verbose_json)
+        {
+            printf("{\"mode\": \"%s\", \"files\": %u, "
+                   "\"bytes_in\": %llu, \"bytes_out\": %llu, "
+                   "\"read_calls\": %llu, \"write_calls\": %llu, "
+                   "\"wall_s\": %.6f, \"cpu_s\": %.6f, \"mb_per_s\": %.2f}\n",
+                   (mode == COMPRESS) ? "compress" : "decompress", 
+                   batch.count, io.bytes_read, io.bytes_written,
+                   io.read_calls, io.write_calls, total.wall, total.cpu,
+                   mb_per_s);
+        }
+    }
+}
+
+static void train_dictionary(const BATCH *corpus)
+{
+    /* Häufigkeiten der Zeichen aller Dateien der Sammlung */
+    unsigned long long frequencys[MAX_CHARACTERS];
+    DICTIONARY *trained;
+    unsigned int i;
+
+    memset(frequencys, 0, sizeof (frequencys));
+    for (i = 0; i < corpus->count; i++)
+    {
+        dictionary_count(corpus->files[i].in_filename, frequencys);
+    }
+
+    trained = dictionary_create(frequencys, options.max_code_length);
+    dictionary_write(trained, dictionary_filename);
+    dictionary_destroy(&trained);
+}
@@ -0,0 +1,121 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <time.h>
+
+#include "huffman_common.h"
+#include "profile.h"
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Liest eine Uhr in Sekunden.
+ *
+ * @param clock_id  die Uhr
+ * @return          die Zeit der Uhr in Sekunden
+ */
+static double read_clock(clockid_t clock_id);
+
+
+/* ============================================================================
+ * Globale Variablen
+ * ========================================================================= */
+
+/** Flag, ob die Phasen gemessen werden */
+static bool enabled = false;
+
+/** aufsummierte Zeiten der Phasen */
+static PROFILE_TIME totals[PROFILE_PHASES];
+
+/** laufende Phase und Zeiten bei ihrem Beginn */
+static PROFILE_PHASE current_phase;
+static PROFILE_TIME phase_start;
+
+/** Namen der Phasen */
+static const char *const names[PROFILE_PHASES] = {
+    "read", "count", "tree", "codes", "header", "coding", "flush"
+};
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: profile_enable
+ * ------------------------------------------------------------------------ */
+extern void profile_enable(void)
+{
+    enabled = true;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: profile_begin
+ * ------------------------------------------------------------------------ */
+extern void profile_begin(PROFILE_PHASE phase)
+{
+    if (enabled)
+    {
+        current_phase = phase;
+        profile_now(&phase_start);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: profile_end
+ * ------------------------------------------------------------------------ */
+extern void profile_end(void)
+{
+    PROFILE_TIME now;
+
+    if (enabled)
+    {
+        profile_now(&now);
+        totals[current_phase].wall += now.wall - phase_start.wall;
+        totals[current_phase].cpu += now.cpu - phase_start.cpu;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: profile_get
+ * ------------------------------------------------------------------------ */
+extern void profile_get(PROFILE_PHASE phase, PROFILE_TIME *time)
+{
+    *time = totals[phase];
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: profile_get_name
+ * ------------------------------------------------------------------------ */
+extern const char *profile_get_name(PROFILE_PHASE phase)
+{
+    return names[phase];
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: profile_now
+ * ------------------------------------------------------------------------ */
+extern void profile_now(PROFILE_TIME *time)
+{
+    time->wall = read_clock(CLOCK_MONOTONIC);
+    time->cpu = read_clock(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: read_clock
+ * ------------------------------------------------------------------------ */
+static double read_clock(clockid_t clock_id)
+{
+    struct timespec now;
+
+    if (clock_gettime(clock_id, &now) != 0)
+    {
+        return 0.0;
+    }
+
+    return (double) now.tv_sec + (double) now.tv_nsec * 1e-9;
+}
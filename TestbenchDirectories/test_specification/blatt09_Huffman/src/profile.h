@@ -0,0 +1,122 @@
+/**
+ * @file
+ * Dieses Modul misst die Laufzeit der einzelnen Phasen einer Komprimierung
+ * bzw. Dekomprimierung für die Ausführungsstatistik (Option -v). Je Phase
+ * werden die Wanduhrzeit einer monotonen Uhr und die Rechenzeit aller
+ * Threads des Prozesses aufsummiert.
+ *
+ * Ist die Messung nicht eingeschaltet, kehren alle Funktionen nach einer
+ * einzigen Abfrage zurück, so dass die Markierungen der Phasen im Programm
+ * verbleiben können.
+ *
+ * Die Messung ist nicht threadsicher und wird nur vom Hauptthread
+ * aufgerufen. Laufen mehrere Phasen verschränkt in Threads ab (blockweise
+ * Formate), wird die gesamte Arbeit der Threads der Phase des Kodierens
+ * zugerechnet.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include "huffman_common.h"
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Gemessene Phasen in der Reihenfolge ihres Ablaufs
+ */
+typedef enum
+{
+    /** Einlesen bzw. Einblenden der Eingabedatei */
+    PROFILE_READ,
+    /** Zählen der Häufigkeiten */
+    PROFILE_COUNT,
+    /** Aufbau des Huffman-Baums bzw. Berechnung der Codelängen */
+    PROFILE_TREE,
+    /** Aufbau der Code- bzw. Dekodiertabelle */
+    PROFILE_CODES,
+    /** Schreiben bzw. Lesen des Headers */
+    PROFILE_HEADER,
+    /** Kodieren bzw. Dekodieren der Daten */
+    PROFILE_CODING,
+    /** Leeren der Puffer und Schließen der Dateien */
+    PROFILE_FLUSH,
+    /** Anzahl der Phasen */
+    PROFILE_PHASES
+} PROFILE_PHASE;
+
+/**
+ * Wanduhr- und Rechenzeit in Sekunden
+ */
+typedef struct
+{
+    /** vergangene Zeit der monotonen Uhr */
+    double wall;
+
+    /** verbrauchte Rechenzeit aller Threads */
+    double cpu;
+} PROFILE_TIME;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Schaltet die Messung der Phasen ein.
+ */
+extern void profile_enable(void);
+
+/**
+ * Beginnt die Messung einer Phase. Phasen dürfen nicht verschachtelt
+ * werden; eine Phase kann aber mehrfach gemessen werden, die Zeiten werden
+ * dann aufsummiert.
+ *
+ * @param phase     die beginnende Phase
+ */
+extern void profile_begin(PROFILE_PHASE phase);
+
+/**
+ * Beendet die Messung der zuletzt mit profile_begin begonnenen Phase.
+ */
+extern void profile_end(void);
+
+/**
+ * Liefert die aufsummierten Zeiten einer Phase.
+ *
+ * @param phase     die Phase
+ * @param time      die Zeiten der Phase
+ */
+extern void profile_get(PROFILE_PHASE phase, PROFILE_TIME *time);
+
+/**
+ * Liefert den Namen einer Phase für die Ausgabe.
+ *
+ * @param phase     die Phase
+ * @return          der Name, ohne Leer- und Sonderzeichen
+ */
+extern const char *profile_get_name(PROFILE_PHASE phase);
+
+/**
+ * Liest die aktuellen Zeiten unabhängig davon, ob die Messung
+ * eingeschaltet ist. Die Differenz zweier Aufrufe ergibt die Laufzeit
+ * eines Abschnitts.
+ *
+ * @param time      die aktuellen Zeiten
+ */
+extern void profile_now(PROFILE_TIME *time);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* PROFILE_H */
@@ -19,7 +19,29 @@
  * einer Erweiterung, .hc bzw. .hd, konstruiert wird. Mit der Option -c wird 
  * die Eingabedatei komprimiert und mit der Option -d wird sie dekomprimiert.
  * Mit der Option -v kann man sich Informationen zur Laufzeit und Größe der 
- * Dateien anziegen lassen.
+ * Dateien anziegen lassen. Dazu gehören die Wanduhr- und Rechenzeit jeder
+ * Phase sowie die Anzahl der Lese- und Schreibaufrufe; mit -vj folgt 
+ * zusätzlich eine JSON-Zeile zur maschinellen Auswertung.
+ *
+ * Als Eingabedatei kann - angegeben werden, um von der Standardeingabe zu 
+ * lesen. Ohne Option -o wird dann auf die Standardausgabe geschrieben, 
+ * bspw. in einer Pipeline:
+ * <ul>
+ * <li> $ cat in.txt | huffman -c - | huffman -d - > out.txt
+ * </ul>
+ * Ohne die Optionen -a, -k und -b wird die Standardeingabe dabei im Stromformat
+ * blockweise in einem Durchlauf komprimiert, ohne sie vollständig im 
+ * Speicher zu halten.
+ *
+ * Für viele kleine, ähnliche Dateien kann mit der Option -T aus einer 
+ * Sammlung von Dateien ein Wörterbuch trainiert und mit -D verwendet 
+ * werden. Die komprimierten Dateien speichern dann statt der Häufigkeiten
+ * nur die Kennung des Wörterbuchs:
+ * <ul>
+ * <li> $ huffman -T -Dtext.dict a.txt b.txt c.txt
+ * <li> $ huffman -c -Dtext.dict klein.txt
+ * <li> $ huffman -d -Dtext.dict klein.txt.hc
+ * </ul>
  *
  * @section Architektur
  * 
@@ -54,8 +76,11 @@
  * <ol>
  * <li> Einlesen der Häufigkeiten aus der komprimierten Datei
  * <li> Aufbau des optimalen Codebaums aus den Häufigkeiten
- * <li> Dekodieren der der Codetabelle nachfolgenden Zeichen anhand des 
- *      Codebaums und dekomprimierte Ausgabe in die Ausgabedatei.
+ * <li> Aufbau einer Dekodiertabelle aus den Codes des Codebaums
+ * <li> Dekodieren der der Codetabelle nachfolgenden Zeichen anhand der 
+ *      Dekodiertabelle und dekomprimierte Ausgabe in die Ausgabedatei.
+ *      Sind einzelne Codes zu lang für die Dekodiertabelle, wird stattdessen
+ *      der Codebaum mit den Bits des Bitfensters durchlaufen.
  * </ol>
  *
  * Um eine komprimierte Datei wieder dekomprimieren zu knnen, wird ein 
@@ -71,37 +96,156 @@
  *      n steht für die Anzahl verschiedener Zeichen in der Ausgangsdatei.
  * </ul>
  *
+ * Dateien ab 4 GiB passen nicht in diesen Header. Sie erhalten einen 
+ * Container-Header mit eigenem Format, in dem alle Anzahlen und 
+ * Häufigkeiten als Zahlen variabler Länge mit bis zu 64 Bit stehen; Baum 
+ * und Bitstrom sind unverändert. Kleinere Dateien werden weiterhin 
+ * byteweise identisch im ursprünglichen Format geschrieben.
+ *
+ * Vor dem Kodieren wird aus Häufigkeiten und Codelängen die genaue Größe 
+ * der komprimierten Datei berechnet. Ist sie nicht kleiner als die 
+ * unkodierten Daten mit einem kurzen Container-Header, etwa bei zufälligen
+ * oder bereits komprimierten Dateien, werden die Zeichen unverändert 
+ * kopiert. Das gilt auch für die Option -k.
+ *
+ * Mit der Option -k wird stattdessen ein kanonischer Code verwendet. Die
+ * Datei beginnt dann mit einem Container-Header aus Kennung, Format und 
+ * Version; danach folgen die Anzahl der Zeichen und lediglich die 
+ * Codelängen der vorkommenden Zeichen (siehe huffman.h und canonical.h). 
+ * Die Dekomprimierung benötigt in diesem Fall keinen Codebaum. Die Codes 
+ * sind im kanonischen Format auf eine maximale Länge beschränkt (Option -m, 
+ * standardmäßig 24 Bits).
+ *
+ * Mit der Option -i wird im kanonischen Format zusätzlich ein Sprungindex 
+ * geschrieben, der alle N KiB der Eingabe die Bitposition des Codes an 
+ * dieser Stelle festhält. Mit der Option -r<offset>:<length> dekomprimiert
+ * -d dann nur den angegebenen Bereich ab der letzten Sprungmarke davor. Im 
+ * blockweisen Format dient der Index der Blöcke demselben Zweck. Die übrigen
+ * Formate haben keinen Index, -i ist daher zusammen mit -a, -x, -D oder den
+ * Leveln 4 bis 7 ein Fehler in den Optionen.
+ *
  * @subsection io
  * 
  * Dieses Modul realisiert den lesenden und schreibenden Zugriff auf Dateien. 
  * Es können Daten in den Einheiten von 1 Bit, 1 Byte oder 4-Bytes gelesen oder
  * geschrieben werden. Bei der Einheit 1 Bit kapselt das Modul den byteweisen 
- * Zugriff auf die Datei.
+ * Zugriff auf die Datei. Ganze Codes werden in einem 64-Bit-Akkumulator 
+ * gesammelt und wortweise in den Ausgabepuffer geschrieben. Beim Lesen
+ * liegen die nächsten Bits in einem 64-Bit-Fenster, das wortweise aus dem
+ * Eingabepuffer nachgefüllt wird; die Dekodierer sehen mehrere Bits auf
+ * einmal an (peek) und verbrauchen danach die Länge des Codes (consume).
+ * Für die Komprimierung wird die Eingabedatei mit map_infile einmalig in den
+ * Speicher eingeblendet (mmap) bzw. bei Pipes vollständig eingelesen, so
+ * dass Zählen und Kodieren ohne erneutes Lesen über denselben Speicher
+ * laufen.
+ * Der Zustand jeder Datei liegt in einem Kontext (BITREADER bzw. 
+ * BITWRITER); die bisherigen Funktionen ohne Kontext arbeiten auf je einem 
+ * Standardkontext. Jeder Thread hat eigene Standardkontexte. So können mehrere Dateien gleichzeitig, auch in 
+ * verschiedenen Threads, gelesen und geschrieben werden.
  * 
- * @subsection frequency
+ * @subsection codetable
  * 
- * Dieses Modul stellt eine Datenstruktur zur Verfügung, um die Zeichen eines 
- * Textes mit ihren Häufigkeiten in Verbindung zu setzen.
+ * Dieses Modul erzeugt aus den Codes der Zeichen eine Dekodiertabelle, mit
+ * der je Schritt mehrere Bits ausgewertet werden, und für die Komprimierung
+ * eine Paartabelle, mit der je Schritt zwei Zeichen kodiert werden.
  * 
- * @subsection huffman_common
+ * @subsection canonical
  * 
- * In diesem Modul werden die gemeinsam verwendeten Definitionen definiert.
- *
- * @subsection b_heap
+ * Dieses Modul vergibt kanonische Codes zu gegebenen Codelängen, schreibt 
+ * und liest die Codelängen als kompakten Header und dekodiert anhand der 
+ * ersten Codes je Codelänge. Dekodiert wird im kanonischen Format jedoch 
+ * über die Dekodiertabelle des Moduls codetable, sofern kein Code länger 
+ * als #DECODE_MAX_CODE_LENGTH ist.
  * 
- * Dieses Modul realisiert einen binären Heap und stellt Funktionen zur 
- * Verfügung, um Elemente einzufügen und löschen zu können. Für die 
- * Huffman-Kodierung werden die optimalen Codebäume im Heap abgelegt.
- *
- * @subsection btree
+ * @subsection codelength
  * 
- * Dieses Modul stellt Binärbäume und Funktionen darauf zur Verfügung. Für die 
- * Huffman-Codierung werden die optimalen Codebäume als Binärbäume abgelegt.
- *
- * @subsection btreenode
+ * Dieses Modul berechnet mit dem Package-Merge-Verfahren optimale 
+ * Codelängen, die eine vorgegebene Maximallänge nicht überschreiten.
+ * 
+ * @subsection histogram
+ * 
+ * Dieses Modul zählt die Häufigkeiten der Zeichen mit mehreren verschränkten
+ * Teilhistogrammen und 64-Bit-Summen. Im kanonischen und im blockweisen 
+ * Format können damit auch Dateien über 4 GiB komprimiert werden.
+ * 
+ * @subsection block
+ * 
+ * Dieses Modul teilt die Eingabe mit der Option -b in unabhängige Blöcke, 
+ * die jeweils einen eigenen kanonischen Code erhalten. Über einen Index mit
+ * den Größen der komprimierten Blöcke können Komprimierung und 
+ * Dekomprimierung die Blöcke parallel bearbeiten.
+ * Jeder Block wird zusätzlich in vier Teilströme aufgeteilt, die der
+ * Dekodierer abwechselnd verfolgt, so dass auch ein einzelner Kern mehrere
+ * Codes gleichzeitig auswerten kann.
+ * 
+ * @subsection transform
  * 
- * Dieses Modul wird vom Modul btree verwendet. Es definiert die Knoten der 
- * Binärbäume und stellt Funktionen darauf zur Verfügung.
+ * Dieses Modul stellt die Vorverarbeitungen der Level 4 bis 7 bereit: 
+ * Burrows-Wheeler-Transformation, Move-To-Front und Lauflängenkodierung. 
+ * Mit der Option -l werden so Laufzeit und Kompressionsrate gegeneinander 
+ * abgewogen; die Option -v gibt Level und Kompressionsrate aus.
+ * 
+ * @subsection adaptive
+ * 
+ * Dieses Modul realisiert mit der Option -a die adaptive Huffman-Kodierung
+ * nach dem FGK-Verfahren. Kodierer und Dekodierer passen den Codebaum nach 
+ * jedem Zeichen an, so dass weder ein Header noch ein zweiter Durchlauf 
+ * benötigt wird und die Ausgabe sofort beginnt.
+ * 
+ * @subsection context
+ * 
+ * Dieses Modul realisiert mit der Option -x eine Huffman-Kodierung der 
+ * Ordnung 1: Jedes Zeichen wird mit der Codetabelle seines Vorgängers 
+ * kodiert. Selten vorkommende Vorgänger teilen sich eine gemeinsame Tabelle,
+ * so dass der Header auch bei kleinen Dateien kurz bleibt. Dekodiert wird 
+ * über eine Schnelltabelle je Codetabelle, lange Codes über eine 
+ * Dekodiertabelle.
+ * 
+ * @subsection batch
+ * 
+ * Dieses Modul bearbeitet mit der Option -j viele Dateien in einem 
+ * Programmaufruf. Die Dateien werden auf die Threads des Moduls threadpool
+ * verteilt; jeder Thread verwendet die Puffer seiner Standardkontexte des 
+ * Moduls io für alle seine Dateien weiter. Fehlende oder ungültige 
+ * Eingabedateien werden vorab aussortiert und gemeldet; die übrigen Dateien
+ * werden bearbeitet und das Programm endet danach mit Exit-Code 3.
+ * 
+ * @subsection speculative
+ * 
+ * Dieses Modul dekodiert Dateien des ursprünglichen Formats, die keinen
+ * Index enthalten, mit mehreren Threads. Der Bitstrom wird an beliebigen 
+ * Bitpositionen geteilt; jeder Abschnitt wird spekulativ dekodiert und 
+ * beim Zusammensetzen ab der ersten gemeinsamen Codegrenze mit der echten
+ * Dekodierung übernommen.
+ * 
+ * @subsection dictionary
+ * 
+ * Dieses Modul erzeugt aus den Häufigkeiten einer Sammlung von Dateien ein
+ * Wörterbuch mit einem festen kanonischen Code für alle Zeichen, schreibt
+ * und lädt es und berechnet seine Kennung.
+ * 
+ * @subsection threadpool
+ * 
+ * Dieses Modul verteilt nummerierte Aufgaben auf mehrere Threads. Die Anzahl
+ * der Threads kann mit der Option -t vorgegeben werden.
+ * 
+ * @subsection hufftree
+ * 
+ * Dieses Modul legt den Huffman-Baum des ursprünglichen Formats als flaches
+ * Array von Knoten mit Kindindizes in einem einzigen Speicherblock an und 
+ * leitet daraus die Codes der Zeichen ab. Der Baum wird über einen binären
+ * Heap aus Knotenindizes aufgebaut, so dass die Codes des ursprünglichen 
+ * Formats erhalten bleiben.
+ * 
+ * @subsection profile
+ * 
+ * Dieses Modul summiert für die Option -v die Wanduhrzeit einer monotonen 
+ * Uhr und die Rechenzeit je Phase der Komprimierung bzw. Dekomprimierung 
+ * auf. Ohne -v kosten die Markierungen der Phasen nur eine Abfrage.
+ * 
+ * @subsection huffman_common
+ * 
+ * In diesem Modul werden die gemeinsam verwendeten Definitionen definiert.
  *
  * @author Ulrike Griefahn
  * @date 2015-12-17
@@ -0,0 +1,575 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#include "huffman_common.h"
+#include "io.h"
+#include "codetable.h"
+#include "threadpool.h"
+#include "speculative.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+/**
+ * Anzahl der Bytes am Ende des Puffers, in denen vor dem Dateiende kein 
+ * Code beginnt. Ein Code, der vorher beginnt, liegt vollständig im Puffer.
+ */
+#define MARGIN_BYTES 8
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Ein Abschnitt des Bitstroms und die daraus dekodierten Zeichen
+ */
+typedef struct
+{
+    /** erstes Bit des Abschnitts, an dem spekulativ begonnen wird */
+    unsigned long long start_bit;
+
+    /** erstes Bit hinter dem Abschnitt */
+    unsigned long long end_bit;
+
+    /** Position des ersten Codes, der nicht mehr vor end_bit beginnt */
+    unsigned long long stop_bit;
+
+    /** Startpositionen der ersten #SPECULATIVE_SYNC_CODES Codes */
+    unsigned long long *sync_bits;
+
+    /** die dekodierten Zeichen */
+    unsigned char *out;
+
+    /** Anzahl der dekodierten Zeichen */
+    size_t count;
+
+    /** Anzahl der Zeichen, für die Speicher reserviert ist */
+    size_t capacity;
+
+    /** false, wenn die spekulative Dekodierung auf einen ungültigen Code
+     * gestoßen ist */
+    bool valid;
+} SPECULATIVE_CHUNK;
+
+/**
+ * Die allen Abschnitten gemeinsamen Daten für den Thread-Pool
+ */
+typedef struct
+{
+    /** die Dekodiertabelle */
+    const DECODE_TABLE *table;
+
+    /** Codelänge je Zeichen, für das erste Zeichen eines Zeichenpaares */
+    unsigned char lengths[MAX_CHARACTERS];
+
+    /** kleinste Codelänge */
+    unsigned int min_length;
+
+    /** der Bitstrom der aktuellen Runde */
+    const unsigned char *in;
+
+    /** Größe des Bitstroms in Bytes */
+    size_t in_size;
+
+    /** die Abschnitte */
+    SPECULATIVE_CHUNK *chunks;
+
+    /** maximale Anzahl der Abschnitte je Runde */
+    unsigned int chunk_count;
+
+    /** Anzahl der Threads */
+    unsigned int threads;
+
+    /** Speicher für die bis zur Synchronisation dekodierten Zeichen */
+    unsigned char *prefix;
+} SPECULATIVE_JOB;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Liefert die 64 Bits des Bitstroms ab einer beliebigen Bitposition,
+ * linksbündig. Davon sind mindestens 57 Bits gültig; hinter dem Ende des
+ * Bitstroms folgen 0-Bits.
+ *
+ * @param in        der Bitstrom
+ * @param in_size   Größe des Bitstroms in Bytes
+ * @param bit       Position des ersten Bits
+ * @return          die Bits ab der Position
+ */
+static unsigned long long load_window(const unsigned char in[], size_t in_size,
+                                      unsigned long long bit);
+
+/**
+ * Dekodiert alle Codes, die ab der Position expected und vor limit
+ * beginnen, parallel in Abschnitten und schreibt höchstens remaining
+ * Zeichen in den Ausgabestrom.
+ *
+ * @param job       Dekodiertabelle, Bitstrom der Runde und Abschnitte
+ * @param limit     Position, ab der kein Code mehr dekodiert wird
+ * @param expected  Position des nächsten echten Codes, danach des ersten
+ *                  Codes ab limit
+ * @param remaining Anzahl der noch zu schreibenden Zeichen
+ * @return          false, wenn der Bitstrom ungültige Codes enthält, 
+ *                  true sonst
+ */
+static bool decode_round(SPECULATIVE_JOB *job, unsigned long long limit,
+                         unsigned long long *expected,
+                         unsigned long long *remaining);
+
+/**
+ * Dekodiert die Codes, die ab der Position bit und vor end_bit beginnen,
+ * höchstens jedoch so viele Zeichen, wie im Abschnitt Platz haben. Setzt
+ * count und stop_bit des Abschnitts.
+ *
+ * @param job       Dekodiertabelle und Bitstrom
+ * @param chunk     der Abschnitt, der die Zeichen erhält
+ * @param bit       Position des ersten Codes
+ * @param end_bit   Position, ab der kein Code mehr dekodiert wird
+ * @param record    true, wenn die Startpositionen der ersten Codes
+ *                  gemerkt werden
+ * @return          false, wenn ein ungültiger Code gelesen wurde, true sonst
+ */
+static bool decode_chunk(const SPECULATIVE_JOB *job, SPECULATIVE_CHUNK *chunk,
+                         unsigned long long bit, unsigned long long end_bit,
+                         bool record);
+
+/**
+ * Dekodiert einen Abschnitt spekulativ ab seiner Grenze. Wird vom
+ * Thread-Pool aufgerufen.
+ *
+ * @param job       Dekodiertabelle, Bitstrom und Abschnitte
+ *                  (SPECULATIVE_JOB)
+ * @param index     Nummer des Abschnitts
+ */
+static void decode_speculative(void *job, unsigned int index);
+
+/**
+ * Dekodiert einen spekulativ dekodierten Abschnitt ab der Position seines
+ * ersten echten Codes, bis eine der gemerkten Startpositionen erreicht ist.
+ * Ab dort stimmen spekulative und echte Dekodierung überein. Endet der
+ * Abschnitt vorher, werden count und stop_bit des Abschnitts angepasst.
+ *
+ * @param job           Dekodiertabelle und Bitstrom
+ * @param chunk         der Abschnitt
+ * @param bit           Position des ersten echten Codes im Abschnitt
+ * @param prefix        Speicher für höchstens #SPECULATIVE_SYNC_CODES
+ *                      Zeichen, die bis zur Synchronisation dekodiert werden
+ * @param prefix_count  Anzahl der Zeichen in prefix
+ * @param first         Index des ersten spekulativ dekodierten Zeichens, 
+ *                      das nach prefix gilt
+ * @return              true, wenn die Dekodierung synchronisiert wurde, 
+ *                      false, wenn der Abschnitt neu dekodiert werden muss
+ */
+static bool find_sync(const SPECULATIVE_JOB *job, SPECULATIVE_CHUNK *chunk,
+                      unsigned long long bit, unsigned char prefix[],
+                      size_t *prefix_count, size_t *first);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: speculative_decode
+ * ------------------------------------------------------------------------ */
+extern bool speculative_decode(const DECODE_TABLE *table,
+                               const HUFF_CODE codes[],
+                               unsigned long long all_characters,
+                               unsigned int threads)
+{
+    SPECULATIVE_JOB job;
+    SPECULATIVE_CHUNK tail;
+    /* Bitstrom einer Runde und Anzahl der darin gelesenen Bytes */
+    unsigned char *buffer;
+    size_t buffer_size;
+    size_t filled = 0;
+    /* Bytes vor dem nächsten echten Code, die nicht übertragen werden */
+    size_t used;
+    unsigned long long remaining = all_characters;
+    /* Position des nächsten echten Codes im Puffer */
+    unsigned long long expected = 0;
+    /* Position, vor der alle Codes vollständig im Puffer liegen */
+    unsigned long long limit;
+    unsigned int i;
+    bool end_of_file = false;
+    bool valid = true;
+
+    if (threads == 0)
+    {
+        threads = threadpool_get_processors();
+    }
+
+    job.table = table;
+    job.threads = threads;
+    job.chunk_count = threads * SPECULATIVE_CHUNKS_PER_THREAD;
+    job.min_length = DECODE_MAX_CODE_LENGTH;
+    for (i = 0; i < MAX_CHARACTERS; i++)
+    {
+        job.lengths[i] = codes[i].length;
+        if (codes[i].length > 0 && codes[i].length < job.min_length)
+        {
+            job.min_length = codes[i].length;
+        }
+    }
+
+    buffer_size = (size_t) job.chunk_count * (SPECULATIVE_CHUNK_BITS / 8)
+                  + MARGIN_BYTES;
+    buffer = (unsigned char *) malloc(buffer_size);
+    ENSURE_ENOUGH_MEMORY(buffer, "speculative_decode");
+    job.in = buffer;
+
+    job.chunks = (SPECULATIVE_CHUNK *) calloc(job.chunk_count,
+                                              sizeof (SPECULATIVE_CHUNK));
+    ENSURE_ENOUGH_MEMORY(job.chunks, "speculative_decode");
+    for (i = 0; i < job.chunk_count; i++)
+    {
+        job.chunks[i].sync_bits = (unsigned long long *)
+                malloc(SPECULATIVE_SYNC_CODES * sizeof (unsigned long long));
+        ENSURE_ENOUGH_MEMORY(job.chunks[i].sync_bits, "speculative_decode");
+    }
+    job.prefix = (unsigned char *) malloc(SPECULATIVE_SYNC_CODES);
+    ENSURE_ENOUGH_MEMORY(job.prefix, "speculative_decode");
+
+    /* Der Bitstrom wird in Runden gelesen, so dass der Speicherbedarf 
+     * unabhängig von der Dateigröße ist */
+    while (valid && remaining > 0 && !end_of_file)
+    {
+        filled += read_bytes(buffer + filled, buffer_size - filled);
+        end_of_file = filled < buffer_size;
+        job.in_size = filled;
+
+        /* Vor dem Dateiende darf kein Code im Randbereich beginnen, damit 
+         * jeder Code vollständig im Puffer liegt */
+        limit = (unsigned long long) (end_of_file ? filled 
+                                                  : filled - MARGIN_BYTES) * 8;
+        valid = decode_round(&job, limit, &expected, &remaining);
+
+        /* Die Bytes ab dem nächsten echten Code an den Pufferanfang */
+        used = (size_t) (expected >> 3);
+        used = (used < filled) ? used : filled;
+        filled -= used;
+        memmove(buffer, buffer + used, filled);
+        expected -= (unsigned long long) used * 8;
+    }
+
+    /* Ein verkürzter Bitstrom wird wie bei der seriellen Dekodierung mit
+     * 0-Bits aufgefüllt */
+    job.in_size = filled;
+    tail.out = job.prefix;
+    while (valid && remaining > 0)
+    {
+        tail.capacity = (remaining < SPECULATIVE_SYNC_CODES)
+                ? (size_t) remaining
+                : SPECULATIVE_SYNC_CODES;
+        valid = decode_chunk(&job, &tail, expected, ULLONG_MAX, false);
+        write_bytes(tail.out, tail.count);
+        remaining -= tail.count;
+        expected = tail.stop_bit;
+    }
+
+    for (i = 0; i < job.chunk_count; i++)
+    {
+        free(job.chunks[i].out);
+        free(job.chunks[i].sync_bits);
+    }
+    free(job.chunks);
+    free(job.prefix);
+    free(buffer);
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_round
+ * ------------------------------------------------------------------------ */
+static bool decode_round(SPECULATIVE_JOB *job, unsigned long long limit,
+                         unsigned long long *expected,
+                         unsigned long long *remaining)
+{
+    SPECULATIVE_CHUNK *chunk;
+    unsigned long long range;
+    unsigned long long chunk_bits;
+    unsigned int chunk_count = job->chunk_count;
+    unsigned int i;
+    size_t capacity;
+    size_t prefix_count = 0;
+    size_t first = 0;
+    size_t count;
+    bool valid = true;
+
+    if (limit <= *expected)
+    {
+        return true;
+    }
+
+    /* Eine kurze Runde wird auf weniger Abschnitte verteilt */
+    range = limit - *expected;
+    if (range / chunk_count < SPECULATIVE_CHUNK_BITS)
+    {
+        chunk_count = (unsigned int) (range / SPECULATIVE_CHUNK_BITS);
+        chunk_count = (chunk_count > 0) ? chunk_count : 1;
+    }
+    chunk_bits = range / chunk_count;
+
+    for (i = 0; i < chunk_count; i++)
+    {
+        chunk = &job->chunks[i];
+        chunk->start_bit = *expected + chunk_bits * i;
+        chunk->end_bit = (i + 1 < chunk_count) 
+                         ? *expected + chunk_bits * (i + 1)
+                         : limit;
+
+        /* Jeder Code belegt mindestens min_length Bits */
+        capacity = (size_t) ((chunk->end_bit - chunk->start_bit)
+                             / job->min_length) + 2;
+        if (capacity > chunk->capacity)
+        {
+            chunk->out = (unsigned char *) realloc(chunk->out, capacity);
+            ENSURE_ENOUGH_MEMORY(chunk->out, "decode_round");
+            chunk->capacity = capacity;
+        }
+    }
+
+    threadpool_run(job->threads, chunk_count, decode_speculative, job);
+
+    /* Zusammensetzen: Der vorangehende Abschnitt liefert die Position des
+     * ersten echten Codes. Ab dort wird dekodiert, bis eine Codegrenze der
+     * spekulativen Dekodierung erreicht ist; ab dieser gelten deren 
+     * Zeichen. */
+    for (i = 0; valid && i < chunk_count && *remaining > 0; i++)
+    {
+        chunk = &job->chunks[i];
+
+        if (!chunk->valid 
+            || !find_sync(job, chunk, *expected, job->prefix, &prefix_count, 
+                          &first))
+        {
+            valid = decode_chunk(job, chunk, *expected, chunk->end_bit, 
+                                 false);
+            prefix_count = 0;
+            first = 0;
+        }
+
+        if (valid)
+        {
+            count = (prefix_count < *remaining) ? prefix_count 
+                                                : (size_t) *remaining;
+            write_bytes(job->prefix, count);
+            *remaining -= count;
+
+            count = chunk->count - first;
+            count = (count < *remaining) ? count : (size_t) *remaining;
+            write_bytes(chunk->out + first, count);
+            *remaining -= count;
+            *expected = chunk->stop_bit;
+        }
+    }
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: load_window
+ * ------------------------------------------------------------------------ */
+static unsigned long long load_window(const unsigned char in[], size_t in_size,
+                                      unsigned long long bit)
+{
+    size_t pos = (size_t) (bit >> 3);
+    unsigned long long word = 0;
+    const unsigned char *p;
+    size_t i;
+
+    if (pos < in_size && in_size - pos >= 8)
+    {
+        p = in + pos;
+        word = (unsigned long long) p[0] << 56
+               | (unsigned long long) p[1] << 48
+               | (unsigned long long) p[2] << 40
+               | (unsigned long long) p[3] << 32
+               | (unsigned long long) p[4] << 24
+               | (unsigned long long) p[5] << 16
+               | (unsigned long long) p[6] << 8
+               | (unsigned long long) p[7];
+    }
+    else
+    {
+        for (i = 0; i < 8 && pos < in_size && i < in_size - pos; i++)
+        {
+            word |= (unsigned long long) in[pos + i] << (56 - 8 * i);
+        }
+    }
+
+    return word << (bit & 7);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_chunk
+ * ------------------------------------------------------------------------ */
+static bool decode_chunk(const SPECULATIVE_JOB *job, SPECULATIVE_CHUNK *chunk,
+                         unsigned long long bit, unsigned long long end_bit,
+                         bool record)
+{
+    const DECODE_ENTRY *entries = job->table->entries;
+    const DECODE_ENTRY *entry;
+    /* die ab window_bit geladenen Bits und die daraus gelesenen Bits */
+    unsigned long long window = 0;
+    unsigned long long window_bit = 0;
+    unsigned long long bits;
+    /* Länge des ersten Codes eines Zeichenpaares */
+    unsigned int first_length;
+    unsigned int length;
+    size_t count = 0;
+    bool valid = true;
+
+    while (valid && bit < end_bit && count < chunk->capacity)
+    {
+        /* Von den mindestens 57 gültigen Bits werden erst neue geladen, 
+         * wenn weniger als ein Code der Maximallänge übrig ist */
+        if (count == 0 || bit - window_bit > 57 - DECODE_MAX_CODE_LENGTH)
+        {
+            window = load_window(job->in, job->in_size, bit);
+            window_bit = bit;
+        }
+        bits = window << (bit - window_bit);
+
+        entry = &entries[bits >> (64 - DECODE_PRIMARY_BITS)];
+        length = 0;
+
+        if (entry->count == DECODE_LINK)
+        {
+            length = DECODE_PRIMARY_BITS;
+            entry = &entries[entry->link
+                             + ((bits << DECODE_PRIMARY_BITS)
+                                >> (64 - entry->bits))];
+        }
+
+        if (entry->count == DECODE_INVALID)
+        {
+            valid = false;
+        }
+        else
+        {
+            length += entry->bits;
+
+            if (record && count < SPECULATIVE_SYNC_CODES)
+            {
+                chunk->sync_bits[count] = bit;
+            }
+            chunk->out[count++] = entry->symbols[0];
+
+            /* Das zweite Zeichen eines Paares gehört nur zum Abschnitt,
+             * wenn sein Code vor der Grenze beginnt */
+            if (entry->count == 2)
+            {
+                first_length = job->lengths[entry->symbols[0]];
+
+                if (bit + first_length < end_bit && count < chunk->capacity)
+                {
+                    if (record && count < SPECULATIVE_SYNC_CODES)
+                    {
+                        chunk->sync_bits[count] = bit + first_length;
+                    }
+                    chunk->out[count++] = entry->symbols[1];
+                }
+                else
+                {
+                    length = first_length;
+                }
+            }
+
+            bit += length;
+        }
+    }
+
+    chunk->count = count;
+    chunk->stop_bit = bit;
+
+    return valid;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: decode_speculative
+ * ------------------------------------------------------------------------ */
+static void decode_speculative(void *job, unsigned int index)
+{
+    SPECULATIVE_CHUNK *chunk = &((SPECULATIVE_JOB *) job)->chunks[index];
+
+    chunk->valid = decode_chunk((SPECULATIVE_JOB *) job, chunk,
+                                chunk->start_bit, chunk->end_bit, true);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: find_sync
+ * ------------------------------------------------------------------------ */
+static bool find_sync(const SPECULATIVE_JOB *job, SPECULATIVE_CHUNK *chunk,
+                      unsigned long long bit, unsigned char prefix[],
+                      size_t *prefix_count, size_t *first)
+{
+    /* nimmt je Schritt genau einen echten Code auf */
+    SPECULATIVE_CHUNK step;
+    size_t recorded = (chunk->count < SPECULATIVE_SYNC_CODES)
+                      ? chunk->count
+                      : SPECULATIVE_SYNC_CODES;
+    /* Index der nächsten gemerkten Startposition */
+    size_t j = 0;
+
+    *prefix_count = 0;
+    step.capacity = 1;
+
+    while (*prefix_count < SPECULATIVE_SYNC_CODES && bit < chunk->end_bit)
+    {
+        /* Beide Folgen von Codegrenzen sind aufsteigend */
+        while (j < recorded && chunk->sync_bits[j] < bit)
+        {
+            j++;
+        }
+
+        if (j == recorded)
+        {
+            return false;
+        }
+        if (chunk->sync_bits[j] == bit)
+        {
+            *first = j;
+            return true;
+        }
+
+        step.out = prefix + *prefix_count;
+        if (!decode_chunk(job, &step, bit, chunk->end_bit, false))
+        {
+            return false;
+        }
+        (*prefix_count)++;
+        bit = step.stop_bit;
+    }
+
+    if (bit >= chunk->end_bit)
+    {
+        /* Der Abschnitt endet, bevor beide Dekodierungen übereinstimmen */
+        *first = chunk->count;
+        chunk->stop_bit = bit;
+        return true;
+    }
+
+    return false;
+}
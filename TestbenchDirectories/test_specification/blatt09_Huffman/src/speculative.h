@@ -0,0 +1,86 @@
+/**
+ * @file
+ * Dieses Modul dekodiert den Bitstrom einer Datei im ursprünglichen Format
+ * (#FORMAT_LEGACY) parallel, obwohl das Format keinen Index enthält. Der
+ * Bitstrom wird an beliebigen Bitpositionen in Abschnitte geteilt, die mit
+ * dem Modul threadpool gleichzeitig dekodiert werden. Jeder Abschnitt außer
+ * dem ersten beginnt spekulativ an seiner Grenze, obwohl dort im
+ * Allgemeinen kein Code beginnt.
+ *
+ * Huffman-Codes synchronisieren sich selbst: Eine an falscher Stelle
+ * begonnene Dekodierung trifft nach wenigen Codes auf eine echte
+ * Codegrenze und liefert ab dort dieselben Zeichen wie die korrekte. Jeder
+ * Abschnitt merkt sich daher die Startpositionen seiner ersten
+ * #SPECULATIVE_SYNC_CODES Codes. Beim anschließenden Zusammensetzen ist aus
+ * dem vorangehenden Abschnitt bekannt, wo der erste echte Code des
+ * Abschnitts beginnt. Von dort wird seriell dekodiert, bis eine der
+ * gemerkten Startpositionen erreicht ist; ab dieser werden die spekulativ
+ * dekodierten Zeichen übernommen. Wird keine erreicht, wird der Abschnitt
+ * ab der echten Position vollständig neu dekodiert.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef SPECULATIVE_H
+#define SPECULATIVE_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "codetable.h"
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** 
+ * Größe eines Abschnitts in Bits. Je Runde wird der Bitstrom für alle
+ * Abschnitte gelesen; eine kürzere letzte Runde wird auf entsprechend 
+ * weniger Abschnitte verteilt.
+ */
+#define SPECULATIVE_CHUNK_BITS (1u << 20)
+
+/** Anzahl der Abschnitte je Thread und Runde, für gleich ausgelastete Threads */
+#define SPECULATIVE_CHUNKS_PER_THREAD 4
+
+/** Anzahl der Codes, deren Startposition je Abschnitt gemerkt wird */
+#define SPECULATIVE_SYNC_CODES 4096
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Liest den restlichen Bitstrom einer Datei im ursprünglichen Format aus 
+ * dem Eingabestrom, dekodiert ihn parallel und schreibt die Zeichen in den
+ * Ausgabestrom. Der Bitstrom wird in Runden von 
+ * #SPECULATIVE_CHUNKS_PER_THREAD Abschnitten je Thread gelesen, so dass
+ * der Speicherbedarf nicht von der Dateigröße abhängt. Wie bei der
+ * seriellen Dekodierung wird hinter dem Ende des Bitstroms mit 0-Bits 
+ * aufgefüllt.
+ *
+ * @param table             die Dekodiertabelle der Codes
+ * @param codes             die Codes der #MAX_CHARACTERS Zeichen, aus denen
+ *                          die Dekodiertabelle erzeugt wurde
+ * @param all_characters    Anzahl der zu dekodierenden Zeichen
+ * @param threads           Anzahl der Threads, 0 für die Anzahl der
+ *                          Prozessoren
+ * @return                  false, wenn der Bitstrom ungültige Codes enthält,
+ *                          true sonst
+ */
+extern bool speculative_decode(const DECODE_TABLE *table,
+                               const HUFF_CODE codes[],
+                               unsigned long long all_characters,
+                               unsigned int threads);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* SPECULATIVE_H */
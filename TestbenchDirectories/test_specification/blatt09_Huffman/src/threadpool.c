@@ -0,0 +1,178 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+
+/* Splint definiert S_SPLINT_S. Die POSIX-Header für Threads werden von der 
+ * Splint-Prüfung ausgeklammert. */
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(S_SPLINT_S)
+#define USE_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "huffman_common.h"
+#include "threadpool.h"
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Gemeinsamer Zustand aller Threads eines Pools
+ */
+typedef struct
+{
+    /** Funktion, die eine Aufgabe bearbeitet */
+    THREADPOOL_TASK task;
+
+    /** die allen Aufgaben gemeinsamen Daten */
+    void *context;
+
+    /** Anzahl der Aufgaben */
+    unsigned int tasks;
+
+    /** Nummer der nächsten noch nicht vergebenen Aufgabe */
+    unsigned int next;
+
+#ifdef USE_THREADS
+    /** schützt next */
+    pthread_mutex_t lock;
+#endif
+} THREADPOOL;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+#ifdef USE_THREADS
+/**
+ * Arbeitsschleife eines Threads: holt solange die nächste Aufgabe und
+ * bearbeitet sie, bis keine Aufgaben mehr vorhanden sind.
+ *
+ * @param pool  der Pool, zu dem der Thread gehört
+ * @return      immer NULL
+ */
+static void *threadpool_work(void *pool);
+#endif
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: threadpool_get_processors
+ * ------------------------------------------------------------------------ */
+extern unsigned int threadpool_get_processors(void)
+{
+    unsigned int processors = 1;
+
+#if defined(USE_THREADS) && defined(_SC_NPROCESSORS_ONLN)
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+
+    if (online > 0)
+    {
+        processors = (online > THREADPOOL_MAX_THREADS)
+                ? THREADPOOL_MAX_THREADS
+                : (unsigned int) online;
+    }
+#endif
+
+    return processors;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: threadpool_run
+ * ------------------------------------------------------------------------ */
+extern void threadpool_run(unsigned int threads, unsigned int tasks,
+                           THREADPOOL_TASK task, void *context)
+{
+    THREADPOOL pool;
+
+    pool.task = task;
+    pool.context = context;
+    pool.tasks = tasks;
+    pool.next = 0;
+
+    if (threads == 0)
+    {
+        threads = threadpool_get_processors();
+    }
+    if (threads > THREADPOOL_MAX_THREADS)
+    {
+        threads = THREADPOOL_MAX_THREADS;
+    }
+    if (threads > tasks)
+    {
+        threads = tasks;
+    }
+
+#ifdef USE_THREADS
+    if (threads > 1)
+    {
+        pthread_t workers[THREADPOOL_MAX_THREADS];
+        unsigned int started = 0;
+
+        (void) pthread_mutex_init(&pool.lock, NULL);
+
+        /* Kann ein Thread nicht gestartet werden, arbeiten entsprechend 
+         * weniger Threads */
+        while (started < threads - 1
+               && pthread_create(&workers[started], NULL,
+                                 threadpool_work, &pool) == 0)
+        {
+            started++;
+        }
+
+        (void) threadpool_work(&pool);
+
+        while (started > 0)
+        {
+            started--;
+            (void) pthread_join(workers[started], NULL);
+        }
+
+        (void) pthread_mutex_destroy(&pool.lock);
+        return;
+    }
+#endif
+
+    /* ohne Threads alle Aufgaben im aufrufenden Thread bearbeiten */
+    for (pool.next = 0; pool.next < tasks; pool.next++)
+    {
+        task(context, pool.next);
+    }
+}
+
+#ifdef USE_THREADS
+/* ---------------------------------------------------------------------------
+ * Funktion: threadpool_work
+ * ------------------------------------------------------------------------ */
+static void *threadpool_work(void *pool)
+{
+    THREADPOOL *p = (THREADPOOL *) pool;
+    unsigned int index;
+
+    for (;;)
+    {
+        (void) pthread_mutex_lock(&p->lock);
+        index = p->next;
+        if (index < p->tasks)
+        {
+            p->next++;
+        }
+        (void) pthread_mutex_unlock(&p->lock);
+
+        if (index >= p->tasks)
+        {
+            return NULL;
+        }
+
+        p->task(p->context, index);
+    }
+}
+#endif
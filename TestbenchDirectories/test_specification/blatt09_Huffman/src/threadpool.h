@@ -0,0 +1,65 @@
+/**
+ * @file
+ * Dieses Modul verteilt voneinander unabhängige Aufgaben auf mehrere Threads.
+ * Die Aufgaben sind von 0 an durchnummeriert. Jeder Thread des Pools holt 
+ * sich die jeweils nächste noch nicht bearbeitete Aufgabe, bis alle 
+ * Aufgaben erledigt sind. Steht keine Thread-Bibliothek zur Verfügung, 
+ * werden die Aufgaben nacheinander im aufrufenden Thread bearbeitet.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Maximale Anzahl der Threads eines Pools */
+#define THREADPOOL_MAX_THREADS 256
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Funktion, die eine einzelne Aufgabe bearbeitet.
+ *
+ * @param context   die allen Aufgaben gemeinsamen Daten
+ * @param index     Nummer der zu bearbeitenden Aufgabe
+ */
+typedef void (*THREADPOOL_TASK)(void *context, unsigned int index);
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Liefert die Anzahl der verfügbaren Prozessoren.
+ *
+ * @return  Anzahl der Prozessoren, mindestens 1
+ */
+extern unsigned int threadpool_get_processors(void);
+
+/**
+ * Bearbeitet die Aufgaben 0 bis tasks - 1 mit höchstens threads Threads und
+ * kehrt zurück, wenn alle Aufgaben erledigt sind. Der aufrufende Thread
+ * bearbeitet selbst Aufgaben mit.
+ *
+ * @param threads   maximale Anzahl der Threads, 0 für die Anzahl der
+ *                  Prozessoren
+ * @param tasks     Anzahl der Aufgaben
+ * @param task      Funktion, die eine Aufgabe bearbeitet
+ * @param context   die allen Aufgaben gemeinsamen Daten
+ */
+extern void threadpool_run(unsigned int threads, unsigned int tasks,
+                           THREADPOOL_TASK task, void *context);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* THREADPOOL_H */
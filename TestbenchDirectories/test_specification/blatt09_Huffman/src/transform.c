@@ -0,0 +1,622 @@
+/* ============================================================================
+ * Includes
+ * ========================================================================= */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "huffman_common.h"
+#include "io.h"
+#include "threadpool.h"
+#include "transform.h"
+
+
+/* ============================================================================
+ * Makros
+ * ========================================================================= */
+
+/** Anzahl gleicher Zeichen, nach der die Anzahl der Wiederholungen folgt */
+#define RLE_RUN 4
+
+/** Maximale Anzahl Wiederholungen je Zählbyte */
+#define RLE_MAX_REPEAT 255
+
+/**
+ * Makro zur Prüfung, ob die Speicherallokation erfolgreich war. Das Programm
+ * wird im Fehlerfall mit EXIT_FAILURE beendet.
+ */
+#define ENSURE_ENOUGH_MEMORY(VAR, FUNCTION) \
+{if (VAR == NULL) { printf(FUNCTION ": not enough memory\n"); \
+                    exit(EXIT_FAILURE); }}
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Ein Block der BWT und sein transformiertes Gegenstück
+ */
+typedef struct
+{
+    /** die Zeichen des Blocks */
+    const unsigned char *plain;
+
+    /** Anzahl der Zeichen des Blocks */
+    size_t plain_size;
+
+    /** Index der ursprünglichen Zeile und letzte Spalte */
+    unsigned char *packed;
+
+    /** Größe von packed in Bytes */
+    size_t packed_size;
+} BWT_BLOCK;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Transformiert einen Block mit der BWT. Wird vom Thread-Pool aufgerufen.
+ *
+ * @param blocks    die Blöcke (BWT_BLOCK)
+ * @param index     Nummer des zu transformierenden Blocks
+ */
+static void bwt_encode_block(void *blocks, unsigned int index);
+
+/**
+ * Sortiert alle Rotationen von s durch Verdoppeln der verglichenen 
+ * Präfixlänge. Je Verdopplung wird mit zwei stabilen Zählsortierungen nach
+ * den Rängen beider Hälften sortiert.
+ *
+ * @param s     die Zeichen
+ * @param n     Anzahl der Zeichen, mindestens 1
+ * @param sa    Array, in das die Anfangspositionen der sortierten 
+ *              Rotationen geschrieben werden
+ */
+static void sort_rotations(const unsigned char s[], unsigned int n,
+                           unsigned int sa[]);
+
+/**
+ * Macht die BWT eines Blocks rückgängig.
+ *
+ * @param last      letzte Spalte der sortierten Rotationen
+ * @param n         Anzahl der Zeichen
+ * @param primary   Zeile der ursprünglichen Zeichenfolge
+ * @param out       Speicher für die n ursprünglichen Zeichen
+ */
+static void bwt_decode_block(const unsigned char last[], unsigned int n,
+                             unsigned int primary, unsigned char out[]);
+
+/**
+ * Wendet Move-To-Front auf die Daten an.
+ *
+ * @param data  die zu transformierenden Daten, werden überschrieben
+ * @param size  Größe der Daten in Bytes
+ */
+static void mtf_encode(unsigned char data[], size_t size);
+
+/**
+ * Macht Move-To-Front rückgängig.
+ *
+ * @param data  die transformierten Daten, werden überschrieben
+ * @param size  Größe der Daten in Bytes
+ */
+static void mtf_decode(unsigned char data[], size_t size);
+
+/**
+ * Lauflängenkodiert die Daten.
+ *
+ * @param data      die zu kodierenden Daten
+ * @param size      Größe der Daten in Bytes
+ * @param out_size  Größe der kodierten Daten in Bytes
+ * @return          die kodierten Daten, freizugeben mit free
+ */
+static unsigned char *rle_encode(const unsigned char data[], size_t size,
+                                 size_t *out_size);
+
+/**
+ * Macht die Lauflängenkodierung rückgängig.
+ *
+ * @param data      die kodierten Daten
+ * @param size      Größe der kodierten Daten in Bytes
+ * @param max_size  maximale Größe der dekodierten Daten in Bytes
+ * @param out_size  Größe der dekodierten Daten in Bytes
+ * @return          die dekodierten Daten, freizugeben mit free, oder NULL,
+ *                  wenn sie größer als max_size wären
+ */
+static unsigned char *rle_decode(const unsigned char data[], size_t size,
+                                 size_t max_size, size_t *out_size);
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: transform_forward
+ * ------------------------------------------------------------------------ */
+extern unsigned char *transform_forward(const unsigned char data[], 
+                                        size_t size,
+                                        unsigned int transforms,
+                                        size_t block_size,
+                                        unsigned int threads,
+                                        size_t *out_size)
+{
+    unsigned char *result;
+    unsigned char *encoded;
+    size_t result_size = 0;
+    unsigned int block_count;
+    unsigned int i;
+
+    if ((transforms & TRANSFORM_BWT) != 0)
+    {
+        BWT_BLOCK *blocks;
+
+        block_count = (unsigned int) ((size + block_size - 1) / block_size);
+        blocks = (BWT_BLOCK *) calloc(block_count + 1, sizeof (BWT_BLOCK));
+        ENSURE_ENOUGH_MEMORY(blocks, "transform_forward");
+
+        for (i = 0; i < block_count; i++)
+        {
+            blocks[i].plain = data + (size_t) i * block_size;
+            blocks[i].plain_size = (i + 1 < block_count)
+                    ? block_size
+                    : size - (size_t) i * block_size;
+        }
+
+        threadpool_run(threads, block_count, bwt_encode_block, blocks);
+
+        result = (unsigned char *) malloc(size + (size_t) block_count 
+                                          * MAX_VARINT_SIZE + 1);
+        ENSURE_ENOUGH_MEMORY(result, "transform_forward");
+        for (i = 0; i < block_count; i++)
+        {
+            memcpy(result + result_size, blocks[i].packed, 
+                   blocks[i].packed_size);
+            result_size += blocks[i].packed_size;
+            free(blocks[i].packed);
+        }
+        free(blocks);
+    }
+    else
+    {
+        result = (unsigned char *) malloc(size + 1);
+        ENSURE_ENOUGH_MEMORY(result, "transform_forward");
+        memcpy(result, data, size);
+        result_size = size;
+    }
+
+    if ((transforms & TRANSFORM_MTF) != 0)
+    {
+        mtf_encode(result, result_size);
+    }
+
+    if ((transforms & TRANSFORM_RLE) != 0)
+    {
+        encoded = rle_encode(result, result_size, &result_size);
+        free(result);
+        result = encoded;
+    }
+
+    *out_size = result_size;
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: transform_inverse
+ * ------------------------------------------------------------------------ */
+extern unsigned char *transform_inverse(const unsigned char data[],
+                                        size_t size,
+                                        unsigned int transforms,
+                                        size_t block_size,
+                                        size_t original_size)
+{
+    unsigned char *buffer;
+    unsigned char *result;
+    size_t buffer_size = size;
+    /* Größe vor der Lauflängenkodierung: bei der BWT kommt je Block der 
+     * Index der ursprünglichen Zeile hinzu */
+    size_t max_size = original_size;
+    unsigned int block_count = 0;
+
+    if ((transforms & ~TRANSFORM_ALL) != 0
+        || ((transforms & TRANSFORM_BWT) != 0 
+            && (block_size == 0 || block_size > TRANSFORM_MAX_BLOCK_SIZE)))
+    {
+        return NULL;
+    }
+
+    if ((transforms & TRANSFORM_BWT) != 0)
+    {
+        block_count = (unsigned int) ((original_size + block_size - 1) 
+                                      / block_size);
+        max_size += (size_t) block_count * MAX_VARINT_SIZE;
+    }
+
+    if ((transforms & TRANSFORM_RLE) != 0)
+    {
+        buffer = rle_decode(data, size, max_size, &buffer_size);
+        if (buffer == NULL)
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        buffer = (unsigned char *) malloc(size + 1);
+        ENSURE_ENOUGH_MEMORY(buffer, "transform_inverse");
+        memcpy(buffer, data, size);
+    }
+
+    if ((transforms & TRANSFORM_MTF) != 0)
+    {
+        mtf_decode(buffer, buffer_size);
+    }
+
+    if ((transforms & TRANSFORM_BWT) == 0)
+    {
+        if (buffer_size != original_size)
+        {
+            free(buffer);
+            return NULL;
+        }
+        return buffer;
+    }
+
+    result = (unsigned char *) malloc(original_size + 1);
+    ENSURE_ENOUGH_MEMORY(result, "transform_inverse");
+    {
+        unsigned long long primary;
+        size_t pos = 0;
+        size_t used;
+        size_t n;
+        unsigned int i;
+
+        for (i = 0; i < block_count; i++)
+        {
+            n = (i + 1 < block_count) 
+                    ? block_size 
+                    : original_size - (size_t) i * block_size;
+
+            used = load_varint(buffer + pos, buffer_size - pos, &primary);
+            if (used == 0 || primary >= n || buffer_size - pos - used < n)
+            {
+                free(buffer);
+                free(result);
+                return NULL;
+            }
+            pos += used;
+
+            bwt_decode_block(buffer + pos, (unsigned int) n, 
+                             (unsigned int) primary, 
+                             result + (size_t) i * block_size);
+            pos += n;
+        }
+
+        if (pos != buffer_size)
+        {
+            free(buffer);
+            free(result);
+            return NULL;
+        }
+    }
+
+    free(buffer);
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: bwt_encode_block
+ * ------------------------------------------------------------------------ */
+static void bwt_encode_block(void *blocks, unsigned int index)
+{
+    BWT_BLOCK *block = &((BWT_BLOCK *) blocks)[index];
+    unsigned int n = (unsigned int) block->plain_size;
+    unsigned int *sa;
+    unsigned char *last;
+    unsigned int primary = 0;
+    unsigned int i;
+
+    sa = (unsigned int *) malloc(n * sizeof (unsigned int));
+    ENSURE_ENOUGH_MEMORY(sa, "bwt_encode_block");
+    block->packed = (unsigned char *) malloc(MAX_VARINT_SIZE + n);
+    ENSURE_ENOUGH_MEMORY(block->packed, "bwt_encode_block");
+
+    sort_rotations(block->plain, n, sa);
+
+    /* Die letzte Spalte enthält je Rotation das Zeichen vor ihrem Anfang */
+    for (i = 0; i < n; i++)
+    {
+        if (sa[i] == 0)
+        {
+            primary = i;
+        }
+    }
+    block->packed_size = store_varint(primary, block->packed);
+    last = block->packed + block->packed_size;
+    for (i = 0; i < n; i++)
+    {
+        last[i] = block->plain[(sa[i] == 0) ? n - 1 : sa[i] - 1];
+    }
+    block->packed_size += n;
+
+    free(sa);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: sort_rotations
+ * ------------------------------------------------------------------------ */
+static void sort_rotations(const unsigned char s[], unsigned int n,
+                           unsigned int sa[])
+{
+    /* Rang jeder Rotation bzgl. der ersten length Zeichen */
+    unsigned int *rank;
+    unsigned int *tmp;
+    unsigned int *count;
+    unsigned int classes;
+    unsigned int length;
+    unsigned int i;
+
+    rank = (unsigned int *) malloc(n * sizeof (unsigned int));
+    tmp = (unsigned int *) malloc(n * sizeof (unsigned int));
+    count = (unsigned int *) malloc((n + MAX_CHARACTERS) 
+                                    * sizeof (unsigned int));
+    ENSURE_ENOUGH_MEMORY(rank, "sort_rotations");
+    ENSURE_ENOUGH_MEMORY(tmp, "sort_rotations");
+    ENSURE_ENOUGH_MEMORY(count, "sort_rotations");
+
+    /* nach dem ersten Zeichen sortieren */
+    memset(count, 0, MAX_CHARACTERS * sizeof (unsigned int));
+    for (i = 0; i < n; i++)
+    {
+        count[s[i]]++;
+    }
+    for (i = 1; i < MAX_CHARACTERS; i++)
+    {
+        count[i] += count[i - 1];
+    }
+    for (i = n; i-- > 0; )
+    {
+        sa[--count[s[i]]] = i;
+    }
+    classes = 1;
+    rank[sa[0]] = 0;
+    for (i = 1; i < n; i++)
+    {
+        if (s[sa[i]] != s[sa[i - 1]])
+        {
+            classes++;
+        }
+        rank[sa[i]] = classes - 1;
+    }
+
+    /* Solange noch gleiche Ränge vorkommen, die Präfixlänge verdoppeln. 
+     * Periodische Blöcke haben gleiche Rotationen, daher endet die Schleife
+     * spätestens bei length >= n. */
+    for (length = 1; length < n && classes < n; length *= 2)
+    {
+        /* Nach der zweiten Hälfte sortiert ergibt sich die Reihenfolge aus 
+         * der bisherigen Sortierung, um length Zeichen verschoben */
+        for (i = 0; i < n; i++)
+        {
+            tmp[i] = (sa[i] >= length) ? sa[i] - length : sa[i] + n - length;
+        }
+
+        /* stabil nach der ersten Hälfte sortieren */
+        memset(count, 0, classes * sizeof (unsigned int));
+        for (i = 0; i < n; i++)
+        {
+            count[rank[tmp[i]]]++;
+        }
+        for (i = 1; i < classes; i++)
+        {
+            count[i] += count[i - 1];
+        }
+        for (i = n; i-- > 0; )
+        {
+            sa[--count[rank[tmp[i]]]] = tmp[i];
+        }
+
+        /* neue Ränge aus beiden Hälften vergeben */
+        classes = 1;
+        tmp[sa[0]] = 0;
+        for (i = 1; i < n; i++)
+        {
+            unsigned int current = sa[i];
+            unsigned int previous = sa[i - 1];
+            unsigned int current_second = current + length;
+            unsigned int previous_second = previous + length;
+
+            current_second -= (current_second >= n) ? n : 0;
+            previous_second -= (previous_second >= n) ? n : 0;
+
+            if (rank[current] != rank[previous]
+                || rank[current_second] != rank[previous_second])
+            {
+                classes++;
+            }
+            tmp[current] = classes - 1;
+        }
+        memcpy(rank, tmp, n * sizeof (unsigned int));
+    }
+
+    free(rank);
+    free(tmp);
+    free(count);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: bwt_decode_block
+ * ------------------------------------------------------------------------ */
+static void bwt_decode_block(const unsigned char last[], unsigned int n,
+                             unsigned int primary, unsigned char out[])
+{
+    /* Zeile der Rotation, die ein Zeichen früher beginnt */
+    unsigned int *previous;
+    unsigned int start[MAX_CHARACTERS];
+    unsigned int sum = 0;
+    unsigned int row = primary;
+    unsigned int i;
+    int c;
+
+    previous = (unsigned int *) malloc((n + 1) * sizeof (unsigned int));
+    ENSURE_ENOUGH_MEMORY(previous, "bwt_decode_block");
+
+    memset(start, 0, sizeof (start));
+    for (i = 0; i < n; i++)
+    {
+        start[last[i]]++;
+    }
+    for (c = 0; c < MAX_CHARACTERS; c++)
+    {
+        unsigned int count = start[c];
+
+        start[c] = sum;
+        sum += count;
+    }
+    for (i = 0; i < n; i++)
+    {
+        previous[i] = start[last[i]]++;
+    }
+
+    /* Von der ursprünglichen Zeile aus rückwärts rekonstruieren */
+    for (i = n; i-- > 0; )
+    {
+        out[i] = last[row];
+        row = previous[row];
+    }
+
+    free(previous);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: mtf_encode
+ * ------------------------------------------------------------------------ */
+static void mtf_encode(unsigned char data[], size_t size)
+{
+    unsigned char order[MAX_CHARACTERS];
+    unsigned char c;
+    unsigned int j;
+    size_t i;
+
+    for (j = 0; j < MAX_CHARACTERS; j++)
+    {
+        order[j] = (unsigned char) j;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        c = data[i];
+        for (j = 0; order[j] != c; j++)
+        {
+        }
+        memmove(order + 1, order, j);
+        order[0] = c;
+        data[i] = (unsigned char) j;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: mtf_decode
+ * ------------------------------------------------------------------------ */
+static void mtf_decode(unsigned char data[], size_t size)
+{
+    unsigned char order[MAX_CHARACTERS];
+    unsigned char c;
+    unsigned int j;
+    size_t i;
+
+    for (j = 0; j < MAX_CHARACTERS; j++)
+    {
+        order[j] = (unsigned char) j;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        j = data[i];
+        c = order[j];
+        memmove(order + 1, order, j);
+        order[0] = c;
+        data[i] = c;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: rle_encode
+ * ------------------------------------------------------------------------ */
+static unsigned char *rle_encode(const unsigned char data[], size_t size,
+                                 size_t *out_size)
+{
+    /* Aus je RLE_RUN Zeichen werden höchstens RLE_RUN + 1 Bytes */
+    unsigned char *out = (unsigned char *) malloc(size + size / RLE_RUN + 1);
+    unsigned int run = 0;
+    unsigned int repeat;
+    size_t pos = 0;
+    size_t i = 0;
+
+    ENSURE_ENOUGH_MEMORY(out, "rle_encode");
+
+    while (i < size)
+    {
+        run = (run > 0 && data[i] == out[pos - 1]) ? run + 1 : 1;
+        out[pos++] = data[i++];
+
+        if (run == RLE_RUN)
+        {
+            for (repeat = 0; 
+                 repeat < RLE_MAX_REPEAT && i < size && data[i] == out[pos - 1];
+                 repeat++)
+            {
+                i++;
+            }
+            out[pos++] = (unsigned char) repeat;
+            run = 0;
+        }
+    }
+
+    *out_size = pos;
+    return out;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: rle_decode
+ * ------------------------------------------------------------------------ */
+static unsigned char *rle_decode(const unsigned char data[], size_t size,
+                                 size_t max_size, size_t *out_size)
+{
+    unsigned char *out = (unsigned char *) malloc(max_size + 1);
+    unsigned int run = 0;
+    size_t pos = 0;
+    size_t i = 0;
+
+    ENSURE_ENOUGH_MEMORY(out, "rle_decode");
+
+    while (i < size)
+    {
+        if (pos >= max_size)
+        {
+            free(out);
+            return NULL;
+        }
+        run = (run > 0 && data[i] == out[pos - 1]) ? run + 1 : 1;
+        out[pos++] = data[i++];
+
+        if (run == RLE_RUN && i < size)
+        {
+            if (data[i] > max_size - pos)
+            {
+                free(out);
+                return NULL;
+            }
+            memset(out + pos, out[pos - 1], data[i]);
+            pos += data[i++];
+            run = 0;
+        }
+    }
+
+    *out_size = pos;
+    return out;
+}
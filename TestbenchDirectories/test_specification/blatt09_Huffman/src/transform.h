@@ -0,0 +1,99 @@
+/**
+ * @file
+ * Dieses Modul stellt umkehrbare Vorverarbeitungen bereit, die die Daten 
+ * vor der Huffman-Kodierung besser komprimierbar machen:
+ * <UL>
+ * <LI> Burrows-Wheeler-Transformation (#TRANSFORM_BWT): sortiert die 
+ *      Rotationen eines Blocks, so dass Zeichen mit ähnlichem Kontext 
+ *      nebeneinander stehen. Jeder Block wird als Varint mit dem Index der 
+ *      ursprünglichen Zeile, gefolgt von der letzten Spalte abgelegt.
+ * <LI> Move-To-Front (#TRANSFORM_MTF): ersetzt jedes Zeichen durch seine 
+ *      Position in einer Liste der zuletzt verwendeten Zeichen, so dass 
+ *      nach der BWT vor allem kleine Werte entstehen.
+ * <LI> Lauflängenkodierung (#TRANSFORM_RLE): nach vier gleichen Zeichen 
+ *      folgt ein Byte mit der Anzahl weiterer Wiederholungen (0 bis 255).
+ * </UL>
+ * Die Vorverarbeitungen werden in der Reihenfolge BWT, MTF, RLE angewendet
+ * und in umgekehrter Reihenfolge rückgängig gemacht.
+ *
+ * @date 2026-10-17
+ */
+
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+/* ------------------------------------------------------------------------- */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#include <stddef.h>
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Lauflängenkodierung */
+#define TRANSFORM_RLE 0x01u
+
+/** Move-To-Front */
+#define TRANSFORM_MTF 0x02u
+
+/** Burrows-Wheeler-Transformation */
+#define TRANSFORM_BWT 0x04u
+
+/** Alle bekannten Vorverarbeitungen */
+#define TRANSFORM_ALL (TRANSFORM_RLE | TRANSFORM_MTF | TRANSFORM_BWT)
+
+/** Größte zulässige Blockgröße der BWT in Bytes */
+#define TRANSFORM_MAX_BLOCK_SIZE (16u * 1024u * 1024u)
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Wendet die ausgewählten Vorverarbeitungen auf die Daten an. Die Blöcke 
+ * der BWT werden parallel transformiert.
+ *
+ * @param data          die zu transformierenden Daten
+ * @param size          Größe der Daten in Bytes
+ * @param transforms    Kombination der TRANSFORM-Konstanten
+ * @param block_size    Blockgröße der BWT in Bytes, höchstens 
+ *                      #TRANSFORM_MAX_BLOCK_SIZE
+ * @param threads       Anzahl der Threads, 0 für die Anzahl der Prozessoren
+ * @param out_size      Größe der transformierten Daten in Bytes
+ * @return              die transformierten Daten. Der Aufrufer muss den 
+ *                      Speicher mit free freigeben.
+ */
+extern unsigned char *transform_forward(const unsigned char data[], 
+                                        size_t size,
+                                        unsigned int transforms,
+                                        size_t block_size,
+                                        unsigned int threads,
+                                        size_t *out_size);
+
+/**
+ * Macht die Vorverarbeitungen rückgängig.
+ *
+ * @param data          die transformierten Daten
+ * @param size          Größe der transformierten Daten in Bytes
+ * @param transforms    Kombination der TRANSFORM-Konstanten
+ * @param block_size    Blockgröße der BWT in Bytes
+ * @param original_size Größe der ursprünglichen Daten in Bytes
+ * @return              die ursprünglichen Daten oder NULL, wenn die 
+ *                      transformierten Daten fehlerhaft sind. Der Aufrufer
+ *                      muss den Speicher mit free freigeben.
+ */
+extern unsigned char *transform_inverse(const unsigned char data[],
+                                        size_t size,
+                                        unsigned int transforms,
+                                        size_t block_size,
+                                        size_t original_size);
+
+
+/* ------------------------------------------------------------------------- */
+#endif	/* TRANSFORM_H */
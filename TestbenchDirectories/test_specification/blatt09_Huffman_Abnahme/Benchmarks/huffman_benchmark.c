@@ -0,0 +1,1022 @@
+/**
+ * @file
+ * Dieses Programm misst Durchsatz und Kompressionsrate eines
+ * Huffman-Programms. Es ruft das übergebene Programm wie die Testbench als
+ * eigenen Prozess mit -c bzw. -d auf, so dass Abgaben und
+ * Referenzlösung mit denselben Eingaben verglichen werden können. Die mit
+ * -x übergebenen Optionen erhalten beide Aufrufe, so dass sich etwa mit
+ * -utree die Dekodierung über den Baum mit der Dekodiertabelle und mit
+ * -esingle die zeichenweise Kodierung mit der Paartabelle vergleichen
+ * lässt.
+ *
+ * Gemessen wird über alle Dateien des Verzeichnisses testfiles und über
+ * drei synthetische Eingaben (gleichverteilte Zufallsbytes, schief
+ * verteilte Bytes und Text aus einem festen Wortschatz), die im
+ * Arbeitsverzeichnis erzeugt werden. Für jede Eingabe werden zunächst
+ * Aufwärmläufe und danach wiederholte Messläufe für Komprimierung und
+ * Dekomprimierung ausgeführt. Ausgegeben werden Median und Minimum der
+ * Laufzeit (Wanduhr und CPU), der Durchsatz in MB/s bezogen auf die
+ * unkomprimierte Größe sowie die Kompressionsrate als JSON.
+ *
+ * Zusätzlich erhält das Programm die Option -vj und gibt damit die Zeiten
+ * seiner Phasen (Lesen, Zählen, Baum, Codes, Header, Kodierung, Schreiben)
+ * als JSON-Zeile aus. Auch für sie werden Median und Minimum ausgegeben.
+ * Programme ohne diese Option werden mit -P gemessen.
+ *
+ * Aufruf:
+ * <pre>
+ * huffman_benchmark [-r repeats] [-w warmups] [-s MB] [-x "Optionen"] [-P]
+ *                   [-t Arbeitsverzeichnis] [-o ergebnis.json]
+ *                   programm testfiles-verzeichnis
+ * </pre>
+ *
+ * Übersetzen bspw. mit: gcc -O2 -Wall -o huffman_benchmark huffman_benchmark.c
+ *
+ * @date 2026-10-17
+ */
+
+
+/* ============================================================================
+ * Header-Dateien
+ * ========================================================================= */
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+
+/* ============================================================================
+ * Symbolische Konstanten
+ * ========================================================================= */
+
+/** Standardanzahl der Messläufe je Eingabe und Richtung */
+#define DEFAULT_REPEATS 5
+
+/** Standardanzahl der Aufwärmläufe je Eingabe und Richtung */
+#define DEFAULT_WARMUPS 1
+
+/** Standardgröße der synthetischen Eingaben in MB */
+#define DEFAULT_SYNTHETIC_MB 64
+
+/** Maximale Anzahl der Messläufe */
+#define MAX_REPEATS 100
+
+/** Maximale Anzahl der Eingabedateien */
+#define MAX_INPUTS 256
+
+/** Maximale Länge eines Dateinamens mit Pfad */
+#define MAX_PATH 1024
+
+/** Maximale Anzahl zusätzlicher Optionen für beide Richtungen */
+#define MAX_EXTRA_OPTIONS 16
+
+/** Anzahl der Phasen, deren Zeiten das Programm mit -vj ausgibt */
+#define PROGRAM_PHASES 7
+
+/** Puffergröße für die Standardausgabe eines Programmaufrufs */
+#define OUTPUT_SIZE 65536
+
+/** Puffergröße beim Erzeugen und Vergleichen von Dateien */
+#define CHUNK_SIZE (1024 * 1024)
+
+/** Ein Megabyte für die Angabe des Durchsatzes */
+#define MEGABYTE 1000000.0
+
+
+/* ============================================================================
+ * Typ-Definitionen
+ * ========================================================================= */
+
+/**
+ * Art einer synthetischen Eingabe
+ */
+typedef enum
+{
+    /** gleichverteilte Zufallsbytes, nicht komprimierbar */
+    SYNTHETIC_RANDOM,
+    /** geometrisch verteilte Bytes mit wenigen häufigen Zeichen */
+    SYNTHETIC_SKEWED,
+    /** Wörter eines festen Wortschatzes mit Zipf-ähnlicher Verteilung */
+    SYNTHETIC_TEXT
+} SYNTHETIC;
+
+/**
+ * Messergebnis einer Richtung (Komprimierung oder Dekomprimierung)
+ */
+typedef struct
+{
+    /** Laufzeiten der Messläufe auf der Wanduhr in Sekunden */
+    double wall[MAX_REPEATS];
+
+    /** CPU-Zeiten (Benutzer und System) der Messläufe in Sekunden */
+    double cpu[MAX_REPEATS];
+
+    /** Laufzeiten der Programmphasen je Messlauf auf der Wanduhr */
+    double phase_wall[PROGRAM_PHASES][MAX_REPEATS];
+
+    /** CPU-Zeiten der Programmphasen je Messlauf */
+    double phase_cpu[PROGRAM_PHASES][MAX_REPEATS];
+
+    /** true, wenn die Zeiten der Programmphasen aller Messläufe vorliegen */
+    bool has_phases;
+
+    /** false, wenn ein Aufruf mit einem Fehlercode endete */
+    bool ok;
+} PHASE;
+
+/**
+ * Messergebnis einer Eingabe
+ */
+typedef struct
+{
+    /** Name der Eingabe, wie er im Ergebnis erscheint */
+    char name[MAX_PATH];
+
+    /** Pfad der Eingabedatei */
+    char path[MAX_PATH];
+
+    /** Größe der Eingabedatei in Bytes */
+    long long size;
+
+    /** Größe der komprimierten Datei in Bytes */
+    long long compressed_size;
+
+    /** Messergebnis der Komprimierung */
+    PHASE compress;
+
+    /** Messergebnis der Dekomprimierung */
+    PHASE decompress;
+
+    /** true, wenn die dekomprimierte Datei mit der Eingabe übereinstimmt */
+    bool roundtrip_ok;
+} RESULT;
+
+
+/* ============================================================================
+ * Funktions-Prototypen
+ * ========================================================================= */
+
+/**
+ * Trägt alle regulären Dateien des Verzeichnisses als Eingaben ein,
+ * alphabetisch sortiert.
+ *
+ * @param directory     das Verzeichnis der Testdateien
+ * @param results       die Eingaben
+ * @param count         Anzahl der Eingaben, wird erhöht
+ */
+static void add_testfiles(const char *directory, RESULT results[],
+                          int *count);
+
+/**
+ * Erzeugt eine synthetische Eingabe und trägt sie als Eingabe ein.
+ *
+ * @param kind          Art der Eingabe
+ * @param work_dir      Verzeichnis, in dem die Datei erzeugt wird
+ * @param size          Größe der Datei in Bytes
+ * @param results       die Eingaben
+ * @param count         Anzahl der Eingaben, wird erhöht
+ */
+static void add_synthetic(SYNTHETIC kind, const char *work_dir,
+                          long long size, RESULT results[], int *count);
+
+/**
+ * Führt Aufwärm- und Messläufe für eine Richtung aus.
+ *
+ * @param argv      Argumente des Programmaufrufs, mit NULL abgeschlossen
+ * @param warmups   Anzahl der Aufwärmläufe
+ * @param repeats   Anzahl der Messläufe
+ * @param phase     das Messergebnis
+ */
+static void measure(char *argv[], int warmups, int repeats, PHASE *phase);
+
+/**
+ * Startet das Programm als eigenen Prozess und wartet auf sein Ende.
+ *
+ * @param argv      Argumente des Programmaufrufs, mit NULL abgeschlossen
+ * @param output    Standardausgabe des Programms, abgeschnitten auf
+ *                  #OUTPUT_SIZE - 1 Zeichen und mit '\0' abgeschlossen
+ * @param wall      Laufzeit auf der Wanduhr in Sekunden
+ * @param cpu       CPU-Zeit (Benutzer und System) in Sekunden
+ * @return          true, wenn das Programm mit EXIT_SUCCESS endete
+ */
+static bool run_process(char *argv[], char output[], double *wall,
+                        double *cpu);
+
+/**
+ * Liest die Zeiten der Programmphasen aus der JSON-Zeile, die das
+ * Programm mit -vj ausgibt.
+ *
+ * @param output    Standardausgabe des Programms
+ * @param phase     das Messergebnis
+ * @param run       Nummer des Messlaufs
+ * @return          true, wenn die Zeiten aller Phasen gefunden wurden
+ */
+static bool parse_phases(const char *output, PHASE *phase, int run);
+
+/**
+ * Vergleicht zwei Dateien byteweise.
+ *
+ * @param filename1     erste Datei
+ * @param filename2     zweite Datei
+ * @return              true, wenn beide Dateien existieren und gleich sind
+ */
+static bool files_equal(const char *filename1, const char *filename2);
+
+/**
+ * Liefert die Größe einer Datei.
+ *
+ * @param filename  die Datei
+ * @return          Größe in Bytes oder -1, wenn die Datei nicht existiert
+ */
+static long long file_size(const char *filename);
+
+/**
+ * Liefert den Median der übergebenen Werte.
+ *
+ * @param values    die Werte
+ * @param count     Anzahl der Werte
+ * @return          der Median
+ */
+static double median(const double values[], int count);
+
+/**
+ * Liefert das Minimum der übergebenen Werte.
+ *
+ * @param values    die Werte
+ * @param count     Anzahl der Werte
+ * @return          das Minimum
+ */
+static double minimum(const double values[], int count);
+
+/**
+ * Schreibt das Messergebnis einer Richtung als JSON-Objekt.
+ *
+ * @param out       Ausgabestrom
+ * @param phase     das Messergebnis
+ * @param repeats   Anzahl der Messläufe
+ * @param size      Größe der unkomprimierten Daten in Bytes
+ */
+static void print_phase(FILE *out, PHASE *phase, int repeats, long long size);
+
+/**
+ * Schreibt eine Zeichenkette mit JSON-Maskierung.
+ *
+ * @param out   Ausgabestrom
+ * @param text  die Zeichenkette
+ */
+static void print_json_string(FILE *out, const char *text);
+
+/**
+ * Liefert eine Pseudozufallszahl (xorshift64*). Der Generator ist
+ * deterministisch, damit alle Läufe dieselben Eingaben verwenden.
+ *
+ * @param state     Zustand des Generators, ungleich 0
+ * @return          die nächste Zufallszahl
+ */
+static unsigned long long next_random(unsigned long long *state);
+
+/**
+ * Vergleicht zwei double-Werte für qsort.
+ */
+static int compare_doubles(const void *a, const void *b);
+
+/**
+ * Vergleicht zwei Eingaben nach ihrem Namen für qsort.
+ */
+static int compare_results(const void *a, const void *b);
+
+/**
+ * Gibt die Hilfe aus.
+ */
+static void print_usage(void);
+
+
+/* ============================================================================
+ * Globale Variablen
+ * ========================================================================= */
+
+/** Namen der Programmphasen in der JSON-Zeile von -vj */
+static const char *const phase_names[PROGRAM_PHASES] = {
+    "read", "count", "tree", "codes", "header", "coding", "flush"
+};
+
+/** false, wenn das Programm ohne -vj aufgerufen wird (Option -P) */
+static bool measure_phases = true;
+
+/** Wortschatz der synthetischen Texteingabe */
+static const char *const words[] = {
+    "der", "die", "und", "in", "den", "von", "zu", "das", "mit", "sich",
+    "des", "auf", "für", "ist", "im", "dem", "nicht", "ein", "eine", "als",
+    "auch", "es", "an", "werden", "aus", "er", "hat", "dass", "sie", "nach",
+    "Huffman", "Baum", "Knoten", "Zeichen", "Datei", "Code", "Bit", "Byte",
+    "Kompression", "Häufigkeit", "Tabelle", "Puffer", "Strom", "Block",
+    "the", "of", "and", "to", "a", "in", "that", "is", "was", "he", "for",
+    "it", "with", "as", "his", "on", "be", "at", "by", "Frodo", "Gandalf"
+};
+
+
+/* ============================================================================
+ * Funktions-Definitionen
+ * ========================================================================= */
+
+/* ---------------------------------------------------------------------------
+ * Funktion: main
+ * ------------------------------------------------------------------------ */
+int main(int argc, char **argv)
+{
+    static RESULT results[MAX_INPUTS];
+    int count = 0;
+    int repeats = DEFAULT_REPEATS;
+    int warmups = DEFAULT_WARMUPS;
+    long long synthetic_mb = DEFAULT_SYNTHETIC_MB;
+    const char *work_dir = ".";
+    const char *out_filename = NULL;
+    char options[MAX_PATH] = "";
+    char extra[MAX_PATH] = "";
+    char *extra_options[MAX_EXTRA_OPTIONS];
+    int extra_count = 0;
+    char *program;
+    char *testfiles;
+    char hc_filename[MAX_PATH];
+    char hd_filename[MAX_PATH];
+    char *args[MAX_EXTRA_OPTIONS + 9];
+    long long total_size = 0;
+    long long total_compressed = 0;
+    double total_compress = 0.0;
+    double total_decompress = 0.0;
+    bool all_ok = true;
+    FILE *out = stdout;
+    char *token;
+    int option;
+    int i;
+    int k;
+
+    while ((option = getopt(argc, argv, "r:w:s:x:Pt:o:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'r':
+            repeats = atoi(optarg);
+            break;
+        case 'w':
+            warmups = atoi(optarg);
+            break;
+        case 's':
+            synthetic_mb = atoll(optarg);
+            break;
+        case 'x':
+            strncpy(options, optarg, MAX_PATH - 1);
+            strncpy(extra, optarg, MAX_PATH - 1);
+            break;
+        case 'P':
+            measure_phases = false;
+            break;
+        case 't':
+            work_dir = optarg;
+            break;
+        case 'o':
+            out_filename = optarg;
+            break;
+        default:
+            print_usage();
+            return (option == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind != 2 || repeats < 1 || repeats > MAX_REPEATS
+        || warmups < 0 || synthetic_mb < 0)
+    {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+    program = argv[optind];
+    testfiles = argv[optind + 1];
+
+    /* Zusätzliche Optionen für beide Richtungen an Leerzeichen trennen */
+    for (token = strtok(extra, " "); token != NULL
+         && extra_count < MAX_EXTRA_OPTIONS; token = strtok(NULL, " "))
+    {
+        extra_options[extra_count++] = token;
+    }
+
+    add_testfiles(testfiles, results, &count);
+    if (synthetic_mb > 0)
+    {
+        add_synthetic(SYNTHETIC_RANDOM, work_dir, synthetic_mb * 1000000,
+                      results, &count);
+        add_synthetic(SYNTHETIC_SKEWED, work_dir, synthetic_mb * 1000000,
+                      results, &count);
+        add_synthetic(SYNTHETIC_TEXT, work_dir, synthetic_mb * 1000000,
+                      results, &count);
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        RESULT *result = &results[i];
+
+        snprintf(hc_filename, MAX_PATH, "%s/bench_%d.hc", work_dir, i);
+        snprintf(hd_filename, MAX_PATH, "%s/bench_%d.hd", work_dir, i);
+        fprintf(stderr, "%s ...\n", result->name);
+
+        /* Komprimierung */
+        k = 0;
+        args[k++] = program;
+        args[k++] = "-c";
+        if (measure_phases)
+        {
+            args[k++] = "-vj";
+        }
+        memcpy(args + k, extra_options, extra_count * sizeof (char *));
+        k += extra_count;
+        args[k++] = "-o";
+        args[k++] = hc_filename;
+        args[k++] = result->path;
+        args[k] = NULL;
+        measure(args, warmups, repeats, &result->compress);
+        result->compressed_size = file_size(hc_filename);
+
+        /* Dekomprimierung */
+        k = 0;
+        args[k++] = program;
+        args[k++] = "-d";
+        if (measure_phases)
+        {
+            args[k++] = "-vj";
+        }
+        memcpy(args + k, extra_options, extra_count * sizeof (char *));
+        k += extra_count;
+        args[k++] = "-o";
+        args[k++] = hd_filename;
+        args[k++] = hc_filename;
+        args[k] = NULL;
+        measure(args, warmups, repeats, &result->decompress);
+
+        result->roundtrip_ok = result->compress.ok && result->decompress.ok
+                && files_equal(result->path, hd_filename);
+        all_ok = all_ok && result->roundtrip_ok;
+
+        (void) remove(hc_filename);
+        (void) remove(hd_filename);
+    }
+
+    if (out_filename != NULL)
+    {
+        out = fopen(out_filename, "w");
+        if (out == NULL)
+        {
+            perror(out_filename);
+            return EXIT_FAILURE;
+        }
+    }
+
+    fprintf(out, "{\n  \"program\": ");
+    print_json_string(out, program);
+    fprintf(out, ",\n  \"options\": ");
+    print_json_string(out, options);
+    fprintf(out, ",\n  \"warmups\": %d,\n  \"repeats\": %d,\n",
+            warmups, repeats);
+    fprintf(out, "  \"files\": [\n");
+    for (i = 0; i < count; i++)
+    {
+        RESULT *result = &results[i];
+
+        fprintf(out, "    {\"name\": ");
+        print_json_string(out, result->name);
+        fprintf(out, ", \"size\": %lld, \"compressed_size\": %lld, "
+                "\"ratio\": %.4f,\n", result->size, result->compressed_size,
+                result->size > 0
+                ? (double) result->compressed_size / (double) result->size
+                : 0.0);
+        fprintf(out, "     \"compress\": ");
+        print_phase(out, &result->compress, repeats, result->size);
+        fprintf(out, ",\n     \"decompress\": ");
+        print_phase(out, &result->decompress, repeats, result->size);
+        fprintf(out, ",\n     \"roundtrip_ok\": %s}%s\n",
+                result->roundtrip_ok ? "true" : "false",
+                (i + 1 < count) ? "," : "");
+
+        total_size += result->size;
+        total_compressed += result->compressed_size;
+        total_compress += median(result->compress.wall, repeats);
+        total_decompress += median(result->decompress.wall, repeats);
+    }
+    fprintf(out, "  ],\n");
+    fprintf(out, "  \"total\": {\"size\": %lld, \"compressed_size\": %lld, "
+            "\"ratio\": %.4f, \"compress_mb_per_s\": %.2f, "
+            "\"decompress_mb_per_s\": %.2f, \"roundtrip_ok\": %s}\n}\n",
+            total_size, total_compressed,
+            total_size > 0 ? (double) total_compressed / (double) total_size
+                           : 0.0,
+            total_compress > 0.0
+            ? (double) total_size / MEGABYTE / total_compress : 0.0,
+            total_decompress > 0.0
+            ? (double) total_size / MEGABYTE / total_decompress : 0.0,
+            all_ok ? "true" : "false");
+
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (strncmp(results[i].name, "synthetic_", 10) == 0)
+        {
+            (void) remove(results[i].path);
+        }
+    }
+
+    return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: add_testfiles
+ * ------------------------------------------------------------------------ */
+static void add_testfiles(const char *directory, RESULT results[],
+                          int *count)
+{
+    DIR *dir = opendir(directory);
+    struct dirent *entry;
+    int first = *count;
+
+    if (dir == NULL)
+    {
+        perror(directory);
+        exit(EXIT_FAILURE);
+    }
+
+    while ((entry = readdir(dir)) != NULL && *count < MAX_INPUTS)
+    {
+        RESULT *result = &results[*count];
+
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+
+        snprintf(result->path, MAX_PATH, "%s/%s", directory, entry->d_name);
+        result->size = file_size(result->path);
+        if (result->size >= 0)
+        {
+            struct stat attribut;
+
+            if (stat(result->path, &attribut) == 0
+                && S_ISREG(attribut.st_mode))
+            {
+                strncpy(result->name, entry->d_name, MAX_PATH - 1);
+                (*count)++;
+            }
+        }
+    }
+
+    closedir(dir);
+
+    qsort(results + first, (size_t) (*count - first), sizeof (RESULT),
+          compare_results);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: add_synthetic
+ * ------------------------------------------------------------------------ */
+static void add_synthetic(SYNTHETIC kind, const char *work_dir,
+                          long long size, RESULT results[], int *count)
+{
+    static const char *const names[] = {
+        "synthetic_random", "synthetic_skewed", "synthetic_text"
+    };
+    RESULT *result;
+    unsigned char *chunk;
+    unsigned long long state = 0x9E3779B97F4A7C15ull + (unsigned int) kind;
+    long long written = 0;
+    size_t n;
+    FILE *stream;
+
+    if (*count >= MAX_INPUTS)
+    {
+        return;
+    }
+    result = &results[*count];
+    snprintf(result->name, MAX_PATH, "%s_%lldMB", names[kind],
+             size / 1000000);
+    if (snprintf(result->path, MAX_PATH, "%s/%s.bin", work_dir,
+                 result->name) >= MAX_PATH)
+    {
+        fprintf(stderr, "Arbeitsverzeichnis zu lang: %s\n", work_dir);
+        exit(EXIT_FAILURE);
+    }
+
+    chunk = (unsigned char *) malloc(CHUNK_SIZE);
+    stream = fopen(result->path, "wb");
+    if (chunk == NULL || stream == NULL)
+    {
+        perror(result->path);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(stderr, "Erzeuge %s ...\n", result->path);
+    while (written < size)
+    {
+        n = (size - written < CHUNK_SIZE) ? (size_t) (size - written)
+                                          : CHUNK_SIZE;
+
+        if (kind == SYNTHETIC_RANDOM)
+        {
+            size_t i;
+
+            for (i = 0; i < n; i++)
+            {
+                chunk[i] = (unsigned char) (next_random(&state) >> 56);
+            }
+        }
+        else if (kind == SYNTHETIC_SKEWED)
+        {
+            size_t i;
+
+            /* Anzahl der Nullen am Ende einer Zufallszahl ist geometrisch
+             * verteilt: Zeichen 'a' mit Wahrscheinlichkeit 1/2, 'b' mit 1/4
+             * usw. */
+            for (i = 0; i < n; i++)
+            {
+                unsigned long long r = next_random(&state);
+                unsigned char c = 'a';
+
+                while ((r & 1) == 0 && c < 'a' + 40)
+                {
+                    r >>= 1;
+                    c++;
+                }
+                chunk[i] = c;
+            }
+        }
+        else
+        {
+            size_t i = 0;
+            size_t word_count = sizeof (words) / sizeof (words[0]);
+
+            while (i < n)
+            {
+                /* Zipf-ähnlich: Minimum zweier Zufallszahlen bevorzugt die
+                 * vorderen Wörter */
+                size_t a = (size_t) (next_random(&state) % word_count);
+                size_t b = (size_t) (next_random(&state) % word_count);
+                const char *word = words[a < b ? a : b];
+                size_t length = strlen(word);
+
+                if (i + length + 1 > n)
+                {
+                    memset(chunk + i, ' ', n - i);
+                    i = n;
+                }
+                else
+                {
+                    memcpy(chunk + i, word, length);
+                    i += length;
+                    chunk[i++] = (next_random(&state) % 12 == 0) ? '\n' : ' ';
+                }
+            }
+        }
+
+        if (fwrite(chunk, 1, n, stream) != n)
+        {
+            perror(result->path);
+            exit(EXIT_FAILURE);
+        }
+        written += (long long) n;
+    }
+
+    fclose(stream);
+    free(chunk);
+
+    result->size = size;
+    (*count)++;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: measure
+ * ------------------------------------------------------------------------ */
+static void measure(char *argv[], int warmups, int repeats, PHASE *phase)
+{
+    static char output[OUTPUT_SIZE];
+    double wall;
+    double cpu;
+    int i;
+
+    phase->ok = true;
+    phase->has_phases = measure_phases;
+    for (i = 0; i < warmups; i++)
+    {
+        phase->ok = run_process(argv, output, &wall, &cpu) && phase->ok;
+    }
+    for (i = 0; i < repeats; i++)
+    {
+        phase->ok = run_process(argv, output, &phase->wall[i],
+                                &phase->cpu[i]) && phase->ok;
+        phase->has_phases = phase->has_phases
+                && parse_phases(output, phase, i);
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: run_process
+ * ------------------------------------------------------------------------ */
+static bool run_process(char *argv[], char output[], double *wall,
+                        double *cpu)
+{
+    struct timespec start;
+    struct timespec end;
+    struct rusage usage;
+    char discard[4096];
+    size_t length = 0;
+    ssize_t n = 1;
+    int status = 0;
+    int fds[2];
+    pid_t pid;
+
+    if (pipe(fds) < 0)
+    {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    pid = fork();
+    if (pid < 0)
+    {
+        perror("fork");
+        exit(EXIT_FAILURE);
+    }
+    if (pid == 0)
+    {
+        /* Standardausgabe des Programms in die Pipe umlenken */
+        if (dup2(fds[1], STDOUT_FILENO) < 0)
+        {
+            _exit(EXIT_FAILURE);
+        }
+        close(fds[0]);
+        close(fds[1]);
+        execv(argv[0], argv);
+        perror(argv[0]);
+        _exit(127);
+    }
+
+    /* Ausgabe bis zum Ende lesen, damit das Programm nicht blockiert; was
+     * nicht in den Puffer passt, wird verworfen */
+    close(fds[1]);
+    while (n > 0)
+    {
+        if (length < OUTPUT_SIZE - 1)
+        {
+            n = read(fds[0], output + length, OUTPUT_SIZE - 1 - length);
+            length += (n > 0) ? (size_t) n : 0;
+        }
+        else
+        {
+            n = read(fds[0], discard, sizeof (discard));
+        }
+    }
+    output[length] = '\0';
+    close(fds[0]);
+
+    if (wait4(pid, &status, 0, &usage) < 0)
+    {
+        perror("wait4");
+        exit(EXIT_FAILURE);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    *wall = (double) (end.tv_sec - start.tv_sec)
+            + (double) (end.tv_nsec - start.tv_nsec) / 1e9;
+    *cpu = (double) usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6
+           + (double) usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: parse_phases
+ * ------------------------------------------------------------------------ */
+static bool parse_phases(const char *output, PHASE *phase, int run)
+{
+    const char *phases = strstr(output, "\"phases\"");
+    const char *entry;
+    char key[32];
+    int p;
+
+    for (p = 0; p < PROGRAM_PHASES && phases != NULL; p++)
+    {
+        /* Jede Phase steht als "name": {"wall_s": x, "cpu_s": y} */
+        snprintf(key, sizeof (key), "\"%s\":", phase_names[p]);
+        entry = strstr(phases, key);
+        if (entry == NULL
+            || sscanf(entry + strlen(key), " {\"wall_s\": %lf, \"cpu_s\": %lf",
+                      &phase->phase_wall[p][run],
+                      &phase->phase_cpu[p][run]) != 2)
+        {
+            return false;
+        }
+    }
+
+    return phases != NULL;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: files_equal
+ * ------------------------------------------------------------------------ */
+static bool files_equal(const char *filename1, const char *filename2)
+{
+    FILE *stream1 = fopen(filename1, "rb");
+    FILE *stream2 = fopen(filename2, "rb");
+    unsigned char *buffer1 = (unsigned char *) malloc(CHUNK_SIZE);
+    unsigned char *buffer2 = (unsigned char *) malloc(CHUNK_SIZE);
+    bool equal = stream1 != NULL && stream2 != NULL
+                 && buffer1 != NULL && buffer2 != NULL;
+    size_t n1 = 1;
+    size_t n2;
+
+    while (equal && n1 > 0)
+    {
+        n1 = fread(buffer1, 1, CHUNK_SIZE, stream1);
+        n2 = fread(buffer2, 1, CHUNK_SIZE, stream2);
+        equal = n1 == n2 && memcmp(buffer1, buffer2, n1) == 0;
+    }
+
+    if (stream1 != NULL)
+    {
+        fclose(stream1);
+    }
+    if (stream2 != NULL)
+    {
+        fclose(stream2);
+    }
+    free(buffer1);
+    free(buffer2);
+
+    return equal;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: file_size
+ * ------------------------------------------------------------------------ */
+static long long file_size(const char *filename)
+{
+    struct stat attribut;
+
+    return (stat(filename, &attribut) == 0) ? (long long) attribut.st_size
+                                            : -1;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: median
+ * ------------------------------------------------------------------------ */
+static double median(const double values[], int count)
+{
+    double sorted[MAX_REPEATS];
+
+    memcpy(sorted, values, (size_t) count * sizeof (double));
+    qsort(sorted, (size_t) count, sizeof (double), compare_doubles);
+
+    return (count % 2 == 1)
+           ? sorted[count / 2]
+           : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: minimum
+ * ------------------------------------------------------------------------ */
+static double minimum(const double values[], int count)
+{
+    double result = values[0];
+    int i;
+
+    for (i = 1; i < count; i++)
+    {
+        result = (values[i] < result) ? values[i] : result;
+    }
+
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: print_phase
+ * ------------------------------------------------------------------------ */
+static void print_phase(FILE *out, PHASE *phase, int repeats, long long size)
+{
+    double wall = median(phase->wall, repeats);
+    int p;
+
+    fprintf(out, "{\"ok\": %s, \"wall_median_s\": %.6f, \"wall_min_s\": %.6f,"
+            " \"cpu_median_s\": %.6f, \"mb_per_s\": %.2f",
+            phase->ok ? "true" : "false", wall,
+            minimum(phase->wall, repeats), median(phase->cpu, repeats),
+            wall > 0.0 ? (double) size / MEGABYTE / wall : 0.0);
+
+    if (phase->has_phases)
+    {
+        fprintf(out, ",\n      \"phases\": {");
+        for (p = 0; p < PROGRAM_PHASES; p++)
+        {
+            fprintf(out, "%s\n        \"%s\": {\"wall_median_s\": %.6f, "
+                    "\"wall_min_s\": %.6f, \"cpu_median_s\": %.6f, "
+                    "\"cpu_min_s\": %.6f}", (p == 0) ? "" : ",",
+                    phase_names[p], median(phase->phase_wall[p], repeats),
+                    minimum(phase->phase_wall[p], repeats),
+                    median(phase->phase_cpu[p], repeats),
+                    minimum(phase->phase_cpu[p], repeats));
+        }
+        fprintf(out, "}");
+    }
+    fprintf(out, "}");
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: print_json_string
+ * ------------------------------------------------------------------------ */
+static void print_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (; *text != '\0'; text++)
+    {
+        if (*text == '"' || *text == '\\')
+        {
+            fputc('\\', out);
+            fputc(*text, out);
+        }
+        else if ((unsigned char) *text < 0x20)
+        {
+            fprintf(out, "\\u%04x", (unsigned int) (unsigned char) *text);
+        }
+        else
+        {
+            fputc(*text, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: next_random
+ * ------------------------------------------------------------------------ */
+static unsigned long long next_random(unsigned long long *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545F4914F6CDD1Dull;
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: compare_doubles
+ * ------------------------------------------------------------------------ */
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: compare_results
+ * ------------------------------------------------------------------------ */
+static int compare_results(const void *a, const void *b)
+{
+    return strcmp(((const RESULT *) a)->name, ((const RESULT *) b)->name);
+}
+
+/* ---------------------------------------------------------------------------
+ * Funktion: print_usage
+ * ------------------------------------------------------------------------ */
+static void print_usage(void)
+{
+    fprintf(stderr,
+            "Usage: huffman_benchmark <options> program testfiles-dir\n"
+            "  runs 'program -c' and 'program -d' over every file in\n"
+            "  testfiles-dir and over synthetic inputs, prints JSON\n"
+            "Options are:\n"
+            "  -r <n>       measured runs per input (default: %d)\n"
+            "  -w <n>       warmup runs per input (default: %d)\n"
+            "  -s <MB>      size of synthetic inputs, 0 disables them\n"
+            "               (default: %d)\n"
+            "  -x <opts>    extra options for compression and decompression,\n"
+            "               e.g. \"-l5\", \"-utree\" to measure the tree decoder\n"
+            "               or \"-esingle\" to measure the single-byte encoder\n"
+            "  -P           do not pass -vj, i.e. no per-phase times, for\n"
+            "               programs without that option\n"
+            "  -t <dir>     work directory for temporary files (default: .)\n"
+            "  -o <file>    write JSON to file instead of stdout\n",
+            DEFAULT_REPEATS, DEFAULT_WARMUPS, DEFAULT_SYNTHETIC_MB);
+}